@@ -32,6 +32,10 @@ cbuffer PerObjectBuffer : register(b1)
 	matrix mModel;
 	matrix mMVP_current;
 	matrix mMVP_previous;	
+	float3 positionOffset;
+	float padding3;
+	float3 positionScale;
+	float padding4;
 };
 
 struct PixelInputType
@@ -56,11 +60,11 @@ struct PixelOutputType
 	float2 depth	: SV_Target4;
 };
 
-PixelInputType mainVS(Vertex_PosUvTbn input)
+PixelInputType mainVS(Vertex_PosUvTbn_Quantized inputQuantized)
 {
     PixelInputType output;
     
-    input.position.w 			= 1.0f;	
+    Vertex_PosUvTbn input 		= Vertex_Dequantize(inputQuantized, positionOffset, positionScale);
 	output.positionWS 			= mul(input.position, mModel);
     output.positionVS   		= mul(output.positionWS, g_view);
     output.positionCS   		= mul(output.positionVS, g_projection);
@@ -138,7 +142,9 @@ PixelOutputType mainPS(PixelInputType input)
 	
 	//= NORMAL ==================================================================================
 	#if NORMAL_MAP
-		float3 normalSample = normalize(Unpack(texNormal.Sample(samplerAniso, texCoords).rgb));
+		// Only x and y are stored (BC5), z is reconstructed
+		float2 normalXY		= Unpack(texNormal.Sample(samplerAniso, texCoords).rg);
+		float3 normalSample	= float3(normalXY, sqrt(saturate(1.0f - dot(normalXY, normalXY))));
 		normal = TangentToWorld(normalSample, input.normal.xyz, input.tangent.xyz, input.bitangent.xyz, normalIntensity);
 	#endif
 	//============================================================================================
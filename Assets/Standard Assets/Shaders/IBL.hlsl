@@ -1,33 +1,20 @@
-static const float tex_maxMip = 11.0f;
-static const float2 environmentMipSize[12] =
-{
-    float2(4096, 2048),
-	float2(2048, 1024),
-	float2(1024, 512),
-	float2(512, 256),
-	float2(256, 128),
-	float2(128, 64),
-	float2(64, 32),
-	float2(32, 16),
-	float2(16, 8),
-	float2(8, 4),
-	float2(4, 2),
-	float2(2, 1),
-};
+// Levels of the prefiltered environment, the roughness of level i is i / specularMaxMip
+static const float specularMaxMip = 6.0f;
 
-float3 SampleEnvironment(SamplerState sampler_linear, Texture2D tex_environment, float2 uv, float mipLevel)
+// The irradiance projected onto 9 spherical harmonics, already convolved with the cosine lobe and divided by PI
+float3 IrradianceSH(float4 sh[9], float3 n)
 {
-	float2 texelSize	= environmentMipSize[mipLevel];
-	float dx 			= 1.0f * texelSize.x;
-	float dy 			= 1.0f * texelSize.y;
-
-	float3 tl 			= tex_environment.SampleLevel(sampler_linear, uv + float2(-dx, -dy), mipLevel).rgb;
-	float3 tr			= tex_environment.SampleLevel(sampler_linear, uv + float2(dx, -dy), mipLevel).rgb;
-	float3 bl			= tex_environment.SampleLevel(sampler_linear, uv + float2(-dx, dy), mipLevel).rgb;
-	float3 br 			= tex_environment.SampleLevel(sampler_linear, uv + float2(dx, dy), mipLevel).rgb;
-	float3 ce 			= tex_environment.SampleLevel(sampler_linear, uv, mipLevel).rgb;
+	float3 irradiance	= sh[0].rgb * 0.282095f;
+	irradiance			+= sh[1].rgb * 0.488603f * n.y;
+	irradiance			+= sh[2].rgb * 0.488603f * n.z;
+	irradiance			+= sh[3].rgb * 0.488603f * n.x;
+	irradiance			+= sh[4].rgb * 1.092548f * n.x * n.y;
+	irradiance			+= sh[5].rgb * 1.092548f * n.y * n.z;
+	irradiance			+= sh[6].rgb * 0.315392f * (3.0f * n.z * n.z - 1.0f);
+	irradiance			+= sh[7].rgb * 1.092548f * n.x * n.z;
+	irradiance			+= sh[8].rgb * 0.546274f * (n.x * n.x - n.y * n.y);
 
-	return (tl + tr + bl + br + ce) / 5.0f;
+	return max(irradiance, 0.0f);
 }
 
 float3 GetSpecularDominantDir(float3 normal, float3 reflection, float roughness)
@@ -54,7 +41,7 @@ float3 EnvBRDFApprox(float3 specColor, float roughness, float NdV)
     return specColor * AB.x + AB.y;
 }
 
-float3 ImageBasedLighting(Material material, float3 normal, float3 camera_to_pixel, Texture2D tex_environment, Texture2D tex_lutIBL, SamplerState samplerLinear, float ambientTerm)
+float3 ImageBasedLighting(Material material, float3 normal, float3 camera_to_pixel, float4 irradianceSH[9], Texture2D tex_specular, Texture2D tex_lutIBL, SamplerState samplerLinear, float ambientTerm)
 {
 	float3 reflection 	= reflect(camera_to_pixel, normal);
 	// From Sebastien Lagarde Moving Frostbite to PBR page 69
@@ -68,12 +55,12 @@ float3 ImageBasedLighting(Material material, float3 normal, float3 camera_to_pix
 	kD 			*= 1.0f - material.metallic;	
 
 	// Diffuse
-	float3 irradiance	= SampleEnvironment(samplerLinear, tex_environment, DirectionToSphereUV(normal), 7);
+	float3 irradiance	= IrradianceSH(irradianceSH, normal);
 	float3 cDiffuse		= irradiance * material.albedo;
 
 	// Specular
-	float mipLevel 			= material.alpha * tex_maxMip;
-	float3 prefilteredColor	= SampleEnvironment(samplerLinear, tex_environment, DirectionToSphereUV(reflection), mipLevel);
+	float mipLevel 			= material.roughness * specularMaxMip;
+	float3 prefilteredColor	= tex_specular.SampleLevel(samplerLinear, DirectionToSphereUV(reflection), mipLevel).rgb;
 	float2 envBRDF  		= tex_lutIBL.Sample(samplerLinear, float2(NdV, material.roughness)).xy;
 	float3 cSpecular 		= prefilteredColor * (F * envBRDF.x + envBRDF.y);
 
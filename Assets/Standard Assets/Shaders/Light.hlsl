@@ -8,6 +8,7 @@ Texture2D texSSAO 			: register(t5);
 Texture2D texFrame 			: register(t6);
 Texture2D texEnvironment 	: register(t7);
 Texture2D texLutIBL			: register(t8);
+Texture2D texSpecularIBL	: register(t9);
 //=========================================
 
 //= SAMPLERS ======================================
@@ -38,6 +39,8 @@ cbuffer MiscBuffer : register(b1)
     float pointlightCount;
     float spotlightCount;
     float2 padding2;
+
+    float4 irradianceSH[9];
 };
 //=============================================
 
@@ -193,7 +196,7 @@ float4 mainPS(PixelInputType input) : SV_TARGET
 	}
 	
 	// IBL - Image based lighting
-    finalColor 	+= ImageBasedLighting(material, normal, camera_to_pixel, texEnvironment, texLutIBL, sampler_linear_clamp, occlusion_total);
+    finalColor 	+= ImageBasedLighting(material, normal, camera_to_pixel, irradianceSH, texSpecularIBL, texLutIBL, sampler_linear_clamp, occlusion_total);
 
 	// Emission
     float3 emission = material.emission * albedo.rgb * 20.0f;
@@ -15,7 +15,7 @@ struct PixelInputType
     float2 uv 			: TEXCOORD;
 };
 
-PixelInputType mainVS(Vertex_PosUvTbn input)
+PixelInputType mainVS(Vertex_PosUv input)
 {
     PixelInputType output;
     	
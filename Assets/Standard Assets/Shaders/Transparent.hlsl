@@ -16,6 +16,10 @@ cbuffer MiscBuffer : register(b1)
 	float roughness;
 	float3 lightDir;
 	float padding2;
+	float3 positionOffset;
+	float padding3;
+	float3 positionScale;
+	float padding4;
 };
 
 struct PixelInputType
@@ -29,11 +33,11 @@ struct PixelInputType
 	float4 gridPos 		: POSITIONT1;
 };
 
-PixelInputType mainVS(Vertex_PosUvTbn input)
+PixelInputType mainVS(Vertex_PosUvTbn_Quantized inputQuantized)
 {
     PixelInputType output;
     	
-    input.position.w 	= 1.0f;	
+    Vertex_PosUvTbn input = Vertex_Dequantize(inputQuantized, positionOffset, positionScale);
 	
 	output.uv 			= input.uv;  
 	output.position 	= mul(input.position, mWVP);
@@ -23,4 +23,32 @@ struct Vertex_PosUvTbn
     float3 normal 		: NORMAL;
     float3 tangent		: TANGENT;
 	float3 bitangent 	: BITANGENT;
-};
\ No newline at end of file
+};
+
+// Model vertex buffers, see Utility::Quantization
+struct Vertex_PosUvTbn_Quantized
+{
+	float4 position 	: POSITION0;	// xyz relative to the bounding box of the model, w is the sign of the bitangent
+    float2 uv 			: TEXCOORD0;
+    float2 normal 		: NORMAL;		// octahedral
+    float2 tangent		: TANGENT;		// octahedral
+};
+
+float3 OctahedronDecode(float2 encoded)
+{
+	float3 v 	= float3(encoded.xy, 1.0f - abs(encoded.x) - abs(encoded.y));
+	float fold 	= saturate(-v.z);
+	v.xy 		+= v.xy >= 0.0f ? -fold : fold;
+	return normalize(v);
+}
+
+Vertex_PosUvTbn Vertex_Dequantize(Vertex_PosUvTbn_Quantized input, float3 positionOffset, float3 positionScale)
+{
+	Vertex_PosUvTbn output;
+	output.position 	= float4(input.position.xyz * positionScale + positionOffset, 1.0f);
+	output.uv 			= input.uv;
+	output.normal 		= OctahedronDecode(input.normal);
+	output.tangent 		= OctahedronDecode(input.tangent);
+	output.bitangent 	= cross(output.normal, output.tangent) * (input.position.w * 2.0f - 1.0f);
+	return output;
+}
\ No newline at end of file
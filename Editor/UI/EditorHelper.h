@@ -165,6 +165,16 @@ public:
 		});
 	}
 
+	void PackScene(const std::string& filePath)
+	{
+		// Pack the scene asynchronously, archives in the working directory are mounted on startup
+		m_context->GetSubsystem<Directus::Threading>()->AddTask([this, filePath]()
+		{
+			std::string archivePath = Directus::FileSystem::GetWorkingDirectory() + Directus::FileSystem::GetFileNameNoExtensionFromFilePath(filePath) + EXTENSION_ARCHIVE;
+			m_scene->PackToFile(filePath, archivePath);
+		});
+	}
+
 	//= CONVERSIONS ===================================================================================================
 	static Directus::Math::Vector4 ToVector4(const ImVec4& v)	{ return Directus::Math::Vector4(v.x, v.y, v.z, v.w); }
 	static Directus::Math::Vector2 ToVector2(const ImVec2& v)	{ return Directus::Math::Vector2{ v.x,v.y }; }
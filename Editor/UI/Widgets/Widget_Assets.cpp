@@ -74,7 +74,8 @@ void Widget_Assets::Tick(float deltaTime)
 
 void Widget_Assets::OnPathClicked(const std::string& path)
 {
-	if (FileSystem::IsEngineMaterialFile(path))
+	// Materials exported as XML are imported (and saved as regular materials again)
+	if (FileSystem::IsEngineMaterialFile(path) || FileSystem::GetExtensionFromFilePath(path) == EXTENSION_MATERIAL_XML)
 	{
 		auto material = m_context->GetSubsystem<ResourceManager>()->Load<Material>(path);
 		Widget_Properties::Inspect(material);
@@ -36,6 +36,7 @@ namespace _Widget_MenuBar
 {
 	static bool g_showAboutWindow	= false;
 	static bool g_fileDialogVisible	= false;
+	static bool g_fileDialogPack	= false;
 	static bool imgui_metrics = false;
 	static bool imgui_style	= false;
 	static bool imgui_demo	= false;
@@ -73,7 +74,8 @@ void Widget_MenuBar::Tick(float deltaTime)
 			if (ImGui::MenuItem("Load"))
 			{
 				m_fileDialog->SetOperation(FileDialog_Op_Load);
-				_Widget_MenuBar::g_fileDialogVisible = true;
+				_Widget_MenuBar::g_fileDialogVisible	= true;
+				_Widget_MenuBar::g_fileDialogPack		= false;
 			}
 
 			ImGui::Separator();
@@ -90,6 +92,16 @@ void Widget_MenuBar::Tick(float deltaTime)
 				_Widget_MenuBar::g_fileDialogVisible = true;
 			}
 
+			ImGui::Separator();
+
+			// Packs a saved world along with its resources
+			if (ImGui::MenuItem("Pack..."))
+			{
+				m_fileDialog->SetOperation(FileDialog_Op_Load);
+				_Widget_MenuBar::g_fileDialogVisible	= true;
+				_Widget_MenuBar::g_fileDialogPack		= true;
+			}
+
 			ImGui::EndMenu();
 		}
 
@@ -148,7 +160,14 @@ void Widget_MenuBar::ShowFileDialog()
 			// Scene
 			if (FileSystem::IsEngineSceneFile(_Widget_MenuBar::g_fileDialogSelection))
 			{
-				EditorHelper::Get().LoadScene(_Widget_MenuBar::g_fileDialogSelection);
+				if (_Widget_MenuBar::g_fileDialogPack)
+				{
+					EditorHelper::Get().PackScene(_Widget_MenuBar::g_fileDialogSelection);
+				}
+				else
+				{
+					EditorHelper::Get().LoadScene(_Widget_MenuBar::g_fileDialogSelection);
+				}
 				_Widget_MenuBar::g_fileDialogVisible = false;
 			}
 		}
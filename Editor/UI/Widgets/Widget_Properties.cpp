@@ -742,6 +742,15 @@ void Widget_Properties::ShowMaterial(shared_ptr<Material>& material)
 		ImGui::Text("Name");
 		ImGui::SameLine(ComponentProperty::g_column); ImGui::Text(material->GetResourceName().c_str());
 
+		// Export, it can be edited by hand and imported again by clicking it in the assets
+		if (material->HasFilePath())
+		{
+			ImGui::SameLine(); if (ImGui::Button("Export XML"))
+			{
+				material->SaveToXml(FileSystem::GetFilePathWithoutExtension(material->GetResourceFilePath()) + EXTENSION_MATERIAL_XML);
+			}
+		}
+
 		if (material->IsEditable())
 		{
 			auto DisplayTextureSlot = [&material](RHI_Texture* texture, const char* textureName, TextureType textureType)
@@ -42,7 +42,7 @@ void Widget_ResourceCache::Tick(float deltaTime)
 {
 	ResourceManager* resourceMng	= m_context->GetSubsystem<ResourceManager>();
 	auto resources					= resourceMng->GetResourceAll();
-	auto totalMemoryUsage			= resourceMng->GetMemoryUsage() / 1000.0f / 1000.0f;
+	auto totalMemoryUsage			= resourceMng->GetMemoryUsage() / 1000.0 / 1000.0;
 
 	ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiCond_FirstUseEver);
 	ImGui::Begin("Resource Cache Viewer", &m_isVisible, ImGuiWindowFlags_HorizontalScrollbar);
@@ -74,14 +74,14 @@ void Widget_ResourceCache::Tick(float deltaTime)
 		ImGui::Text(resource->GetResourceFilePath().c_str());			ImGui::NextColumn();
 
 		// Memory
-		auto memory = (unsigned int)(resource->GetMemoryUsage() / 1000.0f); // default in Kb
+		auto memory = (unsigned long long)(resource->GetMemoryUsage() / 1000.0); // default in Kb
 		if (memory <= 1024)
 		{
 			ImGui::Text((to_string(memory) + string(" Kb")).c_str());	ImGui::NextColumn();
 		}
 		else
 		{
-			memory = (unsigned int)(memory / 1000.0f); // turn into Mb
+			memory = (unsigned long long)(memory / 1000.0); // turn into Mb
 			ImGui::Text((to_string(memory) + string(" Mb")).c_str());	ImGui::NextColumn();
 		}
 	}
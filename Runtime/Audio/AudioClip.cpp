@@ -70,7 +70,7 @@ namespace Directus
 		return m_playMode == Play_Memory ? CreateSound(filePath) : CreateStream(filePath);
 	}
 
-	unsigned int AudioClip::GetMemoryUsage()
+	unsigned long long AudioClip::GetMemoryUsage()
 	{
 		return 0; // have to find a way to get that
 	}
@@ -60,7 +60,7 @@ namespace Directus
 		//= IResource ========================================================
 		bool LoadFromFile(const std::string& filePath) override;
 		bool SaveToFile(const std::string& filePath) override { return true; }
-		unsigned int GetMemoryUsage() override;
+		unsigned long long GetMemoryUsage() override;
 		//====================================================================
 
 		bool Play();
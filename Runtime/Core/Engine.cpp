@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/EventSystem.h"
 #include "../Logging/Log.h"
 #include "../Threading/Threading.h"
+#include "../IO/FileStream.h"
 #include "../Resource/ResourceManager.h"
 #include "../Scripting/Scripting.h"
 #include "../Audio/Audio.h"
@@ -102,6 +103,7 @@ namespace Directus
 			LOG_ERROR("Engine::Initialize: Failed to initialize Multithreading");
 			return false;
 		}
+		FileStream::SetThreading(m_context->GetSubsystem<Threading>());
 
 		// ResourceManager
 		if (!m_context->GetSubsystem<ResourceManager>()->Initialize())
@@ -173,6 +175,7 @@ namespace Directus
 	{
 		// The context will deallocate the subsystems
 		// in the reverse order in which they were registered.
+		FileStream::SetThreading(nullptr);
 		SafeDelete(m_context);
 
 		// Release Log singleton
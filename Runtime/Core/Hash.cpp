@@ -0,0 +1,126 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ======
+#include "Hash.h"
+#include <cstring>
+#include <cstdint>
+//=================
+
+namespace Directus
+{
+	namespace _Hash
+	{
+		static const uint64_t prime1 = 11400714785074694791ULL;
+		static const uint64_t prime2 = 14029467366897019727ULL;
+		static const uint64_t prime3 = 1609587929392839161ULL;
+		static const uint64_t prime4 = 9650029242287828579ULL;
+		static const uint64_t prime5 = 2870177450012600261ULL;
+
+		inline uint64_t RotateLeft(uint64_t x, int r)	{ return (x << r) | (x >> (64 - r)); }
+		inline uint64_t Read64(const uint8_t* ptr)		{ uint64_t value; memcpy(&value, ptr, sizeof(value)); return value; }
+		inline uint32_t Read32(const uint8_t* ptr)		{ uint32_t value; memcpy(&value, ptr, sizeof(value)); return value; }
+
+		inline uint64_t Round(uint64_t acc, uint64_t input)
+		{
+			acc += input * prime2;
+			acc = RotateLeft(acc, 31);
+			return acc * prime1;
+		}
+
+		inline uint64_t MergeRound(uint64_t acc, uint64_t value)
+		{
+			acc ^= Round(0, value);
+			return acc * prime1 + prime4;
+		}
+	}
+
+	unsigned long long Hash::Compute(const void* data, size_t size, unsigned long long seed)
+	{
+		using namespace _Hash;
+
+		const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+		const uint8_t* const end = ptr + size;
+		uint64_t hash;
+
+		if (size >= 32)
+		{
+			// Four independent lanes
+			uint64_t v1 = seed + prime1 + prime2;
+			uint64_t v2 = seed + prime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - prime1;
+
+			const uint8_t* const limit = end - 32;
+			do
+			{
+				v1 = Round(v1, Read64(ptr));		ptr += 8;
+				v2 = Round(v2, Read64(ptr));		ptr += 8;
+				v3 = Round(v3, Read64(ptr));		ptr += 8;
+				v4 = Round(v4, Read64(ptr));		ptr += 8;
+			} while (ptr <= limit);
+
+			hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+			hash = MergeRound(hash, v1);
+			hash = MergeRound(hash, v2);
+			hash = MergeRound(hash, v3);
+			hash = MergeRound(hash, v4);
+		}
+		else
+		{
+			hash = seed + prime5;
+		}
+
+		hash += (uint64_t)size;
+
+		// Tail
+		while (ptr + 8 <= end)
+		{
+			hash ^= Round(0, Read64(ptr));
+			hash = RotateLeft(hash, 27) * prime1 + prime4;
+			ptr += 8;
+		}
+
+		if (ptr + 4 <= end)
+		{
+			hash ^= (uint64_t)Read32(ptr) * prime1;
+			hash = RotateLeft(hash, 23) * prime2 + prime3;
+			ptr += 4;
+		}
+
+		while (ptr < end)
+		{
+			hash ^= (*ptr) * prime5;
+			hash = RotateLeft(hash, 11) * prime1;
+			ptr++;
+		}
+
+		// Avalanche
+		hash ^= hash >> 33;
+		hash *= prime2;
+		hash ^= hash >> 29;
+		hash *= prime3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+}
\ No newline at end of file
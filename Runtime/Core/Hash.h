@@ -0,0 +1,48 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <string>
+#include "EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	// Fast 64-bit non-cryptographic hashing (xxHash64), used to identify content
+	class ENGINE_CLASS Hash
+	{
+	public:
+		static unsigned long long Compute(const void* data, size_t size, unsigned long long seed = 0);
+		static unsigned long long Compute(const std::string& str, unsigned long long seed = 0) { return Compute(str.data(), str.size(), seed); }
+
+		// Hashes the bytes of a trivially copyable value
+		template <typename T>
+		static unsigned long long ComputeValue(const T& value, unsigned long long seed = 0) { return Compute(&value, sizeof(T), seed); }
+
+		static unsigned long long Combine(unsigned long long seed, unsigned long long value)
+		{
+			return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+		}
+	};
+}
\ No newline at end of file
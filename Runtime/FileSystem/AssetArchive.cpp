@@ -0,0 +1,310 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==============
+#include "AssetArchive.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+#include "FileSystem.h"
+#include "../Logging/Log.h"
+#include <Windows.h>
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _AssetArchive
+	{
+		static const unsigned int magic		= 0x4B415044; // "DPAK"
+		static const unsigned int version	= 2;
+		static const unsigned int alignment	= 4096;
+
+		struct Header
+		{
+			unsigned int magic;
+			unsigned int version;
+			unsigned int entryCount;
+			unsigned int padding;
+			unsigned long long indexOffset;
+			unsigned long long pathsOffset;
+			unsigned long long pathsSize;
+		};
+
+		// FNV-1a
+		inline unsigned long long Hash(const string& str)
+		{
+			unsigned long long hash = 14695981039346656037ULL;
+			for (char c : str)
+			{
+				hash ^= (unsigned char)c;
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+	}
+
+	AssetArchive::AssetArchive()
+	{
+		m_data			= nullptr;
+		m_paths			= nullptr;
+		m_dataSize		= 0;
+		m_fileHandle	= nullptr;
+		m_mappingHandle	= nullptr;
+	}
+
+	AssetArchive::~AssetArchive()
+	{
+		Close();
+	}
+
+	bool AssetArchive::Create(const string& archivePath, const vector<string>& filePaths)
+	{
+		using namespace _AssetArchive;
+
+		ofstream out(archivePath, ios::out | ios::binary);
+		if (out.fail())
+		{
+			LOGF_ERROR("AssetArchive::Create: Failed to open \"%s\" for writing", archivePath.c_str());
+			return false;
+		}
+
+		// Reserve the first page for the header
+		Header header	= { magic, version, 0, 0, 0, 0, 0 };
+		vector<char> zeros(alignment, 0);
+		out.write(zeros.data(), alignment);
+
+		vector<Entry> entries;
+		unordered_set<string> paths;
+		string pathTable;
+		vector<char> buffer;
+		unsigned long long offset = alignment;
+		for (const auto& filePath : filePaths)
+		{
+			ifstream in(filePath, ios::in | ios::binary | ios::ate);
+			if (in.fail())
+			{
+				LOGF_WARNING("AssetArchive::Create: Failed to read \"%s\", skipping", filePath.c_str());
+				continue;
+			}
+
+			string path = NormalizePath(filePath);
+			if (!paths.insert(path).second)
+			{
+				LOGF_WARNING("AssetArchive::Create: \"%s\" is already in the archive, skipping", filePath.c_str());
+				continue;
+			}
+
+			Entry entry;
+			entry.hash			= Hash(path);
+			entry.offset		= offset;
+			entry.size			= (unsigned long long)in.tellg();
+			entry.pathOffset	= (unsigned int)pathTable.size();
+			entry.pathSize		= (unsigned int)path.size();
+			pathTable			+= path;
+
+			buffer.resize((size_t)entry.size);
+			in.seekg(0, ios::beg);
+			in.read(buffer.data(), buffer.size());
+			out.write(buffer.data(), buffer.size());
+
+			// Pad to the next page
+			unsigned long long padding = (alignment - (entry.size % alignment)) % alignment;
+			out.write(zeros.data(), padding);
+			offset += entry.size + padding;
+
+			entries.emplace_back(entry);
+		}
+
+		// Index, sorted by hash so lookups can binary search
+		sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+		out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+		out.write(pathTable.data(), pathTable.size());
+
+		header.entryCount	= (unsigned int)entries.size();
+		header.indexOffset	= offset;
+		header.pathsOffset	= offset + entries.size() * sizeof(Entry);
+		header.pathsSize	= pathTable.size();
+		out.seekp(0, ios::beg);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		if (out.fail())
+		{
+			LOGF_ERROR("AssetArchive::Create: Failed to write \"%s\"", archivePath.c_str());
+			return false;
+		}
+
+		LOGF_INFO("AssetArchive::Create: Packed %d files into \"%s\"", header.entryCount, archivePath.c_str());
+		return true;
+	}
+
+	string AssetArchive::NormalizePath(const string& filePath)
+	{
+		string path = filesystem::path(filePath).is_absolute() ? FileSystem::GetRelativeFilePath(filePath) : filePath;
+
+		// Forward slashes only, without duplicates
+		replace(path.begin(), path.end(), '\\', '/');
+		path.erase(unique(path.begin(), path.end(), [](char a, char b) { return a == '/' && b == '/'; }), path.end());
+
+		while (path.compare(0, 2, "./") == 0)
+		{
+			path.erase(0, 2);
+		}
+
+		// Windows paths are case insensitive
+		transform(path.begin(), path.end(), path.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+
+		return path;
+	}
+
+	bool AssetArchive::Open(const string& archivePath)
+	{
+		using namespace _AssetArchive;
+
+		Close();
+
+		m_fileHandle = CreateFileW(FileSystem::StringToWString(archivePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_fileHandle == INVALID_HANDLE_VALUE)
+		{
+			m_fileHandle = nullptr;
+			LOGF_ERROR("AssetArchive::Open: Failed to open \"%s\"", archivePath.c_str());
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header))
+		{
+			LOGF_ERROR("AssetArchive::Open: \"%s\" is not a valid archive", archivePath.c_str());
+			Close();
+			return false;
+		}
+		m_dataSize = (unsigned long long)fileSize.QuadPart;
+
+		m_mappingHandle = CreateFileMappingW(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_mappingHandle)
+		{
+			m_data = reinterpret_cast<const std::byte*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		}
+
+		if (!m_data)
+		{
+			LOGF_ERROR("AssetArchive::Open: Failed to map \"%s\"", archivePath.c_str());
+			Close();
+			return false;
+		}
+
+		// Validate
+		Header header;
+		memcpy(&header, m_data, sizeof(Header));
+		unsigned long long indexSize = (unsigned long long)header.entryCount * sizeof(Entry);
+		if (header.magic != magic || header.version != version || header.indexOffset + indexSize > header.pathsOffset || header.pathsOffset + header.pathsSize > m_dataSize)
+		{
+			LOGF_ERROR("AssetArchive::Open: \"%s\" is not a valid archive", archivePath.c_str());
+			Close();
+			return false;
+		}
+
+		m_entries.resize(header.entryCount);
+		memcpy(m_entries.data(), m_data + header.indexOffset, (size_t)indexSize);
+
+		for (const auto& entry : m_entries)
+		{
+			if (entry.offset + entry.size > header.indexOffset || (unsigned long long)entry.pathOffset + entry.pathSize > header.pathsSize)
+			{
+				LOGF_ERROR("AssetArchive::Open: \"%s\" has a corrupt index", archivePath.c_str());
+				Close();
+				return false;
+			}
+		}
+
+		m_paths		= reinterpret_cast<const char*>(m_data + header.pathsOffset);
+		m_filePath	= archivePath;
+		return true;
+	}
+
+	void AssetArchive::Close()
+	{
+		if (m_data)
+		{
+			UnmapViewOfFile(m_data);
+		}
+
+		if (m_mappingHandle)
+		{
+			CloseHandle(m_mappingHandle);
+		}
+
+		if (m_fileHandle)
+		{
+			CloseHandle(m_fileHandle);
+		}
+
+		m_data			= nullptr;
+		m_paths			= nullptr;
+		m_dataSize		= 0;
+		m_fileHandle	= nullptr;
+		m_mappingHandle	= nullptr;
+		m_entries.clear();
+		m_filePath.clear();
+	}
+
+	bool AssetArchive::Contains(const string& filePath)
+	{
+		return FindEntry(filePath) != nullptr;
+	}
+
+	bool AssetArchive::GetFile(const string& filePath, const std::byte** data, size_t* size)
+	{
+		auto entry = FindEntry(filePath);
+		if (!entry)
+			return false;
+
+		if (data) *data = m_data + entry->offset;
+		if (size) *size = (size_t)entry->size;
+
+		return true;
+	}
+
+	const AssetArchive::Entry* AssetArchive::FindEntry(const string& filePath)
+	{
+		if (m_entries.empty())
+			return nullptr;
+
+		string path				= NormalizePath(filePath);
+		unsigned long long hash	= _AssetArchive::Hash(path);
+		auto it = lower_bound(m_entries.begin(), m_entries.end(), hash, [](const Entry& entry, unsigned long long value) { return entry.hash < value; });
+
+		// The hash only narrows the search down, the path decides
+		for (; it != m_entries.end() && it->hash == hash; it++)
+		{
+			if (it->pathSize == path.size() && memcmp(m_paths + it->pathOffset, path.data(), path.size()) == 0)
+				return &(*it);
+		}
+
+		return nullptr;
+	}
+}
\ No newline at end of file
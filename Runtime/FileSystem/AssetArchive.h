@@ -0,0 +1,76 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	// A read-only pack of engine files, indexed by a hash of their (relative) path. The paths
+	// themselves are stored as well, so files whose path hashes collide are still told apart.
+	// The archive is memory mapped and every entry starts on a page boundary, so
+	// entries can be handed out as pointers into the mapping without any copies.
+	class ENGINE_CLASS AssetArchive
+	{
+	public:
+		AssetArchive();
+		~AssetArchive();
+
+		// Packs the given files into a new archive, paths are stored relative to the working directory
+		static bool Create(const std::string& archivePath, const std::vector<std::string>& filePaths);
+		// Normalizes a path the way the archive index expects it (relative, lowercase, forward slashes)
+		static std::string NormalizePath(const std::string& filePath);
+
+		bool Open(const std::string& archivePath);
+		void Close();
+
+		bool Contains(const std::string& filePath);
+		bool GetFile(const std::string& filePath, const std::byte** data, size_t* size);
+		const std::string& GetFilePath() { return m_filePath; }
+		unsigned int GetEntryCount() { return (unsigned int)m_entries.size(); }
+
+	private:
+		struct Entry
+		{
+			unsigned long long hash;
+			unsigned long long offset;
+			unsigned long long size;
+			unsigned int pathOffset; // into the path table
+			unsigned int pathSize;
+		};
+		const Entry* FindEntry(const std::string& filePath);
+
+		std::string m_filePath;
+		std::vector<Entry> m_entries; // sorted by hash
+		const char* m_paths;
+		const std::byte* m_data;
+		unsigned long long m_dataSize;
+		void* m_fileHandle;
+		void* m_mappingHandle;
+	};
+}
\ No newline at end of file
@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "FileSystem.h"
 #include <filesystem>
 #include <regex>
+#include <mutex>
+#include "AssetArchive.h"
 #include "../Logging/Log.h"
 #include <Windows.h>
 #include <shellapi.h>
@@ -42,6 +44,12 @@ namespace Directus
 	vector<string> FileSystem::m_supportedScriptFormats;
 	vector<string> FileSystem::m_supportedFontFormats;
 
+	namespace _FileSystem
+	{
+		static vector<unique_ptr<AssetArchive>> archives;
+		static mutex archiveMutex;
+	}
+
 	void FileSystem::Initialize()
 	{
 		// Supported image formats
@@ -240,7 +248,10 @@ namespace Directus
 
 	bool FileSystem::FileExists(const string& filePath)
 	{
-		bool result;
+		if (IsMounted(filePath))
+			return true;
+
+		bool result = false;
 		try
 		{
 			result = exists(filePath);
@@ -296,6 +307,44 @@ namespace Directus
 		return result;
 	}
 
+	bool FileSystem::Mount(const string& archivePath)
+	{
+		auto archive = make_unique<AssetArchive>();
+		if (!archive->Open(archivePath))
+			return false;
+
+		LOGF_INFO("FileSystem::Mount: Mounted \"%s\" (%d files)", archivePath.c_str(), archive->GetEntryCount());
+
+		lock_guard<mutex> guard(_FileSystem::archiveMutex);
+		_FileSystem::archives.emplace_back(move(archive));
+		return true;
+	}
+
+	void FileSystem::UnmountAll()
+	{
+		lock_guard<mutex> guard(_FileSystem::archiveMutex);
+		_FileSystem::archives.clear();
+	}
+
+	bool FileSystem::IsMounted(const string& filePath)
+	{
+		return GetMountedFile(filePath, nullptr, nullptr);
+	}
+
+	bool FileSystem::GetMountedFile(const string& filePath, const std::byte** data, size_t* size)
+	{
+		lock_guard<mutex> guard(_FileSystem::archiveMutex);
+
+		// Archives mounted last win
+		for (auto it = _FileSystem::archives.rbegin(); it != _FileSystem::archives.rend(); ++it)
+		{
+			if ((*it)->GetFile(filePath, data, size))
+				return true;
+		}
+
+		return false;
+	}
+
 	string FileSystem::GetFileNameFromFilePath(const string& path)
 	{
 		auto lastindex	= path.find_last_of("\\/");
@@ -607,6 +656,11 @@ namespace Directus
 		return GetExtensionFromFilePath(filePath) == METADATA_EXTENSION;
 	}
 
+	bool FileSystem::IsEngineArchiveFile(const string& filePath)
+	{
+		return GetExtensionFromFilePath(filePath) == EXTENSION_ARCHIVE;
+	}
+
 	// Returns a file path which is relative to the engine's executable
 	string FileSystem::GetRelativeFilePath(const string& absoluteFilePath)
 	{		
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include <vector>
+#include <cstddef>
 #include "../Core/EngineDefs.h"
 //=============================
 
@@ -41,6 +42,8 @@ static const char* EXTENSION_PREFAB			= ".prefab";
 static const char* EXTENSION_SHADER			= ".shader";
 static const char* EXTENSION_TEXTURE		= ".texture";
 static const char* EXTENSION_MESH			= ".mesh";
+static const char* EXTENSION_ARCHIVE		= ".pak";
+static const char* EXTENSION_MATERIAL_XML	= ".xml"; // materials exported for editing by hand
 //=========================================================
 
 namespace Directus
@@ -64,6 +67,15 @@ namespace Directus
 		static bool CopyFileFromTo(const std::string& source, const std::string& destination);
 		//====================================================================================
 
+		//= ARCHIVES =======================================================================================
+		// Files inside mounted archives take precedence over loose files with the same (relative) path.
+		// Data returned by GetMountedFile() stays valid until the archives are unmounted.
+		static bool Mount(const std::string& archivePath);
+		static void UnmountAll();
+		static bool IsMounted(const std::string& filePath);
+		static bool GetMountedFile(const std::string& filePath, const std::byte** data, size_t* size);
+		//==================================================================================================
+
 		//= DIRECTORY PARSING  =================================================================
 		static std::string GetFileNameFromFilePath(const std::string& path);
 		static std::string GetFileNameNoExtensionFromFilePath(const std::string& filepath);
@@ -102,6 +114,7 @@ namespace Directus
 		static bool IsEngineTextureFile(const std::string& filePath);
 		static bool IsEngineShaderFile(const std::string& filePath);
 		static bool IsEngineMetadataFile(const std::string& filePath);
+		static bool IsEngineArchiveFile(const std::string& filePath);
 		//=============================================================
 
 		//= STRING PARSING =============================================================================================================================
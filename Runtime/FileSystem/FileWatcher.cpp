@@ -0,0 +1,237 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =============
+#include "FileWatcher.h"
+#include <mutex>
+#include <algorithm>
+#include <cstddef>
+#include "FileSystem.h"
+#include "../Logging/Log.h"
+#include <Windows.h>
+//========================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace chrono;
+//==================
+
+namespace Directus
+{
+	namespace _FileWatcher
+	{
+		// How long a file has to be quiet before it's reported
+		static const milliseconds debounce = milliseconds(250);
+
+		// Files the engine writes, by how many writers and when the last one finished
+		struct Suppression
+		{
+			unsigned int writers = 0;
+			steady_clock::time_point end;
+		};
+		static mutex suppressedMutex;
+		static unordered_map<string, Suppression> suppressed;
+	}
+
+	struct WatchedDirectory
+	{
+		~WatchedDirectory()
+		{
+			if (handle != INVALID_HANDLE_VALUE)
+			{
+				// The buffer is written to by the pending read, wait for it to be cancelled
+				DWORD bytes = 0;
+				CancelIo(handle);
+				GetOverlappedResult(handle, &overlapped, &bytes, TRUE);
+				CloseHandle(handle);
+			}
+
+			if (overlapped.hEvent)
+			{
+				CloseHandle(overlapped.hEvent);
+			}
+		}
+
+		bool Read()
+		{
+			ResetEvent(overlapped.hEvent);
+			return ReadDirectoryChangesW(
+				handle,
+				buffer,
+				sizeof(buffer),
+				TRUE,
+				FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE,
+				nullptr,
+				&overlapped,
+				nullptr
+			) != 0;
+		}
+
+		string directory;
+		HANDLE handle			= INVALID_HANDLE_VALUE;
+		OVERLAPPED overlapped	= {};
+		DWORD buffer[16 * 1024]	= {}; // notifications have to be DWORD aligned
+	};
+
+	FileWatcher::FileWatcher()
+	{
+
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		RemoveDirectories();
+	}
+
+	bool FileWatcher::AddDirectory(const string& directory)
+	{
+		auto watched		= make_shared<WatchedDirectory>();
+		watched->directory	= directory;
+		watched->handle		= CreateFileA(
+			directory.c_str(),
+			FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+			nullptr
+		);
+
+		if (watched->handle == INVALID_HANDLE_VALUE)
+		{
+			LOGF_WARNING("FileWatcher::AddDirectory: Failed to open \"%s\"", directory.c_str());
+			return false;
+		}
+
+		watched->overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+		if (!watched->overlapped.hEvent || !watched->Read())
+		{
+			LOGF_WARNING("FileWatcher::AddDirectory: Failed to watch \"%s\"", directory.c_str());
+			return false;
+		}
+
+		m_directories.emplace_back(watched);
+		return true;
+	}
+
+	void FileWatcher::RemoveDirectories()
+	{
+		m_directories.clear();
+		m_changes.clear();
+	}
+
+	void FileWatcher::GetChanges(vector<string>* filePaths)
+	{
+		if (!filePaths)
+			return;
+
+		Poll();
+
+		auto now = steady_clock::now();
+		lock_guard<mutex> guard(_FileWatcher::suppressedMutex);
+
+		// Forget about files the engine finished writing, once any changes it caused have been debounced
+		for (auto it = _FileWatcher::suppressed.begin(); it != _FileWatcher::suppressed.end();)
+		{
+			bool settled = it->second.writers == 0 && now - it->second.end > _FileWatcher::debounce * 2;
+			it = settled ? _FileWatcher::suppressed.erase(it) : next(it);
+		}
+
+		for (auto it = m_changes.begin(); it != m_changes.end();)
+		{
+			if (now - it->second < _FileWatcher::debounce)
+			{
+				++it;
+				continue;
+			}
+
+			// Changes seen while the engine writes the file, or shortly after, are its own
+			auto suppression	= _FileWatcher::suppressed.find(it->first);
+			bool suppressed		= suppression != _FileWatcher::suppressed.end() && (suppression->second.writers != 0 || it->second <= suppression->second.end + _FileWatcher::debounce);
+			if (!suppressed)
+			{
+				filePaths->emplace_back(it->first);
+			}
+			it = m_changes.erase(it);
+		}
+	}
+
+	void FileWatcher::Suppress_Begin(const string& filePath)
+	{
+		auto path = FileSystem::GetRelativeFilePath(filePath);
+
+		lock_guard<mutex> guard(_FileWatcher::suppressedMutex);
+		_FileWatcher::suppressed[path].writers++;
+	}
+
+	void FileWatcher::Suppress_End(const string& filePath)
+	{
+		auto path = FileSystem::GetRelativeFilePath(filePath);
+
+		lock_guard<mutex> guard(_FileWatcher::suppressedMutex);
+		auto it = _FileWatcher::suppressed.find(path);
+		if (it == _FileWatcher::suppressed.end() || it->second.writers == 0)
+			return;
+
+		it->second.writers--;
+		it->second.end = steady_clock::now();
+	}
+
+	void FileWatcher::Poll()
+	{
+		for (auto it = m_directories.begin(); it != m_directories.end();)
+		{
+			auto& watched = *it;
+
+			DWORD bytes = 0;
+			if (!GetOverlappedResult(watched->handle, &watched->overlapped, &bytes, FALSE) && GetLastError() == ERROR_IO_INCOMPLETE)
+			{
+				++it;
+				continue;
+			}
+
+			// Zero bytes means the buffer overflowed and the notifications were lost
+			auto info = bytes != 0 ? reinterpret_cast<FILE_NOTIFY_INFORMATION*>(watched->buffer) : nullptr;
+			while (info)
+			{
+				if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME)
+				{
+					int length = (int)(info->FileNameLength / sizeof(WCHAR));
+					string name(WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, nullptr, 0, nullptr, nullptr), 0);
+					WideCharToMultiByte(CP_UTF8, 0, info->FileName, length, &name[0], (int)name.size(), nullptr, nullptr);
+					replace(name.begin(), name.end(), '\\', '/');
+
+					m_changes[FileSystem::GetRelativeFilePath(watched->directory + name)] = steady_clock::now();
+				}
+
+				info = info->NextEntryOffset ? reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<std::byte*>(info) + info->NextEntryOffset) : nullptr;
+			}
+
+			if (!watched->Read())
+			{
+				LOGF_WARNING("FileWatcher::Poll: Stopped watching \"%s\"", watched->directory.c_str());
+				it = m_directories.erase(it);
+				continue;
+			}
+			++it;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =================
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <unordered_map>
+#include "../Core/EngineDefs.h"
+//============================
+
+namespace Directus
+{
+	// Watches directories (and their subdirectories) for files which are created, modified or renamed.
+	// Notifications are polled, there is no thread of its own. A file is reported once it has been quiet
+	// for a short while, as applications tend to write a file in several steps.
+	class ENGINE_CLASS FileWatcher
+	{
+	public:
+		FileWatcher();
+		~FileWatcher();
+
+		bool AddDirectory(const std::string& directory);
+		void RemoveDirectories();
+
+		// Returns the (relative) paths of the files which changed since the last call
+		void GetChanges(std::vector<std::string>* filePaths);
+
+		// Changes to a file which the engine writes itself are ignored, from when writing begins
+		// until it ends (plus the time it takes for the notifications to settle)
+		static void Suppress_Begin(const std::string& filePath);
+		static void Suppress_End(const std::string& filePath);
+
+	private:
+		void Poll();
+
+		std::vector<std::shared_ptr<struct WatchedDirectory>> m_directories;
+		std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_changes;
+	};
+}
\ No newline at end of file
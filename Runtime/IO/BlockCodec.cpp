@@ -0,0 +1,236 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+//= INCLUDES ==============
+#include "BlockCodec.h"
+#include <cstring>
+#include <cstdint>
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _BlockCodec
+	{
+		static const unsigned int minMatch		= 4;
+		static const unsigned int lastLiterals	= 5;	// The tail of a block is always stored as literals
+		static const unsigned int matchLimit	= 12;	// A match can't start this close to the end of a block
+		static const unsigned int maxOffset		= 65535;
+		static const unsigned int hashLog		= 12;
+
+		inline uint32_t Read32(const byte* ptr)
+		{
+			uint32_t value;
+			memcpy(&value, ptr, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t Hash(uint32_t sequence)
+		{
+			return (sequence * 2654435761U) >> (32 - hashLog);
+		}
+
+		// Writes a length that didn't fit in a token nibble as a run of 255s plus a remainder
+		inline byte* WriteLength(byte* op, size_t length)
+		{
+			while (length >= 255)
+			{
+				*op++ = byte(255);
+				length -= 255;
+			}
+			*op++ = byte(length);
+			return op;
+		}
+
+		inline bool ReadLength(const byte*& ip, const byte* ipEnd, size_t& length)
+		{
+			unsigned int s;
+			do
+			{
+				if (ip >= ipEnd)
+					return false;
+
+				s		= (unsigned int)*ip++;
+				length	+= s;
+			} while (s == 255);
+
+			return true;
+		}
+	}
+
+	size_t BlockCodec::Compress(const byte* src, size_t srcSize, byte* dst, size_t dstCapacity)
+	{
+		using namespace _BlockCodec;
+
+		if (!src || !dst || dstCapacity < GetCompressBound(srcSize))
+			return 0;
+
+		const byte* ip			= src;
+		const byte* anchor		= src;
+		const byte* const iend	= src + srcSize;
+		byte* op				= dst;
+
+		// Positions (relative to src) of the last occurrence of each hashed 4 byte sequence
+		uint32_t hashTable[1 << hashLog];
+		memset(hashTable, 0, sizeof(hashTable));
+
+		if (srcSize >= matchLimit)
+		{
+			const byte* const mflimit = iend - matchLimit;
+			ip++;
+
+			while (ip < mflimit)
+			{
+				// Find a match
+				uint32_t sequence	= Read32(ip);
+				uint32_t h			= Hash(sequence);
+				const byte* ref		= src + hashTable[h];
+				hashTable[h]		= (uint32_t)(ip - src);
+
+				if (ref >= ip || (size_t)(ip - ref) > maxOffset || Read32(ref) != sequence)
+				{
+					ip++;
+					continue;
+				}
+
+				// Extend the match backwards over pending literals
+				while (ip > anchor && ref > src && ip[-1] == ref[-1]) { ip--; ref--; }
+
+				// Extend the match forwards
+				const byte* matchEnd	= ip + minMatch;
+				const byte* refEnd		= ref + minMatch;
+				const byte* const matchMax = iend - lastLiterals;
+				while (matchEnd < matchMax && *matchEnd == *refEnd) { matchEnd++; refEnd++; }
+
+				size_t literalLength	= (size_t)(ip - anchor);
+				size_t matchLength		= (size_t)(matchEnd - ip) - minMatch;
+
+				// Token
+				byte* token = op++;
+				*token = byte(((literalLength >= 15 ? 15 : literalLength) << 4) | (matchLength >= 15 ? 15 : matchLength));
+
+				// Literals
+				if (literalLength >= 15) op = WriteLength(op, literalLength - 15);
+				memcpy(op, anchor, literalLength);
+				op += literalLength;
+
+				// Offset (little endian)
+				uint16_t offset = (uint16_t)(ip - ref);
+				*op++ = byte(offset & 0xFF);
+				*op++ = byte(offset >> 8);
+
+				// Match length
+				if (matchLength >= 15) op = WriteLength(op, matchLength - 15);
+
+				ip		= matchEnd;
+				anchor	= ip;
+
+				// Index the position right before the new anchor, it often starts the next match
+				if (ip - 2 > src)
+				{
+					hashTable[Hash(Read32(ip - 2))] = (uint32_t)(ip - 2 - src);
+				}
+			}
+		}
+
+		// Last literals
+		size_t literalLength = (size_t)(iend - anchor);
+		*op++ = byte((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (literalLength >= 15) op = WriteLength(op, literalLength - 15);
+		memcpy(op, anchor, literalLength);
+		op += literalLength;
+
+		return (size_t)(op - dst);
+	}
+
+	size_t BlockCodec::Decompress(const byte* src, size_t srcSize, byte* dst, size_t dstCapacity)
+	{
+		using namespace _BlockCodec;
+
+		if (!src || !dst || srcSize == 0)
+			return 0;
+
+		const byte* ip			= src;
+		const byte* const iend	= src + srcSize;
+		byte* op				= dst;
+		byte* const oend		= dst + dstCapacity;
+
+		while (ip < iend)
+		{
+			unsigned int token = (unsigned int)*ip++;
+
+			// Literals
+			size_t literalLength = token >> 4;
+			if (literalLength == 15 && !ReadLength(ip, iend, literalLength))
+				return 0;
+
+			if (literalLength > (size_t)(iend - ip) || literalLength > (size_t)(oend - op))
+				return 0;
+
+			memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// The last sequence has no match
+			if (ip >= iend)
+				break;
+
+			// Offset
+			if (iend - ip < 2)
+				return 0;
+
+			size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > (size_t)(op - dst))
+				return 0;
+
+			// Match
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(ip, iend, matchLength))
+				return 0;
+			matchLength += minMatch;
+
+			if (matchLength > (size_t)(oend - op))
+				return 0;
+
+			// Matches can overlap with the output (run-length), so copy byte by byte in that case
+			const byte* ref = op - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(op, ref, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				for (size_t i = 0; i < matchLength; i++)
+				{
+					*op++ = *ref++;
+				}
+			}
+		}
+
+		return (size_t)(op - dst);
+	}
+}
\ No newline at end of file
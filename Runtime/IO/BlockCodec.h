@@ -0,0 +1,47 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <cstddef>
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	// A fast LZ77 block codec (LZ4 style token/literal/offset layout).
+	// Every block is self-contained, so separate blocks can be decoded in any order and on any thread.
+	class ENGINE_CLASS BlockCodec
+	{
+	public:
+		// Worst case size of a compressed block
+		static size_t GetCompressBound(size_t size) { return size + (size / 255) + 16; }
+
+		// Compresses a block, returns the compressed size (0 on failure)
+		static size_t Compress(const std::byte* src, size_t srcSize, std::byte* dst, size_t dstCapacity);
+
+		// Decompresses a block, returns the decompressed size (0 on failure or corrupt data)
+		static size_t Decompress(const std::byte* src, size_t srcSize, std::byte* dst, size_t dstCapacity);
+	};
+}
\ No newline at end of file
@@ -22,6 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================
 #include "FileStream.h"
 #include <iostream>
+#include <cstring>
+#include <algorithm>
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -30,6 +32,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Actor.h"
 #include "../Logging/Log.h"
 #include "../RHI/RHI_Vertex.h"
+#include "BlockCodec.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/FileWatcher.h"
+#include "../Threading/Threading.h"
 //==============================
 
 //= NAMESPACES ================
@@ -39,27 +45,81 @@ using namespace Directus::Math;
 
 namespace Directus
 {
-	FileStream::FileStream(const string& path, FileStreamMode mode)
+	namespace _FileStream
 	{
-		m_isOpen = false;
-		m_mode = mode;
+		static const unsigned int magic		= 0x504D4344; // "DCMP"
+		static const unsigned int version	= 1;
+		static const unsigned int chunkSize	= 256 * 1024;
+
+		// How many chunks are decompressed in parallel at most, they are read ahead into memory
+		static const size_t parallelChunks	= 32;
+	}
+
+	Threading* FileStream::m_threading = nullptr;
+
+	FileStream::FileStream(const string& path, FileStreamMode mode, bool compress)
+	{
+		m_isOpen		= false;
+		m_mode			= mode;
+		m_compressed	= false;
+		m_chunkPos		= 0;
+		m_memory		= nullptr;
+		m_memorySize	= 0;
+		m_memoryPos		= 0;
 
 		if (mode == FileStreamMode_Write)
 		{
+			// So the write isn't mistaken for an external change, until the stream is closed
+			m_path = path;
+			FileWatcher::Suppress_Begin(m_path);
+
 			out.open(path, ios::out | ios::binary);
 			if (out.fail())
 			{
 				LOGF_ERROR("StreamIO: Failed to open \"%s\" for writing", path.c_str());
 				return;
 			}
+
+			if (compress)
+			{
+				unsigned int header[3] = { _FileStream::magic, _FileStream::version, _FileStream::chunkSize };
+				WriteBytes(header, sizeof(header));
+				m_chunk.reserve(_FileStream::chunkSize);
+				m_compressed = true;
+			}
 		}
 		else if (mode == FileStreamMode_Read)
 		{
-			in.open(path, ios::in | ios::binary);
-			if(in.fail())
+			// Files in mounted archives are read straight from memory
+			if (!FileSystem::GetMountedFile(path, &m_memory, &m_memorySize))
 			{
-				LOGF_ERROR("StreamIO: Failed to open \"%s\" for reading", path.c_str());
-				return;
+				in.open(path, ios::in | ios::binary);
+				if(in.fail())
+				{
+					LOGF_ERROR("StreamIO: Failed to open \"%s\" for reading", path.c_str());
+					return;
+				}
+			}
+
+			// Detect compressed files, anything else is read as is
+			unsigned int header[3] = { 0, 0, 0 };
+			if (ReadRaw(header, sizeof(header)) && header[0] == _FileStream::magic)
+			{
+				if (header[1] != _FileStream::version)
+				{
+					LOGF_ERROR("StreamIO: \"%s\" has an unsupported compression version (%d)", path.c_str(), header[1]);
+					return;
+				}
+				m_compressed = true;
+			}
+			else if (m_memory)
+			{
+				m_memoryPos = 0;
+			}
+			else
+			{
+				in.clear();
+				in.seekg(0, ios::beg);
 			}
 		}
 
@@ -70,8 +130,13 @@ namespace Directus
 	{
 		if (m_mode == FileStreamMode_Write)
 		{
+			if (m_compressed && m_isOpen)
+			{
+				WriteChunk();
+			}
 			out.flush();
 			out.close();
+			FileWatcher::Suppress_End(m_path);
 		}
 		else if (m_mode == FileStreamMode_Read)
 		{
@@ -85,7 +150,7 @@ namespace Directus
 		auto length = (unsigned int)value.length();
 		Write(length);
 
-		out.write(const_cast<char*>(value.c_str()), length);
+		WriteBytes(value.c_str(), length);
 	}
 
 	void FileStream::Write(const vector<string>& value)
@@ -101,55 +166,69 @@ namespace Directus
 
 	void FileStream::Write(const Vector2& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector2));
+		WriteBytes(&value, sizeof(Vector2));
 	}
 
 	void FileStream::Write(const Vector3& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector3));
+		WriteBytes(&value, sizeof(Vector3));
 	}
 
 	void FileStream::Write(const Vector4& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Vector4));
+		WriteBytes(&value, sizeof(Vector4));
 	}
 
 	void FileStream::Write(const Quaternion& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(Quaternion));
+		WriteBytes(&value, sizeof(Quaternion));
 	}
 
 	void FileStream::Write(const BoundingBox& value)
 	{
-		out.write(reinterpret_cast<const char*>(&value), sizeof(BoundingBox));
+		WriteBytes(&value, sizeof(BoundingBox));
 	}
 
 	void FileStream::Write(const vector<RHI_Vertex_PosUVTBN>& value)
 	{
 		auto length = (unsigned int)value.size();
 		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(RHI_Vertex_PosUVTBN) * length);
+		WriteBytes(&value[0], sizeof(RHI_Vertex_PosUVTBN) * length);
+	}
+
+	void FileStream::Write(const vector<RHI_Vertex_PosUVTBN_Quantized>& value)
+	{
+		auto length = (unsigned int)value.size();
+		Write(length);
+		WriteBytes(&value[0], sizeof(RHI_Vertex_PosUVTBN_Quantized) * length);
 	}
 
 	void FileStream::Write(const vector<unsigned int>& value)
 	{
 		auto length = (unsigned int)value.size();
 		Write(length);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned int) * length);
+		WriteBytes(&value[0], sizeof(unsigned int) * length);
+	}
+
+	void FileStream::Write(const vector<unsigned short>& value)
+	{
+		auto length = (unsigned int)value.size();
+		Write(length);
+		WriteBytes(&value[0], sizeof(unsigned short) * length);
 	}
 
 	void FileStream::Write(const vector<unsigned char>& value)
 	{
 		auto size = (unsigned int)value.size();
 		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(unsigned char) * size);
+		WriteBytes(&value[0], sizeof(unsigned char) * size);
 	}
 
 	void FileStream::Write(const vector<std::byte>& value)
 	{
 		auto size = (unsigned int)value.size();
 		Write(size);
-		out.write(reinterpret_cast<const char*>(&value[0]), sizeof(std::byte) * size);
+		WriteBytes(&value[0], sizeof(std::byte) * size);
 	}
 
 	void FileStream::Read(string* value)
@@ -158,32 +237,32 @@ namespace Directus
 		Read(&length);
 
 		value->resize(length);
-		in.read(const_cast<char*>(value->c_str()), length);
+		ReadBytes(&(*value)[0], length);
 	}
 
 	void FileStream::Read(Vector2* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector2));
+		ReadBytes(value, sizeof(Vector2));
 	}
 
 	void FileStream::Read(Vector3* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector3));
+		ReadBytes(value, sizeof(Vector3));
 	}
 
 	void FileStream::Read(Vector4* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Vector4));
+		ReadBytes(value, sizeof(Vector4));
 	}
 
 	void FileStream::Read(Quaternion* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(Quaternion));
+		ReadBytes(value, sizeof(Quaternion));
 	}
 
 	void FileStream::Read(BoundingBox* value)
 	{
-		in.read(reinterpret_cast<char*>(value), sizeof(BoundingBox));
+		ReadBytes(value, sizeof(BoundingBox));
 	}
 
 	void FileStream::Read(vector<string>* vec)
@@ -218,7 +297,23 @@ namespace Directus
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosUVTBN) * length);
+		ReadBytes(vec->data(), sizeof(RHI_Vertex_PosUVTBN) * length);
+	}
+
+	void FileStream::Read(vector<RHI_Vertex_PosUVTBN_Quantized>* vec)
+	{
+		if (!vec)
+			return;
+
+		vec->clear();
+		vec->shrink_to_fit();
+
+		unsigned int length = ReadUInt();
+
+		vec->reserve(length);
+		vec->resize(length);
+
+		ReadBytes(vec->data(), sizeof(RHI_Vertex_PosUVTBN_Quantized) * length);
 	}
 
 	void FileStream::Read(vector<unsigned int>* vec)
@@ -234,7 +329,23 @@ namespace Directus
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned int) * length);
+		ReadBytes(vec->data(), sizeof(unsigned int) * length);
+	}
+
+	void FileStream::Read(vector<unsigned short>* vec)
+	{
+		if (!vec)
+			return;
+
+		vec->clear();
+		vec->shrink_to_fit();
+
+		unsigned int length = ReadUInt();
+
+		vec->reserve(length);
+		vec->resize(length);
+
+		ReadBytes(vec->data(), sizeof(unsigned short) * length);
 	}
 
 	void FileStream::Read(vector<unsigned char>* vec)
@@ -250,7 +361,7 @@ namespace Directus
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+		ReadBytes(vec->data(), sizeof(unsigned char) * length);
 	}
 
 	void FileStream::Read(vector<std::byte>* vec)
@@ -266,6 +377,239 @@ namespace Directus
 		vec->reserve(length);
 		vec->resize(length);
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+		ReadBytes(vec->data(), sizeof(std::byte) * length);
+	}
+
+	void FileStream::WriteBytes(const void* data, size_t size)
+	{
+		if (!m_compressed)
+		{
+			out.write(reinterpret_cast<const char*>(data), size);
+			return;
+		}
+
+		// Buffer into fixed size chunks, each one is compressed on its own
+		auto src = reinterpret_cast<const std::byte*>(data);
+		while (size > 0)
+		{
+			size_t count = min(size, _FileStream::chunkSize - m_chunk.size());
+			m_chunk.insert(m_chunk.end(), src, src + count);
+			src		+= count;
+			size	-= count;
+
+			if (m_chunk.size() == _FileStream::chunkSize)
+			{
+				WriteChunk();
+			}
+		}
+	}
+
+	void FileStream::ReadBytes(void* data, size_t size)
+	{
+		if (!m_compressed)
+		{
+			ReadRaw(data, size);
+			return;
+		}
+
+		auto dst = reinterpret_cast<std::byte*>(data);
+		while (size > 0)
+		{
+			// Whole chunks are decompressed in parallel, straight into the destination
+			if (m_threading && m_chunkPos == m_chunk.size() && size >= 2 * _FileStream::chunkSize)
+			{
+				size_t count = ReadChunksParallel(dst, size);
+				if (count == 0)
+				{
+					LOG_ERROR("StreamIO: Failed to decompress a compressed file");
+					return;
+				}
+
+				dst		+= count;
+				size	-= count;
+				continue;
+			}
+
+			if (m_chunkPos == m_chunk.size() && !ReadChunk())
+			{
+				LOG_ERROR("StreamIO: Attempted to read past the end of a compressed file");
+				return;
+			}
+
+			size_t count = min(size, m_chunk.size() - m_chunkPos);
+			memcpy(dst, &m_chunk[m_chunkPos], count);
+			m_chunkPos	+= count;
+			dst			+= count;
+			size		-= count;
+		}
+	}
+
+	void FileStream::Skip(size_t size)
+	{
+		if (!m_compressed)
+		{
+			SkipRaw(size);
+			return;
+		}
+
+		while (size > 0)
+		{
+			if (m_chunkPos == m_chunk.size() && !ReadChunk(&size))
+			{
+				LOG_ERROR("StreamIO: Attempted to skip past the end of a compressed file");
+				return;
+			}
+
+			size_t count = min(size, m_chunk.size() - m_chunkPos);
+			m_chunkPos	+= count;
+			size		-= count;
+		}
+	}
+
+	void FileStream::WriteChunk()
+	{
+		if (m_chunk.empty())
+			return;
+
+		auto rawSize = (unsigned int)m_chunk.size();
+		m_chunkCompressed.resize(BlockCodec::GetCompressBound(rawSize));
+		auto compressedSize = (unsigned int)BlockCodec::Compress(m_chunk.data(), rawSize, m_chunkCompressed.data(), m_chunkCompressed.size());
+
+		// Data that doesn't compress is stored as is (compressed size equals raw size)
+		bool stored = compressedSize == 0 || compressedSize >= rawSize;
+		if (stored)
+		{
+			compressedSize = rawSize;
+		}
+
+		out.write(reinterpret_cast<const char*>(&rawSize), sizeof(rawSize));
+		out.write(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
+		out.write(reinterpret_cast<const char*>(stored ? m_chunk.data() : m_chunkCompressed.data()), compressedSize);
+
+		m_chunk.clear();
+	}
+
+	bool FileStream::ReadRaw(void* data, size_t size)
+	{
+		if (!m_memory)
+		{
+			in.read(reinterpret_cast<char*>(data), size);
+			return !in.fail();
+		}
+
+		if (size > m_memorySize - m_memoryPos)
+		{
+			m_memoryPos = m_memorySize;
+			return false;
+		}
+
+		memcpy(data, m_memory + m_memoryPos, size);
+		m_memoryPos += size;
+		return true;
+	}
+
+	bool FileStream::SkipRaw(size_t size)
+	{
+		if (!m_memory)
+		{
+			in.seekg(size, ios::cur);
+			return !in.fail();
+		}
+
+		if (size > m_memorySize - m_memoryPos)
+		{
+			m_memoryPos = m_memorySize;
+			return false;
+		}
+
+		m_memoryPos += size;
+		return true;
+	}
+
+	bool FileStream::ReadChunk(size_t* skip /*= nullptr*/)
+	{
+		unsigned int rawSize		= 0;
+		unsigned int compressedSize	= 0;
+		if (!ReadRaw(&rawSize, sizeof(rawSize)) || !ReadRaw(&compressedSize, sizeof(compressedSize)))
+			return false;
+
+		if (rawSize == 0 || rawSize > _FileStream::chunkSize || compressedSize > rawSize)
+			return false;
+
+		// A chunk which is skipped entirely is never decompressed
+		if (skip && *skip >= rawSize)
+		{
+			*skip -= rawSize;
+			m_chunk.clear();
+			m_chunkPos = 0;
+			return SkipRaw(compressedSize);
+		}
+
+		m_chunk.resize(rawSize);
+		m_chunkPos = 0;
+
+		if (compressedSize == rawSize)
+			return ReadRaw(m_chunk.data(), rawSize);
+
+		m_chunkCompressed.resize(compressedSize);
+		if (!ReadRaw(m_chunkCompressed.data(), compressedSize) || BlockCodec::Decompress(m_chunkCompressed.data(), compressedSize, m_chunk.data(), rawSize) != rawSize)
+		{
+			m_chunk.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	size_t FileStream::ReadChunksParallel(std::byte* data, size_t size)
+	{
+		// Reading stays sequential, every chunk is handed to a worker as soon as it's in memory
+		size_t count = min(size / _FileStream::chunkSize, _FileStream::parallelChunks);
+		m_chunksCompressed.resize(count);
+
+		TaskGroup group;
+		atomic<bool> failed = false;
+		for (size_t i = 0; i < count; i++)
+		{
+			unsigned int rawSize		= 0;
+			unsigned int compressedSize	= 0;
+			if (!ReadRaw(&rawSize, sizeof(rawSize)) || !ReadRaw(&compressedSize, sizeof(compressedSize)) || rawSize != _FileStream::chunkSize || compressedSize > rawSize)
+			{
+				failed = true;
+				break;
+			}
+
+			auto dst = data + i * _FileStream::chunkSize;
+			if (compressedSize == rawSize)
+			{
+				if (!ReadRaw(dst, rawSize))
+				{
+					failed = true;
+					break;
+				}
+				continue;
+			}
+
+			auto& compressed = m_chunksCompressed[i];
+			compressed.resize(compressedSize);
+			if (!ReadRaw(compressed.data(), compressedSize))
+			{
+				failed = true;
+				break;
+			}
+
+			m_threading->AddTask([&compressed, &failed, dst]()
+			{
+				if (BlockCodec::Decompress(compressed.data(), compressed.size(), dst, _FileStream::chunkSize) != _FileStream::chunkSize)
+				{
+					failed = true;
+				}
+			}, &group);
+		}
+
+		// The chunks (and the group) must outlive the tasks
+		m_threading->Wait(&group);
+
+		return failed ? 0 : count * _FileStream::chunkSize;
 	}
-}
+}
\ No newline at end of file
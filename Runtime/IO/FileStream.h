@@ -29,7 +29,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Directus
 {
 	class Actor;
+	class Threading;
 	struct RHI_Vertex_PosUVTBN;
+	struct RHI_Vertex_PosUVTBN_Quantized;
 	namespace Math
 	{
 		class Vector2;
@@ -48,11 +50,16 @@ namespace Directus
 	class FileStream
 	{
 	public:
-		FileStream(const std::string& path, FileStreamMode mode);
+		// When compress is true, written data is stored as independently compressed chunks.
+		// Reading detects compressed files on its own, so uncompressed files still load.
+		FileStream(const std::string& path, FileStreamMode mode, bool compress = false);
 		~FileStream();
 
 		bool IsOpen() { return m_isOpen; }
 
+		// Threads which decompress the chunks of large reads in parallel, reads are decompressed serially without them
+		static void SetThreading(Threading* threading) { m_threading = threading; }
+
 		//= WRITING ==================================================
 		template <class T, class = typename std::enable_if<
 			std::is_same<T, int>::value || 
@@ -66,7 +73,7 @@ namespace Directus
 		>::type>
 		void Write(T value)
 		{
-			out.write(reinterpret_cast<char*>(&value), sizeof(value));
+			WriteBytes(&value, sizeof(value));
 		}
 
 		void Write(const std::string& value);
@@ -77,7 +84,9 @@ namespace Directus
 		void Write(const Math::BoundingBox& value);
 		void Write(const std::vector<std::string>& value);
 		void Write(const std::vector<RHI_Vertex_PosUVTBN>& value);
+		void Write(const std::vector<RHI_Vertex_PosUVTBN_Quantized>& value);
 		void Write(const std::vector<unsigned int>& value);
+		void Write(const std::vector<unsigned short>& value);
 		void Write(const std::vector<unsigned char>& value);
 		void Write(const std::vector<std::byte>& value);
 		//===========================================================
@@ -95,7 +104,7 @@ namespace Directus
 		>::type>
 			void Read(T* value)
 		{
-			in.read(reinterpret_cast<char*>(value), sizeof(T));
+			ReadBytes(value, sizeof(T));
 		}
 
 		void Read(std::string* value);	
@@ -106,7 +115,9 @@ namespace Directus
 		void Read(Math::BoundingBox* value);
 		void Read(std::vector<std::string>* vec);
 		void Read(std::vector<RHI_Vertex_PosUVTBN>* vec);
+		void Read(std::vector<RHI_Vertex_PosUVTBN_Quantized>* vec);
 		void Read(std::vector<unsigned int>* vec);
+		void Read(std::vector<unsigned short>* vec);
 		void Read(std::vector<unsigned char>* vec);
 		void Read(std::vector<std::byte>* vec);
 
@@ -124,12 +135,37 @@ namespace Directus
 			Read(&value);
 			return value;
 		}
+
+		// Moves forward without reading, compressed chunks which are skipped entirely aren't decompressed
+		void Skip(size_t size);
 		//==========================================================
 
 	private:
+		void WriteBytes(const void* data, size_t size);
+		void ReadBytes(void* data, size_t size);
+		bool ReadRaw(void* data, size_t size);
+		bool SkipRaw(size_t size);
+		void WriteChunk();
+		bool ReadChunk(size_t* skip = nullptr);
+		size_t ReadChunksParallel(std::byte* data, size_t size);
+
 		std::ofstream out;
 		std::ifstream in;
+		std::string m_path;
 		FileStreamMode m_mode;
 		bool m_isOpen;
+
+		// Compression
+		bool m_compressed;
+		std::vector<std::byte> m_chunk;
+		std::vector<std::byte> m_chunkCompressed;
+		std::vector<std::vector<std::byte>> m_chunksCompressed;
+		size_t m_chunkPos;
+		static Threading* m_threading;
+
+		// Reading from a mounted archive
+		const std::byte* m_memory;
+		size_t m_memorySize;
+		size_t m_memoryPos;
 	};
 }
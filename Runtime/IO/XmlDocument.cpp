@@ -257,7 +257,11 @@ namespace Directus
 	bool XmlDocument::Load(const string& filePath)
 	{
 		m_document = make_unique<xml_document>();
-		xml_parse_result result = m_document->load_file(filePath.c_str());
+
+		// Files in mounted archives are parsed straight from memory
+		const std::byte* data	= nullptr;
+		size_t size				= 0;
+		xml_parse_result result = FileSystem::GetMountedFile(filePath, &data, &size) ? m_document->load_buffer(data, size) : m_document->load_file(filePath.c_str());
 
 		if (result.status != status_ok)
 		{
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include "../Core/EngineDefs.h"
 //=============================
@@ -105,4 +106,77 @@ namespace Directus::Math::Helper
 
 		return angle;
 	}
+
+	// Half floats, rounds to nearest even and values past the half range become infinity
+	inline unsigned short FloatToHalf(float value)
+	{
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		unsigned int sign		= (bits >> 16) & 0x8000;
+		unsigned int mantissa	= bits & 0x7fffff;
+		int exponent			= int((bits >> 23) & 0xff) - 127 + 15;
+
+		if (((bits >> 23) & 0xff) == 0xff)
+			return (unsigned short)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+		if (exponent >= 31)
+			return (unsigned short)(sign | 0x7c00);
+
+		// Denormals
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return (unsigned short)sign;
+
+			mantissa				|= 0x800000;
+			unsigned int shift		= 14 - exponent;
+			unsigned int half		= mantissa >> shift;
+			unsigned int remainder	= mantissa & ((1u << shift) - 1);
+			unsigned int halfway	= 1u << (shift - 1);
+			half += (remainder > halfway || (remainder == halfway && (half & 1))) ? 1 : 0;
+			return (unsigned short)(sign | half);
+		}
+
+		// A carry out of the mantissa correctly bumps the exponent
+		unsigned int half		= sign | (exponent << 10) | (mantissa >> 13);
+		unsigned int remainder	= mantissa & 0x1fff;
+		half += (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) ? 1 : 0;
+		return (unsigned short)half;
+	}
+
+	inline float HalfToFloat(unsigned short value)
+	{
+		unsigned int sign		= (unsigned int)(value & 0x8000) << 16;
+		unsigned int exponent	= (value >> 10) & 0x1f;
+		unsigned int mantissa	= value & 0x3ff;
+		unsigned int bits;
+
+		if (exponent == 0x1f)
+		{
+			bits = sign | 0x7f800000 | (mantissa << 13);
+		}
+		else if (exponent != 0)
+		{
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		}
+		else if (mantissa != 0)
+		{
+			// Denormals become normal floats
+			exponent = 127 - 15 + 1;
+			while (!(mantissa & 0x400))
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+			bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+		}
+		else
+		{
+			bits = sign;
+		}
+
+		float result;
+		memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ namespace Directus
 		m_rhiDevice		= rhiDevice;
 		m_buffer		= nullptr;
 		m_memoryUsage	= 0;
+		m_indexCount	= 0;
+		m_stride		= sizeof(unsigned int);
 	}
 
 	RHI_IndexBuffer::~RHI_IndexBuffer()
@@ -45,6 +47,16 @@ namespace Directus
 	}
 
 	bool RHI_IndexBuffer::Create(const vector<unsigned int>& indices)
+	{
+		return Create(indices.data(), sizeof(unsigned int), (unsigned int)indices.size());
+	}
+
+	bool RHI_IndexBuffer::Create(const vector<unsigned short>& indices)
+	{
+		return Create(indices.data(), sizeof(unsigned short), (unsigned int)indices.size());
+	}
+
+	bool RHI_IndexBuffer::Create(const void* indices, unsigned int stride, unsigned int indexCount)
 	{
 		if (!m_rhiDevice || !m_rhiDevice->GetDevice<ID3D11Device>())
 		{
@@ -52,14 +64,15 @@ namespace Directus
 			return false;
 		}
 
-		if (indices.empty())
+		if (!indices || indexCount == 0)
 		{
 			LOG_ERROR("RHI_IndexBuffer::Create: Invalid parameter");
 			return false;
 		}
 
-		m_indexCount			= (unsigned int)indices.size();
-		unsigned int finalSize	= sizeof(unsigned int) * m_indexCount;
+		m_indexCount			= indexCount;
+		m_stride				= stride;
+		unsigned int finalSize	= m_stride * m_indexCount;
 
 		D3D11_BUFFER_DESC bufferDesc;
 		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
@@ -71,7 +84,7 @@ namespace Directus
 		bufferDesc.StructureByteStride	= 0;
 
 		D3D11_SUBRESOURCE_DATA initData;
-		initData.pSysMem = indices.data();
+		initData.pSysMem = indices;
 		initData.SysMemPitch = 0;
 		initData.SysMemSlicePitch = 0;
 
@@ -84,7 +97,7 @@ namespace Directus
 		}
 
 		// Compute memory usage
-		m_memoryUsage = unsigned int((sizeof(unsigned int) * indices.size()));
+		m_memoryUsage = finalSize;
 
 		return true;
 	}
@@ -97,7 +110,8 @@ namespace Directus
 			return false;
 		}
 
-		m_indexCount = sizeof(unsigned int) * indexCount;
+		m_stride		= sizeof(unsigned int);
+		m_indexCount	= sizeof(unsigned int) * indexCount;
 
 		D3D11_BUFFER_DESC bufferDesc;
 		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
@@ -177,7 +191,7 @@ namespace Directus
 			return nullptr;
 		}
 
-		m_rhiDevice->GetDeviceContext<ID3D11DeviceContext>()->IASetIndexBuffer((ID3D11Buffer*)m_buffer, DXGI_FORMAT_R32_UINT, 0);
+		m_rhiDevice->GetDeviceContext<ID3D11DeviceContext>()->IASetIndexBuffer((ID3D11Buffer*)m_buffer, m_stride == sizeof(unsigned short) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
 		return true;
 	}
 }
\ No newline at end of file
@@ -160,6 +160,50 @@ namespace Directus
 		}
 	}
 
+		inline void CreatePosTBNQuantizedDesc(ID3D10Blob* VSBlob, vector<any>* layout)
+		{
+			D3D11_INPUT_ELEMENT_DESC positionDesc;
+			positionDesc.SemanticName			= "POSITION";
+			positionDesc.SemanticIndex			= 0;
+			positionDesc.Format					= DXGI_FORMAT_R16G16B16A16_UNORM;
+			positionDesc.InputSlot				= 0;
+			positionDesc.AlignedByteOffset		= 0;
+			positionDesc.InputSlotClass			= D3D11_INPUT_PER_VERTEX_DATA;
+			positionDesc.InstanceDataStepRate	= 0;
+			layout->emplace_back(positionDesc);
+
+			D3D11_INPUT_ELEMENT_DESC texCoordDesc;
+			texCoordDesc.SemanticName			= "TEXCOORD";
+			texCoordDesc.SemanticIndex			= 0;
+			texCoordDesc.Format					= DXGI_FORMAT_R16G16_FLOAT;
+			texCoordDesc.InputSlot				= 0;
+			texCoordDesc.AlignedByteOffset		= D3D11_APPEND_ALIGNED_ELEMENT;
+			texCoordDesc.InputSlotClass			= D3D11_INPUT_PER_VERTEX_DATA;
+			texCoordDesc.InstanceDataStepRate	= 0;
+			layout->emplace_back(texCoordDesc);
+
+			D3D11_INPUT_ELEMENT_DESC normalDesc;
+			normalDesc.SemanticName				= "NORMAL";
+			normalDesc.SemanticIndex			= 0;
+			normalDesc.Format					= DXGI_FORMAT_R16G16_SNORM;
+			normalDesc.InputSlot				= 0;
+			normalDesc.AlignedByteOffset		= D3D11_APPEND_ALIGNED_ELEMENT;
+			normalDesc.InputSlotClass			= D3D11_INPUT_PER_VERTEX_DATA;
+			normalDesc.InstanceDataStepRate		= 0;
+			layout->emplace_back(normalDesc);
+
+			D3D11_INPUT_ELEMENT_DESC tangentDesc;
+			tangentDesc.SemanticName			= "TANGENT";
+			tangentDesc.SemanticIndex			= 0;
+			tangentDesc.Format					= DXGI_FORMAT_R16G16_SNORM;
+			tangentDesc.InputSlot				= 0;
+			tangentDesc.AlignedByteOffset		= D3D11_APPEND_ALIGNED_ELEMENT;
+			tangentDesc.InputSlotClass			= D3D11_INPUT_PER_VERTEX_DATA;
+			tangentDesc.InstanceDataStepRate	= 0;
+			layout->emplace_back(tangentDesc);
+		}
+	}
+
 	RHI_InputLayout::RHI_InputLayout(shared_ptr<RHI_Device> rhiDevice)
 	{
 		m_rhiDevice		= rhiDevice;
@@ -202,6 +246,11 @@ namespace Directus
 			D3D11_InputLayout::CreatePosTBNDesc((ID3D10Blob*)vsBlob, &m_layoutDesc);
 		}
 
+		if (m_inputLayout == Input_PositionTextureTBN_Quantized)
+		{
+			D3D11_InputLayout::CreatePosTBNQuantizedDesc((ID3D10Blob*)vsBlob, &m_layoutDesc);
+		}
+
 		std::vector<D3D11_INPUT_ELEMENT_DESC> layoutDesc;
 		for (const auto& desc : m_layoutDesc)
 		{
@@ -175,6 +175,7 @@ namespace Directus
 
 	RHI_Shader::~RHI_Shader()
 	{
+		Reload_Unregister();
 		SafeRelease((ID3D11VertexShader*)m_vertexShader);
 		SafeRelease((ID3D11PixelShader*)m_pixelShader);
 	}
@@ -74,7 +74,7 @@ namespace Directus
 				continue;
 			}
 
-			UINT rowBytes = mipWidth * channels * m_bpc;
+			UINT rowBytes = ComputeRowPitch(mipWidth, channels, format);
 
 			D3D11_SUBRESOURCE_DATA& subresourceData = vec_subresourceData.emplace_back(D3D11_SUBRESOURCE_DATA{});
 			subresourceData.pSysMem				= mipChain[i].data();	// Data pointer		
@@ -86,7 +86,7 @@ namespace Directus
 			mipHeight	= Max(mipHeight / 2, (unsigned int)1);
 
 			// Compute memory usage (rough estimation)
-			m_memoryUsage += (unsigned int)mipChain[i].size() * m_bpc;
+			m_memoryUsage += (unsigned int)mipChain[i].size();
 		}
 
 		// Describe shader resource view
@@ -134,7 +134,12 @@ namespace Directus
 
 		if (generateMipChain)
 		{
-			if (width < 4 || height < 4)
+			if (IsBlockCompressed(format))
+			{
+				LOG_WARNING("RHI_Texture::ShaderResource_Create2D: Mipchain can't be generated for a block compressed format");
+				generateMipChain = false;
+			}
+			else if (width < 4 || height < 4)
 			{
 				LOGF_WARNING("RHI_Texture::ShaderResource_Create2D: Mipchain won't be generated as dimension %dx%d is too small", width, height);
 				generateMipChain = false;
@@ -165,7 +170,7 @@ namespace Directus
 
 		D3D11_SUBRESOURCE_DATA subresourceData;
 		subresourceData.pSysMem				= data.data();					// Data pointer		
-		subresourceData.SysMemPitch			= width * channels * m_bpc;		// Line width in bytes
+		subresourceData.SysMemPitch			= ComputeRowPitch(width, channels, format);	// Line width in bytes
 		subresourceData.SysMemSlicePitch	= 0;							// This is only used for 3D textures
 
 		// Describe shader resource view
@@ -251,7 +256,7 @@ namespace Directus
 					continue;
 				}
 
-				UINT rowBytes = mipWidth * channels * m_bpc;
+				UINT rowBytes = ComputeRowPitch(mipWidth, channels, format);
 
 				// D3D11_SUBRESOURCE_DATA
 				D3D11_SUBRESOURCE_DATA& subresourceData = vec_subresourceData.emplace_back(D3D11_SUBRESOURCE_DATA{});
@@ -264,7 +269,7 @@ namespace Directus
 				mipHeight	= Max(mipHeight / 2, (unsigned int)1);
 
 				// Compute memory usage (rough estimation)
-				m_memoryUsage += (unsigned int)mip.size() * m_bpc;
+				m_memoryUsage += (unsigned int)mip.size();
 			}
 
 			vec_textureDesc.emplace_back(textureDesc);
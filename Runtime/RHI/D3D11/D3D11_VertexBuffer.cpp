@@ -181,6 +181,45 @@ namespace Directus
 		return true;
 	}
 
+	bool RHI_VertexBuffer::Create(const vector<RHI_Vertex_PosUVTBN_Quantized>& vertices)
+	{
+		if (!m_rhiDevice || !m_rhiDevice->GetDevice<ID3D11Device>() || vertices.empty())
+			return false;
+
+		m_stride = sizeof(RHI_Vertex_PosUVTBN_Quantized);
+		unsigned int size		= (unsigned int)vertices.size();
+		unsigned int byteWidth	= m_stride * size;
+
+		// fill in a buffer description.
+		D3D11_BUFFER_DESC bufferDesc;
+		ZeroMemory(&bufferDesc, sizeof(bufferDesc));
+		bufferDesc.ByteWidth			= byteWidth;
+		bufferDesc.Usage				= D3D11_USAGE_IMMUTABLE;
+		bufferDesc.BindFlags			= D3D11_BIND_VERTEX_BUFFER;
+		bufferDesc.CPUAccessFlags		= 0;
+		bufferDesc.MiscFlags			= 0;
+		bufferDesc.StructureByteStride	= 0;
+
+		// fill in the subresource data.
+		D3D11_SUBRESOURCE_DATA initData;
+		initData.pSysMem			= vertices.data();
+		initData.SysMemPitch		= 0;
+		initData.SysMemSlicePitch	= 0;
+
+		// Compute memory usage
+		m_memoryUsage = (unsigned int)(sizeof(RHI_Vertex_PosUVTBN_Quantized) * vertices.size());
+
+		auto ptr = (ID3D11Buffer**)&m_buffer;
+		auto result = m_rhiDevice->GetDevice<ID3D11Device>()->CreateBuffer(&bufferDesc, &initData, ptr);
+		if (FAILED(result))
+		{
+			LOG_ERROR("RHI_VertexBuffer::Create: Failed to create vertex buffer");
+			return false;
+		}
+
+		return true;
+	}
+
 	bool RHI_VertexBuffer::CreateDynamic(unsigned int stride, unsigned int initialSize)
 	{
 		if (!m_rhiDevice || !m_rhiDevice->GetDeviceContext<ID3D11Device>())
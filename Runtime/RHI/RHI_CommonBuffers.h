@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==========================
 #include "../Math/Matrix.h"
 #include "../Math/Vector2.h"
+#include "../Math/BoundingBox.h"
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
 #include "RHI_RenderTexture.h"
@@ -149,16 +150,21 @@ namespace Directus
 			const Math::Vector4& color,
 			const Math::Vector3& cameraPos,
 			const Math::Vector3& lightDir,
+			const Math::BoundingBox& bounds,
 			float roughness = 0.0f
 		)
 		{
-			m_world			= world;
-			m_wvp			= world * view * projection;
-			m_color			= color;
-			m_cameraPos		= cameraPos;
-			m_lightDir		= lightDir;
-			m_roughness		= roughness;
-			m_padding		= 0.0f;
+			m_world				= world;
+			m_wvp				= world * view * projection;
+			m_color				= color;
+			m_cameraPos			= cameraPos;
+			m_lightDir			= lightDir;
+			m_roughness			= roughness;
+			m_padding			= 0.0f;
+			m_positionOffset	= bounds.GetMin();
+			m_padding2			= 0.0f;
+			m_positionScale		= bounds.GetSize();
+			m_padding3			= 0.0f;
 		}
 
 		Math::Matrix m_world;
@@ -168,6 +174,10 @@ namespace Directus
 		float m_roughness;
 		Math::Vector3 m_lightDir;
 		float m_padding;
+		Math::Vector3 m_positionOffset;
+		float m_padding2;
+		Math::Vector3 m_positionScale;
+		float m_padding3;
 	};
 
 	struct Struct_ShadowMapping
@@ -40,6 +40,7 @@ namespace Directus
 	class RHI_Shader;
 	class RHI_InputLayout;
 	struct RHI_Vertex_PosUVTBN;
+	struct RHI_Vertex_PosUVTBN_Quantized;
 	struct RHI_Vertex_PosUVNor;
 	struct RHI_Vertex_PosUV;
 	struct RHI_Vertex_PosCol;
@@ -76,6 +77,7 @@ namespace Directus
 		Input_PositionColor,
 		Input_PositionTexture,
 		Input_PositionTextureTBN,
+		Input_PositionTextureTBN_Quantized,
 		Input_NotAssigned
 	};
 
@@ -137,6 +139,23 @@ namespace Directus
 		Texture_Format_R32G32B32_FLOAT,
 		Texture_Format_R16G16B16A16_FLOAT,
 		Texture_Format_R32G32B32A32_FLOAT,
-		Texture_Format_D32_FLOAT
+		Texture_Format_D32_FLOAT,
+		Texture_Format_BC1_UNORM,
+		Texture_Format_BC3_UNORM,
+		Texture_Format_BC4_UNORM,
+		Texture_Format_BC5_UNORM,
+		Texture_Format_BC7_UNORM,
+		Texture_Format_R8G8_UNORM
+	};
+
+	// How an imported texture is block compressed, depends on what the shaders read from it. Textures which can't be
+	// block compressed still only keep the channels that are read (R8/RG8, or half floats for HDR).
+	enum Texture_Compression
+	{
+		Texture_Compression_None,				// Stored as decoded
+		Texture_Compression_Color,				// BC1, or BC3 when the alpha isn't just on/off
+		Texture_Compression_ColorHighQuality,	// BC7
+		Texture_Compression_Red,				// BC4, only the red channel is kept
+		Texture_Compression_Normal				// BC5, only x and y are kept (z is reconstructed)
 	};
 }
\ No newline at end of file
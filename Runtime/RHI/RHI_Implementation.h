@@ -64,7 +64,13 @@ static const DXGI_FORMAT d3d11_dxgi_format[]
 	DXGI_FORMAT_R32G32B32_FLOAT,
 	DXGI_FORMAT_R16G16B16A16_FLOAT,
 	DXGI_FORMAT_R32G32B32A32_FLOAT,
-	DXGI_FORMAT_D32_FLOAT
+	DXGI_FORMAT_D32_FLOAT,
+	DXGI_FORMAT_BC1_UNORM,
+	DXGI_FORMAT_BC3_UNORM,
+	DXGI_FORMAT_BC4_UNORM,
+	DXGI_FORMAT_BC5_UNORM,
+	DXGI_FORMAT_BC7_UNORM,
+	DXGI_FORMAT_R8G8_UNORM
 };
 
 static const D3D11_TEXTURE_ADDRESS_MODE d3d11_texture_address_mode[]
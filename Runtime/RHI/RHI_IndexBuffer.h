@@ -36,6 +36,7 @@ namespace Directus
 		~RHI_IndexBuffer();
 	
 		bool Create(const std::vector<unsigned int>& indices);
+		bool Create(const std::vector<unsigned short>& indices);
 		bool CreateDynamic(unsigned int indexCount);
 		void* Map();
 		bool Unmap();
@@ -43,9 +44,15 @@ namespace Directus
 
 		unsigned int GetMemoryUsage()	{ return m_memoryUsage; }
 		unsigned int GetIndexCount()	{ return m_indexCount; }
+		unsigned int GetStride()		{ return m_stride; }
+
+	private:
+		// Both index sizes end up here, the stride tells them apart
+		bool Create(const void* indices, unsigned int stride, unsigned int indexCount);
 
 	protected:
 		unsigned int m_indexCount;
+		unsigned int m_stride;
 		unsigned int m_memoryUsage;
 		std::shared_ptr<RHI_Device> m_rhiDevice;
 
@@ -33,6 +33,9 @@ namespace Directus
 	public:
 		RHI_Object() { m_ID = GENERATE_GUID; }
 		unsigned int RHI_GetID() const { return m_ID; }
+	protected:
+		// Anything which caches the object by ID will treat it as a new one
+		void RHI_RenewID() { m_ID = GENERATE_GUID; }
 	private:
 		unsigned int m_ID = 0;
 	};
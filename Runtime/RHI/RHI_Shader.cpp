@@ -23,6 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RHI_Shader.h"
 #include "RHI_ConstantBuffer.h"
 #include "..\Logging\Log.h"
+#include <set>
+#include <mutex>
+#include <atomic>
 //=============================
 
 //= NAMESPACES =====
@@ -31,6 +34,14 @@ using namespace std;
 
 namespace Directus
 {
+	namespace _RHI_Shader
+	{
+		// Shaders which have been compiled, locked while reloading so none of them can be destroyed mid-compile.
+		// Recursive, as compiling a shader registers it and the thread that reloads runs other tasks while it waits.
+		static recursive_mutex registryMutex;
+		static set<RHI_Shader*> registry;
+	}
+
 	void RHI_Shader::AddDefine(const std::string& define, const std::string& value /*= "1"*/)
 	{
 		m_macros[define] = value;
@@ -55,4 +66,92 @@ namespace Directus
 		m_constantBuffer = make_shared<RHI_ConstantBuffer>(m_rhiDevice);
 		m_constantBuffer->Create(size);
 	}
+
+	void RHI_Shader::Reload_CompileAll(Context* context)
+	{
+		lock_guard<recursive_mutex> guard(_RHI_Shader::registryMutex);
+
+		// The registry stays locked while waiting, which is fine as only the compile tasks run on this thread
+		auto threading = context->GetSubsystem<Threading>();
+		TaskGroup group;
+		for (const auto& shader : _RHI_Shader::registry)
+		{
+			threading->AddTask([shader]() { shader->Reload_Compile(); }, &group);
+		}
+
+		threading->Wait(&group);
+	}
+
+	void RHI_Shader::Reload_ApplyAll()
+	{
+		lock_guard<recursive_mutex> guard(_RHI_Shader::registryMutex);
+
+		for (const auto& shader : _RHI_Shader::registry)
+		{
+			shader->Reload_Apply();
+		}
+	}
+
+	void RHI_Shader::Reload_Register(bool vertex, bool pixel, Input_Layout inputLayout)
+	{
+		lock_guard<recursive_mutex> guard(_RHI_Shader::registryMutex);
+
+		m_reloadVertex		|= vertex;
+		m_reloadPixel		|= pixel;
+		m_reloadInputLayout	= vertex ? inputLayout : m_reloadInputLayout;
+		m_reloadRegistered	= true;
+		_RHI_Shader::registry.insert(this);
+	}
+
+	void RHI_Shader::Reload_Unregister()
+	{
+		// Staging shaders are never registered
+		if (!m_reloadRegistered)
+			return;
+
+		lock_guard<recursive_mutex> guard(_RHI_Shader::registryMutex);
+		_RHI_Shader::registry.erase(this);
+	}
+
+	void RHI_Shader::Reload_Compile()
+	{
+		if (m_filePath.empty())
+			return;
+
+		// Compile into a staging shader, bypassing the compile functions so it doesn't register itself
+		auto staging		= make_shared<RHI_Shader>(m_rhiDevice);
+		staging->m_macros	= m_macros;
+		staging->m_filePath	= m_filePath;
+		bool vertex			= !m_reloadVertex	|| staging->API_CompileVertex(m_filePath, m_reloadInputLayout);
+		bool pixel			= !m_reloadPixel	|| staging->API_CompilePixel(m_filePath);
+
+		if (vertex && pixel)
+		{
+			m_reloadStaging = staging;
+		}
+		else
+		{
+			LOGF_ERROR("RHI_Shader::Reload: Failed to compile %s, the previous version will be kept", m_filePath.c_str());
+		}
+	}
+
+	void RHI_Shader::Reload_Apply()
+	{
+		if (!m_reloadStaging)
+			return;
+
+		// The input layout is kept, editing a shader doesn't change the vertex format it's used with.
+		// The previous shaders are released along with the staging shader.
+		swap(m_vertexShader, m_reloadStaging->m_vertexShader);
+		swap(m_pixelShader, m_reloadStaging->m_pixelShader);
+		m_hasVertexShader	= m_reloadStaging->m_hasVertexShader;
+		m_hasPixelShader	= m_reloadStaging->m_hasPixelShader;
+		m_shaderState		= Shader_Built;
+		m_reloadStaging		= nullptr;
+
+		// So pipelines which have the previous shader bound, bind the new one
+		RHI_RenewID();
+
+		LOGF_INFO("RHI_Shader::Reload: Reloaded %s", m_filePath.c_str());
+	}
 }
\ No newline at end of file
@@ -70,6 +70,7 @@ namespace Directus
 
 		virtual void CompileVertex(const std::string& filePath, Input_Layout inputLayout)
 		{
+			Reload_Register(true, false, inputLayout);
 			m_shaderState	= Shader_Compiling;
 			bool vertex		= API_CompileVertex(filePath, inputLayout);
 
@@ -87,6 +88,7 @@ namespace Directus
 
 		virtual void CompilePixel(const std::string& filePath)
 		{
+			Reload_Register(false, true, Input_NotAssigned);
 			m_shaderState	= Shader_Compiling;
 			bool pixel		= API_CompilePixel(filePath);
 
@@ -105,6 +107,7 @@ namespace Directus
 
 		virtual void CompileVertexPixel(const std::string& filePath, Input_Layout inputLayout)
 		{
+			Reload_Register(true, true, inputLayout);
 			m_shaderState	= Shader_Compiling;
 			bool vertex		= API_CompileVertex(filePath, inputLayout);
 			bool pixel		= API_CompilePixel(filePath);
@@ -138,6 +141,15 @@ namespace Directus
 		bool HasPixelShader()										{ return m_hasPixelShader; }
 		std::shared_ptr<RHI_InputLayout> GetInputLayout()			{ return m_inputLayout; }
 		Shader_State GetState()										{ return m_shaderState; }
+		const std::string& GetFilePath()							{ return m_filePath; }
+
+		//= HOT RELOAD ===========================================================================================
+		// Recompiles every compiled shader from its source file, in parallel, and returns once they are done.
+		// The results are staged, the shaders in use are left untouched.
+		static void Reload_CompileAll(Context* context);
+		// Swaps the staged shaders in, call between frames. Shaders which failed to compile keep their old code.
+		static void Reload_ApplyAll();
+		//========================================================================================================
 
 	protected:
 		std::shared_ptr<RHI_Device> m_rhiDevice;
@@ -148,6 +160,10 @@ namespace Directus
 		virtual bool API_CompilePixel(const std::string& filePath);
 		//====================================================================================
 		void CreateConstantBuffer(unsigned int size);
+		void Reload_Register(bool vertex, bool pixel, Input_Layout inputLayout);
+		void Reload_Unregister();
+		void Reload_Compile();
+		void Reload_Apply();
 
 		unsigned int m_bufferSize;	
 		std::shared_ptr<RHI_ConstantBuffer> m_constantBuffer;	
@@ -161,6 +177,13 @@ namespace Directus
 		bool m_hasPixelShader		= false;
 		Shader_State m_shaderState	= Shader_Uninitialized;
 
+		// Hot reload
+		bool m_reloadRegistered				= false;
+		bool m_reloadVertex					= false;
+		bool m_reloadPixel					= false;
+		Input_Layout m_reloadInputLayout	= Input_NotAssigned;
+		std::shared_ptr<RHI_Shader> m_reloadStaging;
+
 		// D3D11
 		void* m_vertexShader	= nullptr;
 		void* m_pixelShader		= nullptr;
@@ -25,6 +25,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../IO/FileStream.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceManager.h"
+#include "../Core/Hash.h"
+#include "../Threading/Threading.h"
+#include <atomic>
 //======================================
 
 //= NAMESPACES =====
@@ -33,6 +36,57 @@ using namespace std;
 
 namespace Directus
 {
+	namespace _RHI_Texture
+	{
+		static const unsigned int binaryMagic	= 0x58455444; // "DTEX"
+		static const unsigned int binaryVersion	= 4; // 2: dimensions, streaming and mip offsets in the header, 3: cubemaps, 4: source file path
+		// Streamed textures keep the mips up to this size resident
+		static const unsigned int streamingTailSize	= 64;
+		static const unsigned int cubemapFaces		= 6;
+
+		struct Header
+		{
+			unsigned int version	= 0;
+			Texture_Format format	= Texture_Format_R8G8B8A8_UNORM;
+			unsigned int bpc		= 1;
+			unsigned int width		= 0;
+			unsigned int height		= 0;
+			bool isStreamed			= false;
+			bool isCubemap			= false;
+			vector<unsigned int> mipOffsets; // From the first mip, the last one is where the mips end (of all the faces)
+		};
+
+		// Reads everything that precedes the texture bits and returns the mip count. Textures
+		// saved before the header existed start with the mip count and are always RGBA8.
+		static unsigned int ReadHeader(FileStream* file, Header* header)
+		{
+			auto magic = file->ReadUInt();
+			if (magic != binaryMagic)
+				return magic;
+
+			auto version = file->ReadUInt();
+			if (version == 0 || version > binaryVersion)
+				return 0;
+
+			header->version	= version;
+
+			header->format	= (Texture_Format)file->ReadUInt();
+			header->bpc		= file->ReadUInt();
+			if (version == 1)
+				return file->ReadUInt();
+
+			file->Read(&header->width);
+			file->Read(&header->height);
+			file->Read(&header->isStreamed);
+			if (version >= 3)
+			{
+				file->Read(&header->isCubemap);
+			}
+			file->Read(&header->mipOffsets);
+			return header->mipOffsets.empty() ? 0 : (unsigned int)header->mipOffsets.size() - 1;
+		}
+	}
+
 	RHI_Texture::RHI_Texture(Context* context) : IResource(context, Resource_Texture)
 	{
 		m_format	= Texture_Format_R8G8B8A8_UNORM;
@@ -46,6 +100,14 @@ namespace Directus
 	}
 
 	bool RHI_Texture::LoadFromFile(const string& rawFilePath)
+	{
+		if (!LoadAsync_Read(rawFilePath))
+			return false;
+
+		return LoadAsync_Finalize();
+	}
+
+	bool RHI_Texture::LoadAsync_Read(const string& rawFilePath)
 	{
 		if (!FileSystem::FileExists(rawFilePath))
 		{
@@ -55,6 +117,8 @@ namespace Directus
 
 		m_mipChain.clear();
 		m_mipChain.shrink_to_fit();
+		m_isEvicted		= false;
+		m_residentMip	= 0;
 		SetLoadState(LoadState_Started);
 
 		// Make the path, relative to the engine
@@ -64,9 +128,10 @@ namespace Directus
 		bool loaded = false;
 		{
 			// engine format (binary)
-			if (FileSystem::IsEngineTextureFile(filePath))
+			m_isEngineFormat = FileSystem::IsEngineTextureFile(filePath);
+			if (m_isEngineFormat)
 			{
-				loaded = Deserialize(filePath);
+				loaded = Deserialize(filePath, true);
 			}
 			// foreign format (most known image formats)
 			else if (FileSystem::IsSupportedImageFile(filePath))
@@ -90,52 +155,297 @@ namespace Directus
 			return false;
 		}
 
+		return true;
+	}
+
+	bool RHI_Texture::LoadAsync_Finalize()
+	{
+		if (m_mipChain.empty())
+			return false;
+
 		// Create shader resource
 		bool shaderResourceCreated = false;
 		{
-			if (HasMipChain())
+			// Streamed textures start at their mip tail
+			unsigned int width	= GetMipWidth(m_residentMip);
+			unsigned int height	= GetMipHeight(m_residentMip);
+			if (m_isCubemap)
 			{
-				shaderResourceCreated = ShaderResource_Create2D(m_width, m_height, m_channels, m_format, m_mipChain);
+				// The faces are handed to the RHI and back, the mip chain only moves
+				unsigned int mipCount = (unsigned int)m_mipChain.size() / _RHI_Texture::cubemapFaces;
+				vector<vector<MipLevel>> faces(_RHI_Texture::cubemapFaces);
+				for (unsigned int i = 0; i < mipCount * _RHI_Texture::cubemapFaces; i++)
+				{
+					faces[i / mipCount].emplace_back(move(m_mipChain[i]));
+				}
+
+				shaderResourceCreated = mipCount != 0 && ShaderResource_CreateCubemap(width, height, m_channels, m_format, faces);
+
+				m_mipChain.clear();
+				for (auto& face : faces)
+				{
+					for (auto& mip : face)
+					{
+						m_mipChain.emplace_back(move(mip));
+					}
+				}
+			}
+			else if (HasMipChain())
+			{
+				shaderResourceCreated = ShaderResource_Create2D(width, height, m_channels, m_format, m_mipChain);
 			}
 			else
 			{
-				shaderResourceCreated = ShaderResource_Create2D(m_width, m_height, m_channels, m_format, m_mipChain.front(), m_needsMipChain);
+				// The GPU can't render to block compressed formats, so it can't generate their mips either
+				shaderResourceCreated = ShaderResource_Create2D(width, height, m_channels, m_format, m_mipChain.front(), m_needsMipChain && !IsBlockCompressed(m_format) && m_residentMip == 0);
 			}
 		}
 
-		if (shaderResourceCreated)
+		if (!shaderResourceCreated)
 		{
-			// If the texture was loaded from a foreign format, it hasn't been serialized yet (engine format), hence we have to maintain it's texture bits.
-			// However, if the texture was deserialized (engine format), then we no longer need the texture bits. We can free them here and free some memory.
-			if (FileSystem::IsEngineTextureFile(filePath))
-			{
-				ClearTextureBytes();
-			}
+			LOGF_ERROR("RHI_Texture::LoadAsync_Finalize: Failed to create shader resource for \"%s\".", m_resourceFilePath.c_str());
+			SetLoadState(LoadState_Failed);
+			return false;
 		}
-		else
+
+		// If the texture was loaded from a foreign format, it hasn't been serialized yet (engine format), hence we have to maintain it's texture bits.
+		// However, if the texture was deserialized (engine format), then we no longer need the texture bits. We can free them here and free some memory.
+		if (m_isEngineFormat)
 		{
-			LOGF_ERROR("RHI_Texture::LoadFromFile: Failed to create shader resource for \"%s\".", m_resourceFilePath.c_str());
+			ClearTextureBytes();
+			m_isEvicted = true;
 		}
 
 		SetLoadState(LoadState_Completed);
 		return true;
 	}
 
-	unsigned int RHI_Texture::GetMemoryUsage()
+	unsigned long long RHI_Texture::GetMemoryUsage()
 	{
 		// Compute texture bits (in case they are loaded)
-		unsigned int size = 0;
+		unsigned long long size = 0;
+		for (const auto& mip : m_mipChain)
+		{
+			size += mip.size();
+		}
+
+		return size;
+	}
+
+	unsigned long long RHI_Texture::ComputeContentHash()
+	{
+		// Only hash texture bits which are already in memory, reloading them would defeat the purpose
+		if (m_mipChain.empty())
+			return 0;
+
+		unsigned long long hash = Hash::Compute(m_resourceName);
+		hash = Hash::Combine(hash, Hash::Compute(m_resourceFilePath));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_bpp));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_width));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_height));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_channels));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_isGrayscale));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_isTransparent));
+		for (const auto& mip : m_mipChain)
+		{
+			hash = Hash::Combine(hash, Hash::Compute(mip.data(), mip.size()));
+		}
+
+		return hash;
+	}
+
+	unsigned long long RHI_Texture::ComputePixelHash()
+	{
+		if (m_mipChain.empty())
+			return 0;
+
+		unsigned long long hash = Hash::ComputeValue(m_bpp);
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_width));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_height));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_channels));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_format));
 		for (const auto& mip : m_mipChain)
 		{
-			size += (unsigned int)mip.size();
+			hash = Hash::Combine(hash, Hash::Compute(mip.data(), mip.size()));
 		}
 
+		return hash;
+	}
+
+	void RHI_Texture::Reload_Swap(RHI_Texture* texture)
+	{
+		if (!texture)
+			return;
+
+		// The data is replaced, it can't be evicted meanwhile
+		lock_guard<recursive_mutex> evictionGuard(m_evictionMutex);
+		swap(m_mipChain,		texture->m_mipChain);
+		swap(m_shaderResource,	texture->m_shaderResource);
+		swap(m_memoryUsage,		texture->m_memoryUsage);
+		swap(m_bpp,				texture->m_bpp);
+		swap(m_bpc,				texture->m_bpc);
+		swap(m_width,			texture->m_width);
+		swap(m_height,			texture->m_height);
+		swap(m_channels,		texture->m_channels);
+		swap(m_isGrayscale,		texture->m_isGrayscale);
+		swap(m_isTransparent,	texture->m_isTransparent);
+		swap(m_format,			texture->m_format);
+		swap(m_isCubemap,		texture->m_isCubemap);
+		swap(m_isEngineFormat,	texture->m_isEngineFormat);
+		m_isEvicted = texture->m_isEvicted.exchange(m_isEvicted);
+		swap(m_isStreamed,		texture->m_isStreamed);
+		swap(m_residentMip,		texture->m_residentMip);
+
+		// A streaming load of the previous data is no longer wanted
+		lock_guard<mutex> guard(m_streamingMutex);
+		swap(m_mipOffsets,		texture->m_mipOffsets);
+		m_streamingStaging = nullptr;
+
+		// Reloaded from a foreign format, it has yet to be saved in the engine format
+		m_isDirty = texture->m_isDirty;
+	}
+
+	unsigned int RHI_Texture::ComputeRowPitch(unsigned int width, unsigned int channels, Texture_Format format)
+	{
+		switch (format)
+		{
+			case Texture_Format_BC1_UNORM:
+			case Texture_Format_BC4_UNORM:
+				return ((width + 3) / 4) * 8;
+			case Texture_Format_BC3_UNORM:
+			case Texture_Format_BC5_UNORM:
+			case Texture_Format_BC7_UNORM:
+				return ((width + 3) / 4) * 16;
+			default:
+				return width * channels * m_bpc;
+		}
+	}
+
+	unsigned int RHI_Texture::Streaming_GetMipCount()
+	{
+		lock_guard<mutex> guard(m_streamingMutex);
+		return m_mipOffsets.empty() ? 0 : (unsigned int)m_mipOffsets.size() - 1;
+	}
+
+	unsigned int RHI_Texture::Streaming_GetTailMip()
+	{
+		unsigned int mipCount = Streaming_GetMipCount();
+		for (unsigned int mip = 0; mip < mipCount; mip++)
+		{
+			bool small = GetMipWidth(mip) <= _RHI_Texture::streamingTailSize && GetMipHeight(mip) <= _RHI_Texture::streamingTailSize;
+			if (small && Streaming_IsValidTopMip(mip))
+				return mip;
+		}
+
+		return 0;
+	}
+
+	bool RHI_Texture::Streaming_IsValidTopMip(unsigned int mip)
+	{
+		return mip == 0 || !IsBlockCompressed(m_format) || (GetMipWidth(mip) % 4 == 0 && GetMipHeight(mip) % 4 == 0);
+	}
+
+	unsigned long long RHI_Texture::Streaming_GetBytes(unsigned int mip)
+	{
+		lock_guard<mutex> guard(m_streamingMutex);
+		unsigned int mipCount = m_mipOffsets.empty() ? 0 : (unsigned int)m_mipOffsets.size() - 1;
+		if (mip >= mipCount)
+			return 0;
+
+		// The offsets include the size which precedes every mip
+		return (unsigned long long)(m_mipOffsets.back() - m_mipOffsets[mip]) - sizeof(unsigned int) * (mipCount - mip);
+	}
+
+	bool RHI_Texture::Streaming_Load(unsigned int mip)
+	{
+		vector<unsigned int> mipOffsets;
+		{
+			lock_guard<mutex> guard(m_streamingMutex);
+			mipOffsets = m_mipOffsets;
+		}
+
+		unsigned int mipCount = mipOffsets.empty() ? 0 : (unsigned int)mipOffsets.size() - 1;
+		if (mip >= mipCount)
+			return false;
+
+		auto file = make_unique<FileStream>(m_resourceFilePath, FileStreamMode_Read);
+		if (!file->IsOpen())
+			return false;
+
+		// The file could have been replaced since it was loaded
+		_RHI_Texture::Header header;
+		if (_RHI_Texture::ReadHeader(file.get(), &header) != mipCount || header.mipOffsets != mipOffsets)
+		{
+			LOGF_WARNING("RHI_Texture::Streaming_Load: \"%s\" has changed, can't stream it", m_resourceFilePath.c_str());
+			return false;
+		}
+
+		file->Skip(header.mipOffsets[mip]);
+		vector<MipLevel> mips(mipCount - mip);
+		for (auto& level : mips)
+		{
+			file->Read(&level);
+		}
+
+		// The shader resource is created here, but it's swapped in by Streaming_Apply()
+		auto staging	= make_shared<RHI_Texture>(m_context);
+		staging->m_bpc	= header.bpc;
+		if (!staging->ShaderResource_Create2D(GetMipWidth(mip), GetMipHeight(mip), m_channels, header.format, mips))
+			return false;
+
+		lock_guard<mutex> guard(m_streamingMutex);
+		m_streamingStaging		= staging;
+		m_streamingStagingMip	= mip;
+		return true;
+	}
+
+	void RHI_Texture::Streaming_Apply()
+	{
+		lock_guard<mutex> guard(m_streamingMutex);
+		if (!m_streamingStaging)
+			return;
+
+		// The previous shader resource is released along with the staging texture
+		swap(m_shaderResource, m_streamingStaging->m_shaderResource);
+		m_residentMip		= m_streamingStagingMip;
+		m_streamingStaging	= nullptr;
+	}
+
+	unsigned long long RHI_Texture::Evict()
+	{
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+
+		// Only texture bits which are in sync with an engine format file can be reloaded
+		if (m_isDirty || m_mipChain.empty() || !FileSystem::IsEngineTextureFile(m_resourceFilePath) || !FileSystem::FileExists(m_resourceFilePath))
+			return 0;
+
+		auto size = GetMemoryUsage();
+		ClearTextureBytes();
+		m_isEvicted = true;
+
 		return size;
 	}
 	//=====================================================================================
 
-	MipLevel* RHI_Texture::Data_GetMipLevel(unsigned int index)
+	const vector<MipLevel>& RHI_Texture::Data_Get()
 	{
+		Touch();
+		if (m_isEvicted)
+		{
+			lock_guard<recursive_mutex> guard(m_evictionMutex);
+			if (m_isEvicted)
+			{
+				GetTextureBytes(&m_mipChain);
+				m_isEvicted = false;
+			}
+		}
+
+		return m_mipChain;
+	}
+
+	const MipLevel* RHI_Texture::Data_GetMipLevel(unsigned int index)
+	{
+		Data_Get();
 		if (index >= m_mipChain.size())
 		{
 			LOG_WARNING("RHI_Texture::Data_GetMip: Index out of range");
@@ -158,9 +468,15 @@ namespace Directus
 
 	void RHI_Texture::GetTextureBytes(vector<vector<std::byte>>* textureBytes)
 	{
+		if (!textureBytes)
+			return;
+
 		if (!m_mipChain.empty())
 		{
-			textureBytes = &m_mipChain;
+			if (textureBytes != &m_mipChain)
+			{
+				*textureBytes = m_mipChain;
+			}
 			return;
 		}
 
@@ -168,41 +484,191 @@ namespace Directus
 		if (!file->IsOpen())
 			return;
 
-		unsigned int mipCount = file->ReadUInt();
-		for (unsigned int i = 0; i < mipCount; i++)
+		_RHI_Texture::Header header;
+		textureBytes->resize(_RHI_Texture::ReadHeader(file.get(), &header));
+		for (auto& mip : *textureBytes)
 		{
-			textureBytes->emplace_back(vector<std::byte>());
-			file->Read(&m_mipChain[i]);
+			file->Read(&mip);
 		}
 	}
 
 	bool RHI_Texture::LoadFromForeignFormat(const string& filePath)
 	{
+		auto resourceMng			= m_context->GetSubsystem<ResourceManager>();
+		ImageImporter* imageImp		= resourceMng->GetImageImporter();
+		DerivedDataCache* ddc		= resourceMng->GetDerivedDataCache();
+		unsigned long long key		= ddc->ComputeKey(filePath, imageImp->GetSettingsHash(this));
+		string derivedFilePath		= ddc->GetEntryDirectory(key) + "Texture" + EXTENSION_TEXTURE;
+
+		// Use the data derived by a previous import of the same image, if any (keep our own ID though)
+		bool cached = ddc->Contains(key) && Deserialize(derivedFilePath, false, true);
+
 		// Load texture
-		ImageImporter* imageImp = m_context->GetSubsystem<ResourceManager>()->GetImageImporter();	
-		if (!imageImp->Load(filePath, this))
+		if (!cached && !imageImp->Load(filePath, this))
 			return false;
 
-		// Change texture extension to an engine texture
+		// Change texture extension to an engine texture, the image stays on record for hot reloading
+		m_sourceFilePath = filePath;
 		SetResourceFilePath(FileSystem::GetFilePathWithoutExtension(filePath) + EXTENSION_TEXTURE);
 		SetResourceName(FileSystem::GetFileNameNoExtensionFromFilePath(GetResourceFilePath()));
 
+		if (cached)
+		{
+			// It hasn't been saved at its own file path yet
+			m_isDirty = true;
+		}
+		else if (key != 0)
+		{
+			ddc->Entry_Begin(key);
+			if (Serialize(derivedFilePath))
+			{
+				ddc->Entry_Commit(key);
+			}
+		}
+
+		return true;
+	}
+
+	bool RHI_Texture::LoadFromFiles_Cubemap(const vector<string>& facePaths)
+	{
+		if (facePaths.size() != _RHI_Texture::cubemapFaces)
+		{
+			LOGF_ERROR("RHI_Texture::LoadFromFiles_Cubemap: A cubemap needs %d faces, %d were provided", _RHI_Texture::cubemapFaces, (int)facePaths.size());
+			return false;
+		}
+
+		auto resourceMng			= m_context->GetSubsystem<ResourceManager>();
+		ImageImporter* imageImp		= resourceMng->GetImageImporter();
+		DerivedDataCache* ddc		= resourceMng->GetDerivedDataCache();
+
+		// One entry for all the faces, any face that changes invalidates it
+		unsigned long long key = Hash::ComputeValue(_RHI_Texture::cubemapFaces);
+		for (const auto& facePath : facePaths)
+		{
+			unsigned long long faceKey = ddc->ComputeKey(facePath, imageImp->GetSettingsHash(this));
+			key = faceKey != 0 ? Hash::Combine(key, faceKey) : 0;
+			if (key == 0)
+				break;
+		}
+
+		// The cubemap lives next to its faces, the cache only mirrors it (so clearing the cache doesn't lose it)
+		string filePath			= FileSystem::GetDirectoryFromFilePath(facePaths.front()) + "Cubemap" + EXTENSION_TEXTURE;
+		string derivedFilePath	= ddc->GetEntryDirectory(key) + "Cubemap" + EXTENSION_TEXTURE;
+
+		// The file next to the faces could be from other faces. It's replaced before it's read, as the
+		// texture bits are freed once they are on the GPU and read back from it when needed.
+		SetLoadState(LoadState_Started);
+		m_isEngineFormat	= ddc->Contains(key) && DerivedDataCache::Entry_CopyFile(derivedFilePath, filePath) && Deserialize(filePath, false, true);
+		m_residentMip		= 0;
+		if (m_isEngineFormat)
+		{
+			SetResourceFilePath(filePath);
+			return LoadAsync_Finalize();
+		}
+
+		// Decode the faces (and generate their mips) in parallel
+		vector<shared_ptr<RHI_Texture>> faces;
+		vector<char> decoded(_RHI_Texture::cubemapFaces, 0);
+		TaskGroup group;
+		auto threading = m_context->GetSubsystem<Threading>();
+		for (unsigned int i = 0; i < _RHI_Texture::cubemapFaces; i++)
+		{
+			auto face = faces.emplace_back(make_shared<RHI_Texture>(m_context));
+			face->SetNeedsMipChain(m_needsMipChain);
+			face->SetSRGB(m_isSRGB);
+			threading->AddTask([imageImp, face, &facePaths, &decoded, i]()
+			{
+				decoded[i] = imageImp->Load(facePaths[i], face.get()) ? 1 : 0;
+			}, &group);
+		}
+		threading->Wait(&group);
+
+		// The faces of a cubemap can't differ in size or format
+		m_mipChain.clear();
+		for (unsigned int i = 0; i < _RHI_Texture::cubemapFaces; i++)
+		{
+			const auto& face	= faces[i];
+			const auto& first	= faces.front();
+			bool matches		= face->m_width == first->m_width && face->m_height == first->m_height && face->m_format == first->m_format && face->m_mipChain.size() == first->m_mipChain.size();
+			if (!decoded[i] || !matches || face->m_mipChain.empty())
+			{
+				LOGF_ERROR("RHI_Texture::LoadFromFiles_Cubemap: Failed to load \"%s\" as a face of the cubemap", facePaths[i].c_str());
+				m_mipChain.clear();
+				SetLoadState(LoadState_Failed);
+				return false;
+			}
+
+			for (auto& mip : face->m_mipChain)
+			{
+				m_mipChain.emplace_back(move(mip));
+			}
+		}
+
+		auto& first			= faces.front();
+		m_bpp				= first->m_bpp;
+		m_bpc				= first->m_bpc;
+		m_width				= first->m_width;
+		m_height			= first->m_height;
+		m_channels			= first->m_channels;
+		m_format			= first->m_format;
+		m_isGrayscale		= false;
+		m_isTransparent		= false;
+		m_isStreamed		= false;
+		m_isCubemap			= true;
+		m_isEvicted			= false;
+		SetResourceFilePath(filePath);
+
+		if (!LoadAsync_Finalize())
+			return false;
+
+		if (key != 0)
+		{
+			ddc->Entry_Begin(key);
+			if (Serialize(derivedFilePath))
+			{
+				ddc->Entry_Commit(key);
+			}
+		}
+
+		// Saving it at its own path also frees the texture bits
+		Serialize(filePath);
+
 		return true;
 	}
 
 	bool RHI_Texture::Serialize(const string& filePath)
 	{
+		// The bits are reloaded (and possibly freed again) below
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+
 		// If the texture bits has been cleared, load it again
 		// as we don't want to replaced existing data with nothing.
 		// If the texture bits are not cleared, no loading will take place.
 		GetTextureBytes(&m_mipChain);
 
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, true);
 		if (!file->IsOpen())
 			return false;
 
+		// Offsets of the mips, so streaming can read a mip without reading the ones before it
+		vector<unsigned int> mipOffsets(1, 0);
+		for (const auto& mip : m_mipChain)
+		{
+			mipOffsets.emplace_back(mipOffsets.back() + (unsigned int)(sizeof(unsigned int) + mip.size()));
+		}
+
+		// Write header
+		file->Write(_RHI_Texture::binaryMagic);
+		file->Write(_RHI_Texture::binaryVersion);
+		file->Write((unsigned int)m_format);
+		file->Write(m_bpc);
+		file->Write(m_width);
+		file->Write(m_height);
+		file->Write(m_isStreamed);
+		file->Write(m_isCubemap);
+		file->Write(mipOffsets);
+
 		// Write texture bits
-		file->Write((unsigned int)m_mipChain.size());
 		for (auto& mip : m_mipChain)
 		{
 			file->Write(mip);
@@ -218,21 +684,56 @@ namespace Directus
 		file->Write(m_resourceID);
 		file->Write(m_resourceName);
 		file->Write(m_resourceFilePath);
+		file->Write(m_sourceFilePath);
 
-		ClearTextureBytes();
+		// The texture bits can be reloaded from the file (if it's the texture's own file)
+		if (filePath == m_resourceFilePath)
+		{
+			{
+				lock_guard<mutex> guard(m_streamingMutex);
+				m_mipOffsets = mipOffsets;
+			}
+			ClearTextureBytes();
+			m_isEvicted	= true;
+			m_isDirty	= false;
+		}
 
 		return true;
 	}
 
-	bool RHI_Texture::Deserialize(const string& filePath)
+	bool RHI_Texture::Deserialize(const string& filePath, bool allowStreaming /*= false*/, bool keepID /*= false*/)
 	{
 		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
 		if (!file->IsOpen())
 			return false;
 
+		_RHI_Texture::Header header;
+		unsigned int mipCount	= _RHI_Texture::ReadHeader(file.get(), &header);
+		m_format				= header.format;
+		m_bpc					= header.bpc;
+		m_width					= header.width;
+		m_height				= header.height;
+		m_isCubemap				= header.isCubemap;
+
+		// Streamed textures start with their mip tail (the streaming state only belongs to the texture's own file)
+		m_residentMip = 0;
+		if (allowStreaming)
+		{
+			m_isStreamed = header.isStreamed;
+			lock_guard<mutex> guard(m_streamingMutex);
+			m_mipOffsets = header.mipOffsets;
+		}
+
+		if (allowStreaming && m_isStreamed)
+		{
+			m_residentMip = Streaming_GetTailMip();
+			file->Skip(header.mipOffsets[m_residentMip]);
+		}
+
 		// Read texture bits
 		ClearTextureBytes();
-		m_mipChain.resize(file->ReadUInt());
+		m_isEvicted = false;
+		m_mipChain.resize(mipCount - m_residentMip);
 		for (auto& mip : m_mipChain)
 		{
 			file->Read(&mip);
@@ -245,9 +746,22 @@ namespace Directus
 		file->Read(&m_channels);
 		file->Read(&m_isGrayscale);
 		file->Read(&m_isTransparent);
-		file->Read(&m_resourceID);
+
+		unsigned int id = file->ReadUInt();
+		if (!keepID)
+		{
+			m_resourceID = id;
+		}
+
 		file->Read(&m_resourceName);
 		file->Read(&m_resourceFilePath);
+		if (header.version >= 4)
+		{
+			file->Read(&m_sourceFilePath);
+		}
+
+		// In sync with the file
+		m_isDirty = false;
 
 		return true;
 	}
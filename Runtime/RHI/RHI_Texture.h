@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================
 #include <memory>
+#include <mutex>
 #include "RHI_Object.h"
 #include "RHI_Definition.h"
 #include "../Resource/IResource.h"
@@ -45,9 +46,24 @@ namespace Directus
 		//= IResource ==========================================
 		bool SaveToFile(const std::string& filePath) override;
 		bool LoadFromFile(const std::string& filePath) override;
-		unsigned int GetMemoryUsage() override;
+		bool LoadAsync_Read(const std::string& filePath) override;
+		bool LoadAsync_Finalize() override;
+		unsigned long long GetMemoryUsage() override;
+		unsigned long long ComputeContentHash() override;
+		unsigned long long Evict() override;
 		//======================================================
 
+		// Loads the six faces of a cubemap (+X, -X, +Y, -Y, +Z, -Z), the faces are decoded in parallel and the
+		// result (all faces and their mips) is kept in the derived data cache as a single texture
+		bool LoadFromFiles_Cubemap(const std::vector<std::string>& facePaths);
+
+		// Hash of the texture bits and the properties that affect how they are interpreted, 0 if the bits aren't loaded
+		unsigned long long ComputePixelHash();
+
+		// Takes the data and the shader resource of a texture which was loaded again (hot reload), keeping the identity of this one.
+		// The previous data and shader resource go to the other texture.
+		void Reload_Swap(RHI_Texture* texture);
+
 		//= GRAPHICS API  ====================================================================================================================================================================
 		// Generates a shader resource from a pre-made mip chain
 		bool ShaderResource_Create2D(unsigned int width, unsigned int height, unsigned int channels, Texture_Format format, const std::vector<std::vector<std::byte>>& data);
@@ -58,42 +74,70 @@ namespace Directus
 		
 		void ShaderResource_Release();
 		void* GetShaderResource() const { return m_shaderResource; }
+
+		// Block compressed formats store 4x4 texel blocks, so a row of blocks is the smallest row there is
+		static bool IsBlockCompressed(Texture_Format format) { return format >= Texture_Format_BC1_UNORM && format <= Texture_Format_BC7_UNORM; }
+		unsigned int ComputeRowPitch(unsigned int width, unsigned int channels, Texture_Format format);
 		//====================================================================================================================================================================================
 		
 		//= PROPERTIES =================================================================================
 		unsigned int GetWidth()								{ return m_width; }
-		void SetWidth(unsigned int width)					{ m_width = width; }
+		void SetWidth(unsigned int width)					{ m_width = width; m_isDirty = true; }
 
 		unsigned int GetHeight()							{ return m_height; }
-		void SetHeight(unsigned int height)					{ m_height = height; }
+		void SetHeight(unsigned int height)					{ m_height = height; m_isDirty = true; }
 
 		bool GetGrayscale()									{ return m_isGrayscale; }
-		void SetGrayscale(bool isGrayscale)					{ m_isGrayscale = isGrayscale; }
+		void SetGrayscale(bool isGrayscale)					{ m_isGrayscale = isGrayscale; m_isDirty = true; }
 
 		bool GetTransparency()								{ return m_isTransparent; }
-		void SetTransparency(bool isTransparent)			{ m_isTransparent = isTransparent; }
+		void SetTransparency(bool isTransparent)			{ m_isTransparent = isTransparent; m_isDirty = true; }
 
 		unsigned int GetBPP()								{ return m_bpp; }
-		void SetBPP(unsigned int bpp)						{ m_bpp = bpp; }
+		void SetBPP(unsigned int bpp)						{ m_bpp = bpp; m_isDirty = true; }
 
 		unsigned int GetBPC()								{ return m_bpc; }
 		void SetBPC(unsigned int bpc)						{ m_bpc = bpc; }
 
 		unsigned int GetChannels()							{ return m_channels; }
-		void SetChannels(unsigned int channels)				{ m_channels = channels; }
+		void SetChannels(unsigned int channels)				{ m_channels = channels; m_isDirty = true; }
 
 		Texture_Format GetFormat()							{ return m_format; }
 		void SetFormat(Texture_Format format)				{ m_format = format; }
 
-		bool HasMipChain()									{ return m_mipChain.size() > 1; }
+		// Import: how the texture bits are block compressed
+		Texture_Compression GetCompression()				{ return m_compression; }
+		void SetCompression(Texture_Compression compression){ m_compression = compression; }
+
+		bool HasMipChain()									{ return m_mipChain.size() > (m_isCubemap ? 6u : 1u); }
+
+		// Cubemaps hold the mips of their faces one face after the other
+		bool GetCubemap()									{ return m_isCubemap; }
 
 		bool GetNeedsMipChain()								{ return m_needsMipChain; }
 		void SetNeedsMipChain(bool needsMipChain)			{ m_needsMipChain = needsMipChain; }
 
-		const std::vector<MipLevel>& Data_Get()					{ return m_mipChain; }
-		void Data_Set(const std::vector<MipLevel>& dataRGBA)	{ m_mipChain = dataRGBA; }
-		MipLevel* Data_AddMipLevel() { return &m_mipChain.emplace_back(MipLevel()); }
-		MipLevel* Data_GetMipLevel(unsigned int index);
+		// Mip chain generation: the texture holds sRGB color, which is filtered in linear space
+		bool GetSRGB()										{ return m_isSRGB; }
+		void SetSRGB(bool isSRGB)							{ m_isSRGB = isSRGB; }
+
+		// Mip chain generation: the alpha test reference whose coverage is preserved at every mip (0 to disable)
+		float GetMipAlphaReference()						{ return m_mipAlphaReference; }
+		void SetMipAlphaReference(float alphaReference)		{ m_mipAlphaReference = alphaReference; }
+
+		// The image the texture was imported from (empty for cubemaps and engine-made textures), hot reload watches it
+		const std::string& GetSourceFilePath()				{ return m_sourceFilePath; }
+
+		// Size of a mip, in texels
+		unsigned int GetMipWidth(unsigned int mip)			{ return (m_width >> mip) > 0 ? (m_width >> mip) : 1; }
+		unsigned int GetMipHeight(unsigned int mip)			{ return (m_height >> mip) > 0 ? (m_height >> mip) : 1; }
+
+		// Texture bits which were evicted are reloaded from the engine format
+		const std::vector<MipLevel>& Data_Get();
+		void Data_Set(const std::vector<MipLevel>& dataRGBA)	{ m_mipChain = dataRGBA; m_isDirty = true; m_isEvicted = false; }
+		MipLevel* Data_AddMipLevel() { m_isDirty = true; m_isEvicted = false; return &m_mipChain.emplace_back(MipLevel()); }
+		// Read only, changes go through Data_Set() or Data_AddMipLevel() so the texture is known to need saving
+		const MipLevel* Data_GetMipLevel(unsigned int index);
 		//==============================================================================================
 
 		//= TEXTURE BITS =======================================
@@ -101,10 +145,33 @@ namespace Directus
 		void GetTextureBytes(std::vector<MipLevel>* textureBytes);
 		//======================================================
 
+		//= STREAMING ==========================================================================================================
+		// A streamed texture only loads its mip tail from the engine format, the more detailed mips are read (using the
+		// per-mip offsets of the file) when the TextureStreamer asks for them and dropped again when it no longer does.
+		bool GetStreamed()									{ return m_isStreamed; }
+		void SetStreamed(bool isStreamed)					{ m_isStreamed = isStreamed; }
+		// Mips in the texture's own file, 0 until the texture has been saved or loaded in the engine format
+		unsigned int Streaming_GetMipCount();
+		// The most detailed mip the shader resource has
+		unsigned int Streaming_GetResidentMip()				{ return m_residentMip; }
+		// The mip which is always resident
+		unsigned int Streaming_GetTailMip();
+		// Block compressed textures can only start at mips which are made of whole blocks
+		bool Streaming_IsValidTopMip(unsigned int mip);
+		// Bytes of the mips from the given one down to 1x1
+		unsigned long long Streaming_GetBytes(unsigned int mip);
+		// Reads the mips from the given one down to 1x1 and creates a shader resource for them (safe to call from the worker threads)
+		bool Streaming_Load(unsigned int mip);
+		// Replaces the shader resource with the one created by Streaming_Load(), call on the main thread
+		void Streaming_Apply();
+		//======================================================================================================================
+
 	protected:
 		//= NATIVE TEXTURE HANDLING (BINARY) =========
 		bool Serialize(const std::string& filePath);
-		bool Deserialize(const std::string& filePath);
+		// Streamed textures read only their mip tail when streaming is allowed. Files which belong to another
+		// texture (e.g. derived data) are read with keepID, so the texture keeps the ID it's cached under.
+		bool Deserialize(const std::string& filePath, bool allowStreaming = false, bool keepID = false);
 		//============================================
 
 		bool LoadFromForeignFormat(const std::string& filePath);
@@ -118,10 +185,25 @@ namespace Directus
 		bool m_isGrayscale		= false;
 		bool m_isTransparent	= false;
 		bool m_needsMipChain	= true;
+		bool m_isSRGB			= false;
+		float m_mipAlphaReference	= 0.0f;
+		bool m_isEngineFormat	= false;
+		bool m_isCubemap		= false;
+		std::string m_sourceFilePath;
 		Texture_Format m_format;
+		Texture_Compression m_compression = Texture_Compression_None;
 		std::vector<MipLevel> m_mipChain;
 		//===============================
 
+		//= STREAMING =========================================
+		bool m_isStreamed						= false;
+		unsigned int m_residentMip				= 0;
+		std::vector<unsigned int> m_mipOffsets;
+		std::shared_ptr<RHI_Texture> m_streamingStaging;
+		unsigned int m_streamingStagingMip		= 0;
+		std::mutex m_streamingMutex;
+		//=====================================================
+
 		// D3D11
 		std::shared_ptr<RHI_Device> m_rhiDevice;
 		void* m_shaderResource		= nullptr;
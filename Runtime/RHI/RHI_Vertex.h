@@ -66,6 +66,15 @@ namespace Directus
 		float bitangent[3]	= { 0 };
 	};
 
+	// RHI_Vertex_PosUVTBN in 20 bytes, see Utility::Quantization
+	struct RHI_Vertex_PosUVTBN_Quantized
+	{
+		unsigned short pos[4]	= { 0 }; // xyz relative to the bounding box of the model, w is the sign of the bitangent
+		unsigned short uv[2]	= { 0 }; // half
+		short normal[2]			= { 0 }; // octahedral
+		short tangent[2]		= { 0 }; // octahedral
+	};
+
 	struct RHI_Vertex_PosUVNor
 	{
 		RHI_Vertex_PosUVNor(){}
@@ -136,6 +145,7 @@ namespace Directus
 	};
 
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosUVTBN>::value,	"RI_Vertex_PosUVTBN is not trivially copyable");
+	static_assert(std::is_trivially_copyable<RHI_Vertex_PosUVTBN_Quantized>::value,	"RHI_Vertex_PosUVTBN_Quantized is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosUVNor>::value,	"RI_Vertex_PosUVNor is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosUV>::value,		"RI_Vertex_PosUV is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosCol>::value,		"RI_Vertex_PosCol is not trivially copyable");
@@ -50,4 +50,17 @@ namespace Directus
 	{
 		return true;
 	}
+
+	unsigned long long Animation::GetMemoryUsage()
+	{
+		unsigned long long size = 0;
+		for (const auto& channel : m_channels)
+		{
+			size += channel.positionFrames.size()	* sizeof(KeyVector);
+			size += channel.rotationFrames.size()	* sizeof(KeyQuaternion);
+			size += channel.scaleFrames.size()		* sizeof(KeyVector);
+		}
+
+		return size;
+	}
 }
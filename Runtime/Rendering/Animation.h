@@ -70,6 +70,7 @@ namespace Directus
 		//= RESOURCE INTERFACE ========================
 		bool LoadFromFile(const std::string& filePath) override;
 		bool SaveToFile(const std::string& filePath) override;
+		unsigned long long GetMemoryUsage() override;
 		//=============================================
 
 		void SetName(const std::string& name) { m_name = name; }
@@ -53,7 +53,8 @@ namespace Directus
 		const Matrix& mView,
 		const Matrix& mProjection,
 		const vector<Actor*>& lights,
-		bool doSSR
+		bool doSSR,
+		const vector<Vector3>* irradianceSH
 	)
 	{
 		if (GetState() != Shader_Built)
@@ -144,6 +145,14 @@ namespace Directus
 		buffer->spotLightCount	= (float)spotIndex;
 		buffer->padding			= Vector2(doSSR ? 1.0f : 0.0f, 0.0f);
 
+		// Without a precomputed irradiance the environment is white (the first coefficient alone evaluates to 1)
+		bool hasIrradiance = irradianceSH && irradianceSH->size() == shCount;
+		for (int i = 0; i < shCount; i++)
+		{
+			Vector3 coefficient		= hasIrradiance ? (*irradianceSH)[i] : Vector3(i == 0 ? 3.544908f : 0.0f);
+			buffer->irradianceSH[i]	= Vector4(coefficient.x, coefficient.y, coefficient.z, 0.0f);
+		}
+
 		// Unmap buffer
 		m_cbuffer->Unmap();
 	}
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==============================
 #include "../../RHI/RHI_Definition.h"
 #include "../../Math/Matrix.h"
+#include "../../Math/Vector3.h"
 #include "../../Math/Vector4.h"
 #include "../../World/Components/Camera.h"
 #include "../../World/Components/Light.h"
@@ -45,13 +46,15 @@ namespace Directus
 			const Math::Matrix& mView,
 			const Math::Matrix& mProjection,
 			const std::vector<Actor*>& lights,
-			bool doSSR
+			bool doSSR,
+			const std::vector<Math::Vector3>* irradianceSH
 		);
 
 		std::shared_ptr<RHI_ConstantBuffer> GetConstantBuffer()	{ return m_cbuffer; }
 
 	private:
 		const static int maxLights = 64;
+		const static int shCount = 9;
 		struct LightBuffer
 		{
 			Math::Matrix mvp;
@@ -79,6 +82,9 @@ namespace Directus
 			float pointLightCount;
 			float spotLightCount;
 			Math::Vector2 padding;
+
+			// Irradiance of the environment, as spherical harmonics
+			Math::Vector4 irradianceSH[shCount];
 		};
 
 		std::shared_ptr<RHI_ConstantBuffer> m_cbuffer;
@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../World/Components/Transform.h"
 #include "../../World/Components/Camera.h"
 #include "../../Core/Settings.h"
+#include "../../Math/BoundingBox.h"
 //===========================================
 
 //= NAMESPACES ================
@@ -77,7 +78,7 @@ namespace Directus
 		m_variations.emplace_back(shared_from_this());
 	}
 
-	void ShaderVariation::UpdatePerObjectBuffer(Transform* transform, Material* material, const Matrix& mView, const Matrix mProjection)
+	void ShaderVariation::UpdatePerObjectBuffer(Transform* transform, Material* material, const BoundingBox& bounds, const Matrix& mView, const Matrix mProjection)
 	{
 		if (!material)
 		{
@@ -102,6 +103,8 @@ namespace Directus
 		update = perObjectBufferCPU.mModel			!= transform->GetMatrix()					? true : update;
 		update = perObjectBufferCPU.mMVP_current	!= mMVP_current								? true : update;
 		update = perObjectBufferCPU.mMVP_previous	!= transform->GetWVP_Previous()				? true : update;
+		update = perObjectBufferCPU.positionOffset	!= bounds.GetMin()							? true : update;
+		update = perObjectBufferCPU.positionScale	!= bounds.GetSize()							? true : update;
 
 		if (!update)
 			return;
@@ -120,6 +123,10 @@ namespace Directus
 		buffer->mModel			= perObjectBufferCPU.mModel				= transform->GetMatrix();
 		buffer->mMVP_current	= perObjectBufferCPU.mMVP_current		= mMVP_current;
 		buffer->mMVP_previous	= perObjectBufferCPU.mMVP_previous		= transform->GetWVP_Previous();
+		buffer->positionOffset	= perObjectBufferCPU.positionOffset		= bounds.GetMin();
+		buffer->padding2		= perObjectBufferCPU.padding2			= 0.0f;
+		buffer->positionScale	= perObjectBufferCPU.positionScale		= bounds.GetSize();
+		buffer->padding3		= perObjectBufferCPU.padding3			= 0.0f;
 		
 		m_constantBuffer->Unmap();
 
@@ -36,6 +36,10 @@ namespace Directus
 	class Camera;
 	class Material;
 	class Transform;
+	namespace Math
+	{
+		class BoundingBox;
+	}
 
 	enum ShaderFlags : unsigned long
 	{
@@ -57,7 +61,7 @@ namespace Directus
 		~ShaderVariation();
 
 		void Compile(const std::string& filePath, unsigned long shaderFlags);
-		void UpdatePerObjectBuffer(Transform* transform, Material* material, const Math::Matrix& mView, const Math::Matrix mProjection);
+		void UpdatePerObjectBuffer(Transform* transform, Material* material, const Math::BoundingBox& bounds, const Math::Matrix& mView, const Math::Matrix mProjection);
 
 		unsigned long GetShaderFlags()	{ return m_shaderFlags; }
 		bool HasAlbedoTexture()			{ return m_shaderFlags & Variaton_Albedo; }
@@ -99,6 +103,10 @@ namespace Directus
 			Math::Matrix mModel;
 			Math::Matrix mMVP_current;
 			Math::Matrix mMVP_previous;
+			Math::Vector3 positionOffset;
+			float padding2;
+			Math::Vector3 positionScale;
+			float padding3;
 		};
 		PerObjectBufferType perObjectBufferCPU;
 		std::shared_ptr<RHI_ConstantBuffer> m_constantBuffer;
@@ -26,7 +26,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Implementation.h"
 #include "../Resource/ResourceManager.h"
 #include "../IO/XmlDocument.h"
+#include "../IO/FileStream.h"
+#include "../Core/Hash.h"
 #include "../RHI/RHI_Texture.h"
+#include <mutex>
 //======================================
 
 //= NAMESPACES ================
@@ -50,6 +53,15 @@ namespace Directus
 		"CubeMap",
 	};
 
+	// Materials can be loaded from multiple threads, shader variation lookup/creation must be atomic
+	static mutex shaderMutex;
+
+	namespace _Material
+	{
+		static const unsigned int binaryMagic	= 0x54414D44; // "DMAT"
+		static const unsigned int binaryVersion	= 2; // 2: dependencies in the header
+	}
+
 	Material::Material(Context* context) : IResource(context, Resource_Material)
 	{
 		// Material
@@ -81,11 +93,193 @@ namespace Directus
 		// Make sure the path is relative
 		SetResourceFilePath(FileSystem::GetRelativeFilePath(filePath));
 
+		auto file = make_unique<FileStream>(GetResourceFilePath(), FileStreamMode_Read);
+		if (!file->IsOpen())
+			return false;
+
+		// Materials saved before the binary format, or exported with SaveToXml(), are XML. They are
+		// imported and written in the binary format (at the path they record) the next time they are saved.
+		if (file->ReadUInt() != _Material::binaryMagic)
+		{
+			file.reset();
+			if (!LoadFromXml(GetResourceFilePath()))
+				return false;
+
+			m_isDirty = true;
+			m_resourceManager->SetDependencies(GetResourceFilePath(), GetDependencies());
+			return true;
+		}
+
+		auto version = file->ReadUInt();
+		if (version == 0 || version > _Material::binaryVersion)
+		{
+			LOGF_ERROR("Material::LoadFromFile: \"%s\" has an unsupported version", GetResourceFilePath().c_str());
+			return false;
+		}
+
+		// Dependencies (the texture paths are read again below)
+		if (version >= 2)
+		{
+			vector<string> dependencies;
+			file->Read(&dependencies);
+		}
+
+		string name, path;
+		file->Read(&name);
+		file->Read(&path);
+		SetResourceName(name);
+		SetResourceFilePath(path);
+		file->Read(&m_modelID);
+		m_cullMode		= (Cull_Mode)file->ReadUInt();
+		m_shadingMode	= (ShadingMode)file->ReadUInt();
+		file->Read(&m_colorAlbedo);
+		file->Read(&m_roughnessMultiplier);
+		file->Read(&m_metallicMultiplier);
+		file->Read(&m_normalMultiplier);
+		file->Read(&m_heightMultiplier);
+		file->Read(&m_uvTiling);
+		file->Read(&m_uvOffset);
+		file->Read(&m_isEditable);
+
+		// The file's textures replace any current ones (the material can be reloaded)
+		m_textureSlots.clear();
+		unsigned int textureCount = file->ReadUInt();
+		string texName, texPath;
+		for (unsigned int i = 0; i < textureCount; i++)
+		{
+			auto texType = (TextureType)file->ReadUInt();
+			file->Read(&texName);
+			file->Read(&texPath);
+			ResolveTexture(texType, texName, texPath);
+		}
+
+		AcquireShader();
+
+		// In sync with the file
+		m_isDirty		= false;
+		m_contentHash	= ComputeContentHash();
+		m_resourceManager->SetDependencies(GetResourceFilePath(), GetDependencies());
+
+		return true;
+	}
+
+	bool Material::SaveToFile(const string& filePath)
+	{
+		// Make sure the path is relative
+		SetResourceFilePath(FileSystem::GetRelativeFilePath(filePath));
+
+		// Add material extension if not present
+		if (FileSystem::GetExtensionFromFilePath(GetResourceFilePath()) != EXTENSION_MATERIAL)
+		{
+			SetResourceFilePath(GetResourceFilePath() + EXTENSION_MATERIAL);
+		}
+
+		auto file = make_unique<FileStream>(GetResourceFilePath(), FileStreamMode_Write);
+		if (!file->IsOpen())
+			return false;
+
+		auto dependencies = GetDependencies();
+		file->Write(_Material::binaryMagic);
+		file->Write(_Material::binaryVersion);
+		file->Write(dependencies);
+		file->Write(GetResourceName());
+		file->Write(GetResourceFilePath());
+		file->Write(m_modelID);
+		file->Write((unsigned int)m_cullMode);
+		file->Write((unsigned int)m_shadingMode);
+		file->Write(m_colorAlbedo);
+		file->Write(m_roughnessMultiplier);
+		file->Write(m_metallicMultiplier);
+		file->Write(m_normalMultiplier);
+		file->Write(m_heightMultiplier);
+		file->Write(m_uvTiling);
+		file->Write(m_uvOffset);
+		file->Write(m_isEditable);
+
+		file->Write((unsigned int)m_textureSlots.size());
+		for (const auto& textureSlot : m_textureSlots)
+		{
+			file->Write((unsigned int)textureSlot.type);
+			file->Write(textureSlot.ptr ? textureSlot.ptr->GetResourceName() : NOT_ASSIGNED);
+			file->Write(textureSlot.ptr ? textureSlot.ptr->GetResourceFilePath() : NOT_ASSIGNED);
+		}
+
+		m_isDirty		= false;
+		m_contentHash	= ComputeContentHash();
+		m_resourceManager->SetDependencies(GetResourceFilePath(), dependencies);
+
+		return true;
+	}
+
+	bool Material::ReadDependencies(const string& filePath, vector<string>* dependencies)
+	{
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
+		if (!file->IsOpen() || file->ReadUInt() != _Material::binaryMagic)
+			return false;
+
+		auto version = file->ReadUInt();
+		if (version >= 2 && version <= _Material::binaryVersion)
+		{
+			file->Read(dependencies);
+			return true;
+		}
+
+		if (version != 1)
+			return false;
+
+		// Version 1 has no dependencies in its header, but it's small enough to parse
+		string name, path;
+		unsigned int modelID, cullMode, shadingMode;
+		Vector4 color;
+		float roughness, metallic, normal, height;
+		Vector2 tiling, offset;
+		bool isEditable;
+		file->Read(&name);
+		file->Read(&path);
+		file->Read(&modelID);
+		file->Read(&cullMode);
+		file->Read(&shadingMode);
+		file->Read(&color);
+		file->Read(&roughness);
+		file->Read(&metallic);
+		file->Read(&normal);
+		file->Read(&height);
+		file->Read(&tiling);
+		file->Read(&offset);
+		file->Read(&isEditable);
+
+		unsigned int textureCount = file->ReadUInt();
+		for (unsigned int i = 0; i < textureCount; i++)
+		{
+			file->ReadUInt();
+			file->Read(&name);
+			file->Read(&path);
+			if (path != NOT_ASSIGNED)
+			{
+				dependencies->emplace_back(path);
+			}
+		}
+
+		return true;
+	}
+	//==========================================================
+
+	//= XML (IMPORT/EXPORT) ====================================
+	bool Material::LoadFromXml(const string& filePath)
+	{
+		// Make sure the path is relative
+		SetResourceFilePath(FileSystem::GetRelativeFilePath(filePath));
+
 		auto xml = make_unique<XmlDocument>();
 		if (!xml->Load(GetResourceFilePath()))
 			return false;
 
-		SetResourceName(xml->GetAttributeAs<string>("Material", "Name"));
+		// Other XML files (e.g. metadata) aren't materials
+		string name;
+		if (!xml->GetAttribute("Material", "Name", &name))
+			return false;
+
+		SetResourceName(name);
 		SetResourceFilePath(xml->GetAttributeAs<string>("Material", "Path"));
 		xml->GetAttribute("Material", "Model_ID",				&m_modelID);
 		xml->GetAttribute("Material", "Roughness_Multiplier",	&m_roughnessMultiplier);
@@ -99,6 +293,7 @@ namespace Directus
 		xml->GetAttribute("Material", "UV_Tiling",				&m_uvTiling);
 		xml->GetAttribute("Material", "UV_Offset",				&m_uvOffset);
 
+		m_textureSlots.clear();
 		auto textureCount = xml->GetAttributeAs<int>("Textures", "Count");
 		for (int i = 0; i < textureCount; i++)
 		{
@@ -107,14 +302,7 @@ namespace Directus
 			auto texName		= xml->GetAttributeAs<string>(nodeName, "Texture_Name");
 			auto texPath		= xml->GetAttributeAs<string>(nodeName, "Texture_Path");
 
-			// If the texture happens to be loaded, get a reference to it
-			auto texture = m_context->GetSubsystem<ResourceManager>()->GetResourceByName<RHI_Texture>(texName);
-			// If there is not texture (it's not loaded yet), load it
-			if (!texture)
-			{
-				texture = m_context->GetSubsystem<ResourceManager>()->Load<RHI_Texture>(texPath);
-			}
-			SetTextureSlot(texType, texture);
+			ResolveTexture(texType, texName, texPath);
 		}
 
 		AcquireShader();
@@ -122,17 +310,9 @@ namespace Directus
 		return true;
 	}
 
-	bool Material::SaveToFile(const string& filePath)
+	bool Material::SaveToXml(const string& filePath)
 	{
-		// Make sure the path is relative
-		SetResourceFilePath(FileSystem::GetRelativeFilePath(filePath));
-
-		// Add material extension if not present
-		if (FileSystem::GetExtensionFromFilePath(GetResourceFilePath()) != EXTENSION_MATERIAL)
-		{
-			SetResourceFilePath(GetResourceFilePath() + EXTENSION_MATERIAL);
-		}
-
+		// The material keeps its own file, the XML records it so importing writes the material back there
 		auto xml = make_unique<XmlDocument>();
 		xml->AddNode("Material");
 		xml->AddAttribute("Material", "Name",					GetResourceName());
@@ -162,13 +342,14 @@ namespace Directus
 			i++;
 		}
 
-		return xml->Save(GetResourceFilePath());
+		return xml->Save(FileSystem::GetRelativeFilePath(filePath));
 	}
+	//==========================================================
 
-	unsigned int Material::GetMemoryUsage()
+	unsigned long long Material::GetMemoryUsage()
 	{
 		// Doesn't have to be spot on, just representative
-		unsigned int size = 0;
+		unsigned long long size = 0;
 		size += sizeof(bool) * 2;
 		size += sizeof(int) * 3;
 		size += sizeof(float) * 5;
@@ -179,6 +360,30 @@ namespace Directus
 		return size;
 	}
 
+	unsigned long long Material::ComputeContentHash()
+	{
+		unsigned long long hash = Hash::Compute(GetResourceName());
+		hash = Hash::Combine(hash, Hash::Compute(GetResourceFilePath()));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_modelID));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_cullMode));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_shadingMode));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_colorAlbedo));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_roughnessMultiplier));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_metallicMultiplier));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_normalMultiplier));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_heightMultiplier));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_uvTiling));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_uvOffset));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_isEditable));
+		for (const auto& textureSlot : m_textureSlots)
+		{
+			hash = Hash::Combine(hash, Hash::ComputeValue(textureSlot.type));
+			hash = Hash::Combine(hash, Hash::Compute(textureSlot.ptr ? textureSlot.ptr->GetResourceFilePath() : NOT_ASSIGNED));
+		}
+
+		return hash;
+	}
+
 	const TextureSlot& Material::GetTextureSlotByType(TextureType type)
 	{
 		for (const auto& textureSlot : m_textureSlots)
@@ -228,6 +433,7 @@ namespace Directus
 
 		TextureBasedMultiplierAdjustment();
 		AcquireShader();
+		m_isDirty = true;
 	}
 
 	bool Material::HasTexture(TextureType type)
@@ -303,6 +509,8 @@ namespace Directus
 			return nullptr;
 		}
 
+		lock_guard<mutex> guard(shaderMutex);
+
 		// If an appropriate shader already exists, return it instead
 		if (auto existingShader = ShaderVariation::GetMatchingShader(shaderFlags))
 			return existingShader;
@@ -332,6 +540,20 @@ namespace Directus
 		{
 			m_heightMultiplier = value;
 		}
+
+		m_isDirty = true;
+	}
+
+	void Material::ResolveTexture(TextureType type, const string& name, const string& path)
+	{
+		// If the texture happens to be loaded, get a reference to it
+		auto texture = m_context->GetSubsystem<ResourceManager>()->GetResourceByName<RHI_Texture>(name);
+		// If there is not texture (it's not loaded yet), load it
+		if (!texture)
+		{
+			texture = m_context->GetSubsystem<ResourceManager>()->Load<RHI_Texture>(path);
+		}
+		SetTextureSlot(type, texture);
 	}
 
 	void Material::TextureBasedMultiplierAdjustment()
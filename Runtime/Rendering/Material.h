@@ -83,9 +83,20 @@ namespace Directus
 		//= IResource ==================================================
 		bool LoadFromFile(const std::string& filePath) override;
 		bool SaveToFile(const std::string& filePath) override;
-		unsigned int GetMemoryUsage() override;
+		unsigned long long GetMemoryUsage() override;
+		unsigned long long ComputeContentHash() override;
+		std::vector<std::string> GetDependencies() override { return GetTexturePaths(); }
 		//==============================================================
 
+		// Reads the dependencies of a material file without loading it
+		static bool ReadDependencies(const std::string& filePath, std::vector<std::string>* dependencies);
+
+		//= XML (IMPORT/EXPORT) =======================================================================
+		// LoadFromFile() imports XML materials, SaveToXml() exports a copy which can be edited by hand
+		bool LoadFromXml(const std::string& filePath);
+		bool SaveToXml(const std::string& filePath);
+		//=============================================================================================
+
 		//= TEXTURE SLOTS  ===========================================================================================
 		const TextureSlot& GetTextureSlotByType(TextureType type);
 		void SetTextureSlot(TextureType type, const std::shared_ptr<RHI_Texture>& textureWeak, bool autoCache = true);	
@@ -105,43 +116,44 @@ namespace Directus
 
 		//= PROPERTIES =======================================================================
 		unsigned int GetModelID()						{ return m_modelID; }
-		void SetModelID(unsigned int ID)				{ m_modelID = ID; }
+		void SetModelID(unsigned int ID)				{ m_modelID = ID; m_isDirty = true; }
 
 		Cull_Mode GetCullMode()							{ return m_cullMode; }
-		void SetCullMode(Cull_Mode cullMode)			{ m_cullMode = cullMode; }
+		void SetCullMode(Cull_Mode cullMode)			{ m_cullMode = cullMode; m_isDirty = true; }
 
 		float& GetRoughnessMultiplier()					{ return m_roughnessMultiplier; }
-		void SetRoughnessMultiplier(float roughness)	{ m_roughnessMultiplier = roughness; }
+		void SetRoughnessMultiplier(float roughness)	{ m_roughnessMultiplier = roughness; m_isDirty = true; }
 
 		float GetMetallicMultiplier()					{ return m_metallicMultiplier; }
-		void SetMetallicMultiplier(float metallic)		{ m_metallicMultiplier = metallic; }
+		void SetMetallicMultiplier(float metallic)		{ m_metallicMultiplier = metallic; m_isDirty = true; }
 
 		float GetNormalMultiplier()						{ return m_normalMultiplier; }
-		void SetNormalMultiplier(float normal)			{ m_normalMultiplier = normal; }
+		void SetNormalMultiplier(float normal)			{ m_normalMultiplier = normal; m_isDirty = true; }
 
 		float GetHeightMultiplier()						{ return m_heightMultiplier; }
-		void SetHeightMultiplier(float height)			{ m_heightMultiplier = height; }
+		void SetHeightMultiplier(float height)			{ m_heightMultiplier = height; m_isDirty = true; }
 
 		ShadingMode GetShadingMode()					{ return m_shadingMode; }
-		void SetShadingMode(ShadingMode shadingMode)	{ m_shadingMode = shadingMode; }
+		void SetShadingMode(ShadingMode shadingMode)	{ m_shadingMode = shadingMode; m_isDirty = true; }
 
 		const Math::Vector4& GetColorAlbedo()			{ return m_colorAlbedo; }
-		void SetColorAlbedo(const Math::Vector4& color) { m_colorAlbedo = color; }
+		void SetColorAlbedo(const Math::Vector4& color) { m_colorAlbedo = color; m_isDirty = true; }
 
 		const Math::Vector2& GetTiling()				{ return m_uvTiling; }
-		void SetTiling(const Math::Vector2& tiling)		{ m_uvTiling = tiling; }
+		void SetTiling(const Math::Vector2& tiling)		{ m_uvTiling = tiling; m_isDirty = true; }
 
 		const Math::Vector2& GetOffset()				{ return m_uvOffset; }
-		void SetOffset(const Math::Vector2& offset)		{ m_uvOffset = offset; }
+		void SetOffset(const Math::Vector2& offset)		{ m_uvOffset = offset; m_isDirty = true; }
 
 		bool IsEditable()								{ return m_isEditable; }
-		void SetIsEditable(bool isEditable)				{ m_isEditable = isEditable; }
+		void SetIsEditable(bool isEditable)				{ m_isEditable = isEditable; m_isDirty = true; }
 		//====================================================================================
 
 		TextureType TextureTypeFromString(const std::string& type);
 
 	private:
 		void TextureBasedMultiplierAdjustment();
+		void ResolveTexture(TextureType type, const std::string& name, const std::string& path);
 
 		unsigned int m_modelID;	
 		Cull_Mode m_cullMode;
@@ -40,11 +40,11 @@ namespace Directus
 		m_indices.shrink_to_fit();
 	}
 
-	unsigned int Mesh::Geometry_MemoryUsage()
+	unsigned long long Mesh::Geometry_MemoryUsage()
 	{
-		unsigned int size = 0;
-		size += unsigned int(m_vertices.size()	* sizeof(RHI_Vertex_PosUVTBN));
-		size += unsigned int(m_indices.size()	* sizeof(unsigned int));
+		unsigned long long size = 0;
+		size += m_vertices.size()	* sizeof(RHI_Vertex_PosUVTBN);
+		size += m_indices.size()	* sizeof(unsigned int);
 
 		return size;
 	}
@@ -44,7 +44,7 @@ namespace Directus
 			std::vector<unsigned int>* indices,
 			std::vector<RHI_Vertex_PosUVTBN>* vertices
 		);
-		unsigned int Geometry_MemoryUsage();
+		unsigned long long Geometry_MemoryUsage();
 
 		// Vertices
 		void Vertex_Add(const RHI_Vertex_PosUVTBN& vertex);
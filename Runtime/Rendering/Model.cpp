@@ -21,12 +21,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==============================
 #include "Model.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include "Mesh.h"
 #include "Animation.h"
 #include "Renderer.h"
 #include "Material.h"
+#include "Utilities/Quantization.h"
 #include "../IO/FileStream.h"
 #include "../Core/Stopwatch.h"
+#include "../Core/Hash.h"
+#include "../Core/EventSystem.h"
+#include "../Core/GUIDGenerator.h"
 #include "../World/Actor.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
@@ -35,6 +43,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_IndexBuffer.h"
 #include "../RHI/RHI_Texture.h"
 #include "../Resource/ResourceManager.h"
+#include "../Threading/Threading.h"
 //=========================================
 
 //= NAMESPACES ================
@@ -44,6 +53,231 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	namespace _Model
+	{
+		static const unsigned int binaryMagic	= 0x4C444D44; // "DMDL"
+		static const unsigned int binaryVersion	= 5;
+
+		// Block compression which keeps whatever the shaders read from each texture type
+		static Texture_Compression ComputeTextureCompression(TextureType type)
+		{
+			switch (type)
+			{
+				case TextureType_Albedo:
+				case TextureType_Mask:
+					return Texture_Compression_Color;
+				case TextureType_Normal:
+					return Texture_Compression_Normal;
+				case TextureType_Roughness:
+				case TextureType_Metallic:
+				case TextureType_Height:
+				case TextureType_Occlusion:
+				case TextureType_Emission:
+					return Texture_Compression_Red;
+				default:
+					return Texture_Compression_None;
+			}
+		}
+
+		// A texture being imported by Model::ImportTextures(), it goes to the workers twice (to load it and to save it)
+		struct TextureJob
+		{
+			string filePath;
+			string name;
+			shared_ptr<RHI_Texture> texture;
+			unsigned long long sourceKey	= 0;
+			unsigned long long pixelKey		= 0;
+			bool loaded						= false;
+			bool saved						= false;
+			// Jobs whose pixels turned out identical, they use this job's texture once it's saved
+			vector<shared_ptr<TextureJob>> duplicates;
+		};
+
+		// Jobs which are back from the workers
+		struct TextureJobQueue
+		{
+			mutex completedMutex;
+			deque<shared_ptr<TextureJob>> completed;
+
+			void Push(const shared_ptr<TextureJob>& job)
+			{
+				lock_guard<mutex> guard(completedMutex);
+				completed.emplace_back(job);
+			}
+
+			bool IsEmpty()
+			{
+				lock_guard<mutex> guard(completedMutex);
+				return completed.empty();
+			}
+		};
+
+		// Reads everything that precedes the geometry. Models saved before the
+		// header existed start with their name, the length of which is read first.
+		static bool ReadHeader(FileStream* file, string* name, string* filePath, float* normalizedScale, vector<string>* dependencies, unsigned int* version)
+		{
+			*version = 1;
+			auto magic = file->ReadUInt();
+			if (magic == binaryMagic)
+			{
+				*version = file->ReadUInt();
+				if (*version > binaryVersion)
+					return false;
+
+				file->Read(dependencies);
+				file->Read(name);
+			}
+			else
+			{
+				name->resize(magic);
+				for (auto& c : *name)
+				{
+					unsigned char character = 0;
+					file->Read(&character);
+					c = (char)character;
+				}
+			}
+
+			file->Read(filePath);
+			file->Read(normalizedScale);
+
+			return true;
+		}
+
+		// Submesh indices are relative to their vertex offset, so most models fit in 16 bits
+		static bool IndicesFit16Bits(const vector<unsigned int>& indices)
+		{
+			for (auto index : indices)
+			{
+				if (index > 0xFFFF)
+					return false;
+			}
+
+			return true;
+		}
+
+		// Version 1 stored the vertices as they are, version 2 stores them quantized against their
+		// bounding box and version 3 stores the indices in 16 bits when they fit
+		static void ReadGeometry(FileStream* file, unsigned int version, vector<unsigned int>* indices, vector<RHI_Vertex_PosUVTBN>* vertices)
+		{
+			bool indices16 = false;
+			if (version >= 3)
+			{
+				file->Read(&indices16);
+			}
+
+			if (indices16)
+			{
+				vector<unsigned short> indicesCompact;
+				file->Read(&indicesCompact);
+				indices->assign(indicesCompact.begin(), indicesCompact.end());
+			}
+			else
+			{
+				file->Read(indices);
+			}
+
+			if (version < 2)
+			{
+				file->Read(vertices);
+				return;
+			}
+
+			BoundingBox bounds;
+			vector<RHI_Vertex_PosUVTBN_Quantized> quantized;
+			file->Read(&bounds);
+			file->Read(&quantized);
+			Utility::Quantization::Dequantize(quantized, bounds, vertices);
+		}
+
+		static void WriteGeometry(FileStream* file, const vector<unsigned int>& indices, const vector<RHI_Vertex_PosUVTBN>& vertices)
+		{
+			BoundingBox bounds(vertices);
+			vector<RHI_Vertex_PosUVTBN_Quantized> quantized;
+			Utility::Quantization::Quantize(vertices, bounds, &quantized);
+
+			bool indices16 = IndicesFit16Bits(indices);
+			file->Write(indices16);
+			if (indices16)
+			{
+				file->Write(vector<unsigned short>(indices.begin(), indices.end()));
+			}
+			else
+			{
+				file->Write(indices);
+			}
+			file->Write(bounds);
+			file->Write(quantized);
+		}
+
+		// Version 4 follows the geometry with the clusters
+		static void ReadClusters(FileStream* file, vector<Mesh_Cluster>* clusters)
+		{
+			clusters->resize(file->ReadUInt());
+			for (auto& cluster : *clusters)
+			{
+				file->Read(&cluster.indexOffset);
+				file->Read(&cluster.indexCount);
+				file->Read(&cluster.center);
+				file->Read(&cluster.radius);
+				file->Read(&cluster.coneAxis);
+				file->Read(&cluster.coneCutoff);
+			}
+		}
+
+		static void WriteClusters(FileStream* file, const vector<Mesh_Cluster>& clusters)
+		{
+			file->Write((unsigned int)clusters.size());
+			for (const auto& cluster : clusters)
+			{
+				file->Write(cluster.indexOffset);
+				file->Write(cluster.indexCount);
+				file->Write(cluster.center);
+				file->Write(cluster.radius);
+				file->Write(cluster.coneAxis);
+				file->Write(cluster.coneCutoff);
+			}
+		}
+
+		// Version 5 follows the clusters with the levels of detail
+		static void ReadLods(FileStream* file, vector<Mesh_Lod>* lods)
+		{
+			lods->resize(file->ReadUInt());
+			for (auto& lod : *lods)
+			{
+				file->Read(&lod.sourceIndexOffset);
+				file->Read(&lod.indexOffset);
+				file->Read(&lod.indexCount);
+				file->Read(&lod.error);
+			}
+		}
+
+		static void WriteLods(FileStream* file, const vector<Mesh_Lod>& lods)
+		{
+			file->Write((unsigned int)lods.size());
+			for (const auto& lod : lods)
+			{
+				file->Write(lod.sourceIndexOffset);
+				file->Write(lod.indexOffset);
+				file->Write(lod.indexCount);
+				file->Write(lod.error);
+			}
+		}
+
+		// Actors restored from the derived data cache get new IDs, as the same model can be imported more than once
+		static void RegenerateIDs(Actor* actor)
+		{
+			actor->SetID(GENERATE_GUID);
+			for (const auto& child : actor->GetTransform_PtrRaw()->GetChildren())
+			{
+				if (child->GetActor_PtrRaw())
+				{
+					RegenerateIDs(child->GetActor_PtrRaw());
+				}
+			}
+		}
+	}
+
 	Model::Model(Context* context) : IResource(context, Resource_Model)
 	{
 		m_normalizedScale	= 1.0f;
@@ -88,7 +322,7 @@ namespace Directus
 		bool engineFormat = FileSystem::GetExtensionFromFilePath(modelFilePath) == EXTENSION_MODEL;
 		bool success = engineFormat ? LoadFromEngineFormat(modelFilePath) : LoadFromForeignFormat(modelFilePath);
 
-		Geometry_ComputeMemoryUsage();
+		m_memoryUsage = Geometry_ComputeMemoryUsage();
 		LOGF_INFO("Model::LoadFromFile: Loading \"%s\" took %d ms", FileSystem::GetFileNameFromFilePath(filePath).c_str(), (int)timer.GetElapsedTimeMs());
 
 		return success;
@@ -96,38 +330,156 @@ namespace Directus
 
 	bool Model::SaveToFile(const string& filePath)
 	{
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, true);
 		if (!file->IsOpen())
 			return false;
 
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		Geometry_Reload();
+		auto dependencies = GetDependencies();
+		file->Write(_Model::binaryMagic);
+		file->Write(_Model::binaryVersion);
+		file->Write(dependencies);
 		file->Write(GetResourceName());
 		file->Write(GetResourceFilePath());
 		file->Write(m_normalizedScale);
-		file->Write(m_mesh->Indices_Get());
-		file->Write(m_mesh->Vertices_Get());	
+		_Model::WriteGeometry(file.get(), m_mesh->Indices_Get(), m_mesh->Vertices_Get());
+		_Model::WriteClusters(file.get(), m_clusters);
+		_Model::WriteLods(file.get(), m_lods);
+
+		m_isDirty		= false;
+		m_contentHash	= ComputeContentHash();
+		m_resourceManager->SetDependencies(GetResourceFilePath(), dependencies);
 
 		return true;
 	}
+
+	unsigned long long Model::ComputeContentHash()
+	{
+		// Evicted geometry is what the file has, so it hashes the same as when it was last resident (no need to reload it)
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		if (!m_isEvicted)
+		{
+			const auto& indices		= m_mesh->Indices_Get();
+			const auto& vertices	= m_mesh->Vertices_Get();
+			m_geometryHash			= Hash::Combine(Hash::Compute(indices.data(), indices.size() * sizeof(unsigned int)), Hash::Compute(vertices.data(), vertices.size() * sizeof(RHI_Vertex_PosUVTBN)));
+		}
+
+		unsigned long long hash = Hash::Compute(GetResourceName());
+		hash = Hash::Combine(hash, Hash::Compute(GetResourceFilePath()));
+		hash = Hash::Combine(hash, Hash::ComputeValue(m_normalizedScale));
+		hash = Hash::Combine(hash, m_geometryHash);
+		hash = Hash::Combine(hash, Hash::Compute(m_clusters.data(), m_clusters.size() * sizeof(Mesh_Cluster)));
+		hash = Hash::Combine(hash, Hash::Compute(m_lods.data(), m_lods.size() * sizeof(Mesh_Lod)));
+
+		return hash;
+	}
+
+	vector<string> Model::GetDependencies()
+	{
+		// The materials which were recorded in the file, and any which were added since
+		vector<string> dependencies = m_materialPaths;
+		for (const auto& materialWeak : m_materials)
+		{
+			auto material = materialWeak.lock();
+			if (material && find(dependencies.begin(), dependencies.end(), material->GetResourceFilePath()) == dependencies.end())
+			{
+				dependencies.emplace_back(material->GetResourceFilePath());
+			}
+		}
+
+		return dependencies;
+	}
+
+	bool Model::ReadDependencies(const string& filePath, vector<string>* dependencies)
+	{
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
+		if (!file->IsOpen())
+			return false;
+
+		string name, path;
+		float normalizedScale;
+		unsigned int version;
+		return _Model::ReadHeader(file.get(), &name, &path, &normalizedScale, dependencies, &version);
+	}
+
+	unsigned long long Model::Evict()
+	{
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+
+		// Only geometry which is in sync with an engine format file can be reloaded, the GPU buffers are kept
+		if (m_isDirty || m_mesh->Vertices_Count() == 0 || FileSystem::GetExtensionFromFilePath(m_resourceFilePath) != EXTENSION_MODEL || !FileSystem::FileExists(m_resourceFilePath))
+			return 0;
+
+		auto size = m_mesh->Geometry_MemoryUsage();
+		m_mesh->Geometry_Clear();
+		m_memoryUsage	= Geometry_ComputeMemoryUsage();
+		m_isEvicted		= true;
+
+		return size;
+	}
 	//=======================================================
 
 	void Model::Geometry_Append(std::vector<unsigned int>& indices, std::vector<RHI_Vertex_PosUVTBN>& vertices, unsigned int* indexOffset, unsigned int* vertexOffset)
 	{
 		// Append indices and vertices to the main mesh
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		Geometry_Reload();
+		MeshOptimizer::Optimize(&indices, &vertices, &m_optimizationBefore, &m_optimizationAfter);
+
+		// Clusters address the model's index buffer
+		auto clusterCount = m_clusters.size();
+		MeshOptimizer::BuildClusters(indices, vertices, &m_clusters);
+		for (auto i = clusterCount; i < m_clusters.size(); i++)
+		{
+			m_clusters[i].indexOffset += m_mesh->Indices_Count();
+		}
+
+		// Simplified levels follow the submesh in the index buffer and are drawn with its vertices
+		vector<Mesh_Lod> lods;
+		vector<unsigned int> lodIndices;
+		MeshOptimizer::BuildLods(indices, vertices, &lods, &lodIndices);
+		auto sourceIndexOffset = m_mesh->Indices_Count();
+		for (auto& lod : lods)
+		{
+			lod.sourceIndexOffset	= sourceIndexOffset;
+			lod.indexOffset			+= sourceIndexOffset + (unsigned int)indices.size();
+			m_lods.emplace_back(lod);
+		}
+
 		m_mesh->Indices_Append(indices, indexOffset);
+		m_mesh->Indices_Append(lodIndices, nullptr);
 		m_mesh->Vertices_Append(vertices, vertexOffset);
+		m_isDirty = true;
 	}
 
 	void Model::Geometry_Get(unsigned int indexOffset, unsigned int indexCount, unsigned int vertexOffset, unsigned int vertexCount, vector<unsigned int>* indices, vector<RHI_Vertex_PosUVTBN>* vertices)
 	{
+		Touch();
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		Geometry_Reload();
 		m_mesh->Geometry_Get(indexOffset, indexCount, vertexOffset, vertexCount, indices, vertices);
 	}
 
 	void Model::Geometry_Update()
 	{
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		Geometry_Reload();
+		m_aabb				= BoundingBox(m_mesh->Vertices_Get()); // the vertex buffer is quantized against it
 		Geometry_CreateBuffers();
 		m_normalizedScale	= Geometry_ComputeNormalizedScale();
 		m_memoryUsage		= Geometry_ComputeMemoryUsage();
-		m_aabb				= BoundingBox(m_mesh->Vertices_Get());
+
+		if (m_optimizationBefore.triangles != 0)
+		{
+			LOGF_INFO("Model::Geometry_Update: Optimized \"%s\", ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+				m_resourceName.c_str(),
+				m_optimizationBefore.GetACMR(), m_optimizationAfter.GetACMR(),
+				m_optimizationBefore.GetATVR(), m_optimizationAfter.GetATVR()
+			);
+			m_optimizationBefore	= MeshOptimizer_Statistics();
+			m_optimizationAfter		= MeshOptimizer_Statistics();
+		}
 	}
 
 	void Model::AddMaterial(const shared_ptr<Material>& material, const shared_ptr<Actor>& actor, bool autoCache /* true */)
@@ -188,32 +540,189 @@ namespace Directus
 			return;
 		}
 
-		// Try to get the texture
-		auto texName = FileSystem::GetFileNameNoExtensionFromFilePath(filePath);
-		auto texture = m_context->GetSubsystem<ResourceManager>()->GetResourceByName<RHI_Texture>(texName);
-		if (texture)
+		m_textureImports.push_back({ material, textureType, filePath });
+	}
+
+	void Model::ImportTextures()
+	{
+		// Textures are cached by name, so every name is imported once (from the first file with it), no matter how many materials use it
+		vector<string> names;
+		unordered_map<string, vector<const TextureImport*>> users;
+		for (const auto& textureImport : m_textureImports)
 		{
-			material->SetTextureSlot(textureType, texture, false);
+			auto texName	= FileSystem::GetFileNameNoExtensionFromFilePath(textureImport.filePath);
+			auto& nameUsers	= users[texName];
+			if (nameUsers.empty())
+			{
+				names.emplace_back(texName);
+			}
+			nameUsers.emplace_back(&textureImport);
 		}
-		// If we didn't get a texture, it's not cached, hence we have to load it and cache it now
-		else if (!texture)
+
+		auto AssignTexture = [&users](const string& texName, const shared_ptr<RHI_Texture>& texture)
+		{
+			for (const auto& textureImport : users[texName])
+			{
+				textureImport->material->SetTextureSlot(textureImport->type, texture, false);
+			}
+		};
+
+		// Textures with identical contents are shared, including ones saved by a previous session
+		auto ddc = m_resourceManager->GetDerivedDataCache();
+		auto GetTextureByContent = [this, ddc](unsigned long long key)
 		{
-			// Load texture
-			texture = make_shared<RHI_Texture>(m_context);
-			texture->LoadFromFile(filePath);
+			if (auto texture = m_resourceManager->GetResourceByContent<RHI_Texture>(key))
+				return texture;
+
+			auto filePath = ddc->Content_Get(key);
+			auto texture = !filePath.empty() ? m_resourceManager->Load<RHI_Texture>(filePath) : nullptr;
+			if (texture)
+			{
+				m_resourceManager->SetResourceContentKey(texture, key);
+			}
+			return texture;
+		};
 
-			// Update the texture with Model directory relative file path. Then save it to this directory
-			string modelRelativeTexPath = m_modelDirectoryTextures + texName + EXTENSION_TEXTURE;
-			texture->SetResourceFilePath(modelRelativeTexPath);
-			texture->SetResourceName(FileSystem::GetFileNameNoExtensionFromFilePath(modelRelativeTexPath));
-			texture->SaveToFile(modelRelativeTexPath);
-			// Now that the texture is saved, free up it's memory since we already have a shader resource
-			texture->ClearTextureBytes();
+		auto threading		= m_context->GetSubsystem<Threading>();
+		auto imageImp		= m_resourceManager->GetImageImporter();
+		unsigned int jobs	= 0;
+		_Model::TextureJobQueue queue;
+		TaskGroup group;
+		for (const auto& texName : names)
+		{
+			const string& filePath = users[texName].front()->filePath;
+			m_textureSourcePaths.emplace_back(filePath);
 
-			// Set the texture to the provided material
-			auto texWeak = texture->Cache<RHI_Texture>();
-			material->SetTextureSlot(textureType, texWeak, false);
+			// Try to get the texture
+			if (auto texture = m_resourceManager->GetResourceByName<RHI_Texture>(texName))
+			{
+				AssignTexture(texName, texture);
+				continue;
+			}
+
+			// If we didn't get a texture, it's not cached, hence we have to load it and cache it now
+			TextureType textureType	= users[texName].front()->type;
+			auto texture			= make_shared<RHI_Texture>(m_context);
+			// Color is stored as sRGB, its mips are filtered in linear space
+			texture->SetSRGB(textureType == TextureType_Albedo || textureType == TextureType_Emission);
+			texture->SetCompression(_Model::ComputeTextureCompression(textureType));
+			// Material textures only keep the mips they are seen at
+			texture->SetStreamed(true);
+
+			// Textures with identical contents are shared, no matter their name or location
+			auto sourceKey = ddc->ComputeKey(filePath, imageImp->GetSettingsHash(texture.get()));
+			if (auto shared = GetTextureByContent(sourceKey))
+			{
+				AssignTexture(texName, shared);
+				continue;
+			}
+
+			// Decoding, mip generation and compression happen on the worker threads
+			auto job		= make_shared<_Model::TextureJob>();
+			job->filePath	= filePath;
+			job->name		= texName;
+			job->texture	= texture;
+			job->sourceKey	= sourceKey;
+			jobs++;
+			threading->AddTask([job, &queue]()
+			{
+				job->loaded		= job->texture->LoadAsync_Read(job->filePath);
+				job->pixelKey	= job->loaded ? job->texture->ComputePixelHash() : 0;
+				queue.Push(job);
+			}, &group);
 		}
+
+		// The jobs are finished on this thread as they come back, the queue outlives them as this waits for all of them
+		unordered_map<unsigned long long, shared_ptr<_Model::TextureJob>> pixelOwners;
+		while (jobs != 0)
+		{
+			threading->WaitUntil([&queue]() { return !queue.IsEmpty(); }, &group);
+
+			deque<shared_ptr<_Model::TextureJob>> completed;
+			{
+				lock_guard<mutex> guard(queue.completedMutex);
+				completed.swap(queue.completed);
+			}
+			jobs -= (unsigned int)completed.size();
+
+			for (const auto& job : completed)
+			{
+				// Saved, it can be used now
+				if (job->saved)
+				{
+					auto texWeak = job->texture->Cache<RHI_Texture>();
+					m_resourceManager->SetResourceContentKey(texWeak, job->sourceKey);
+					m_resourceManager->SetResourceContentKey(texWeak, job->pixelKey);
+					ddc->Content_Set(job->sourceKey, texWeak->GetResourceFilePath());
+					ddc->Content_Set(job->pixelKey, texWeak->GetResourceFilePath());
+					AssignTexture(job->name, texWeak);
+					for (const auto& duplicate : job->duplicates)
+					{
+						m_resourceManager->SetResourceContentKey(texWeak, duplicate->sourceKey);
+						ddc->Content_Set(duplicate->sourceKey, texWeak->GetResourceFilePath());
+						AssignTexture(duplicate->name, texWeak);
+					}
+					continue;
+				}
+
+				if (!job->loaded)
+				{
+					LOGF_WARNING("Model::ImportTextures: Failed to import \"%s\"", job->filePath.c_str());
+					continue;
+				}
+
+				// Different source file, same pixels (e.g. a re-saved copy), checked before finalizing so only one of them is kept
+				if (auto shared = GetTextureByContent(job->pixelKey))
+				{
+					m_resourceManager->SetResourceContentKey(shared, job->sourceKey);
+					ddc->Content_Set(job->sourceKey, shared->GetResourceFilePath());
+					AssignTexture(job->name, shared);
+					continue;
+				}
+
+				// The same pixels are already being saved by another job of this model
+				auto owner = pixelOwners.find(job->pixelKey);
+				if (owner != pixelOwners.end())
+				{
+					job->texture = nullptr;
+					owner->second->duplicates.emplace_back(job);
+					continue;
+				}
+
+				if (!job->texture->LoadAsync_Finalize())
+				{
+					LOGF_WARNING("Model::ImportTextures: Failed to import \"%s\"", job->filePath.c_str());
+					continue;
+				}
+				pixelOwners[job->pixelKey] = job;
+
+				// Update the texture with Model directory relative file path. Then save it to this directory (which also frees its bytes)
+				string modelRelativeTexPath = m_modelDirectoryTextures + job->name + EXTENSION_TEXTURE;
+				job->texture->SetResourceFilePath(modelRelativeTexPath);
+				job->texture->SetResourceName(FileSystem::GetFileNameNoExtensionFromFilePath(modelRelativeTexPath));
+				jobs++;
+				threading->AddTask([job, &queue]()
+				{
+					job->texture->SaveToFile(job->texture->GetResourceFilePath());
+					job->saved = true;
+					queue.Push(job);
+				}, &group);
+			}
+		}
+		threading->Wait(&group); // the last tasks may still be finishing after handing over their job
+
+		// The materials were saved before they had their textures
+		unordered_set<Material*> materials;
+		for (const auto& textureImport : m_textureImports)
+		{
+			auto material = textureImport.material.get();
+			if (materials.insert(material).second && material->GetResourceFilePath() != NOT_ASSIGNED)
+			{
+				material->SaveToFile(material->GetResourceFilePath());
+			}
+		}
+
+		m_textureImports.clear();
 	}
 
 	void Model::SetWorkingDirectory(const string& directory)
@@ -236,16 +745,37 @@ namespace Directus
 		if (!file->IsOpen())
 			return false;
 
-		int meshCount = 0;
+		m_materialPaths.clear();
+		unsigned int version;
+		if (!_Model::ReadHeader(file.get(), &m_resourceName, &m_resourceFilePath, &m_normalizedScale, &m_materialPaths, &version))
+		{
+			LOGF_ERROR("Model::LoadFromEngineFormat: \"%s\" has an unsupported version", filePath.c_str());
+			return false;
+		}
+		m_resourceManager->SetDependencies(m_resourceFilePath, m_materialPaths);
+
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		_Model::ReadGeometry(file.get(), version, &m_mesh->Indices_Get(), &m_mesh->Vertices_Get());
+		m_isEvicted = false;
 
-		file->Read(&m_resourceName);
-		file->Read(&m_resourceFilePath);
-		file->Read(&m_normalizedScale);
-		file->Read(&m_mesh->Indices_Get());
-		file->Read(&m_mesh->Vertices_Get());
+		// Older files have no clusters or levels of detail, their renderables are drawn in full
+		m_clusters.clear();
+		m_lods.clear();
+		if (version >= 4)
+		{
+			_Model::ReadClusters(file.get(), &m_clusters);
+		}
+		if (version >= 5)
+		{
+			_Model::ReadLods(file.get(), &m_lods);
+		}
 
 		Geometry_Update();
 
+		// In sync with the file
+		m_isDirty		= false;
+		m_contentHash	= ComputeContentHash();
+
 		return true;
 	}
 
@@ -256,6 +786,13 @@ namespace Directus
 		SetResourceFilePath(m_modelDirectoryModel + FileSystem::GetFileNameNoExtensionFromFilePath(filePath) + EXTENSION_MODEL); // Assets/Sponza/Sponza.model
 		SetResourceName(FileSystem::GetFileNameNoExtensionFromFilePath(filePath)); // Sponza
 
+		// Use the data derived by a previous import of the same model (and the same textures), if any
+		auto ddc		= m_resourceManager->GetDerivedDataCache();
+		auto sourceKey	= ddc->ComputeKey(filePath, m_resourceManager->GetModelImporter()->GetSettingsHash());
+		auto key		= ddc->Dependencies_ComputeKey(sourceKey);
+		if (ddc->Contains(key) && DerivedData_Load(key))
+			return true;
+
 		// Load the model
 		if (m_resourceManager->GetModelImporter()->Load(std::dynamic_pointer_cast<Model>(GetSharedPtr()), filePath))
 		{
@@ -267,6 +804,18 @@ namespace Directus
 			// Save the model in our custom format.
 			SaveToFile(GetResourceFilePath());
 
+			// So the next import can skip the importer, unless the sidecar files it read or the textures it references change
+			auto dependencies = m_textureSourcePaths;
+			for (const auto& openedFilePath : m_resourceManager->GetModelImporter()->GetOpenedFilePaths())
+			{
+				if (FileSystem::GetRelativeFilePath(openedFilePath) != FileSystem::GetRelativeFilePath(filePath))
+				{
+					dependencies.emplace_back(openedFilePath);
+				}
+			}
+			ddc->Dependencies_Set(sourceKey, dependencies);
+			DerivedData_Store(ddc->Dependencies_ComputeKey(sourceKey));
+
 			return true;
 		}
 
@@ -277,14 +826,16 @@ namespace Directus
 	{
 		bool success = true;
 
-		// Get geometry
-		vector<unsigned int> indices			= m_mesh->Indices_Get();
-		vector<RHI_Vertex_PosUVTBN> vertices	= m_mesh->Vertices_Get();
+		// Get geometry, the vertex buffer holds the quantized vertices
+		const vector<unsigned int>& indices = m_mesh->Indices_Get();
+		vector<RHI_Vertex_PosUVTBN_Quantized> vertices;
+		Utility::Quantization::Quantize(m_mesh->Vertices_Get(), m_aabb, &vertices);
 
 		if (!indices.empty())
 		{
 			m_indexBuffer = make_shared<RHI_IndexBuffer>(m_rhiDevice);
-			if (!m_indexBuffer->Create(indices))
+			bool created = _Model::IndicesFit16Bits(indices) ? m_indexBuffer->Create(vector<unsigned short>(indices.begin(), indices.end())) : m_indexBuffer->Create(indices);
+			if (!created)
 			{
 				LOGF_ERROR("Model::Geometry_CreateBuffers: Failed to create index buffer for \"%s\".", m_resourceName.c_str());
 				success = false;
@@ -323,15 +874,165 @@ namespace Directus
 		return 1.0f / scaleOffset;
 	}
 
-	unsigned int Model::Geometry_ComputeMemoryUsage()
+	unsigned long long Model::Geometry_ComputeMemoryUsage()
 	{
-		// Vertices & Indices
-		unsigned int size = !m_mesh ? 0 : m_mesh->Geometry_MemoryUsage();
+		// Vertices & Indices (the GPU buffers aren't counted, eviction keeps them)
+		unsigned long long size = !m_mesh ? 0 : m_mesh->Geometry_MemoryUsage();
 
-		// Buffers
-		size += m_vertexBuffer->GetMemoryUsage();
-		size += m_indexBuffer->GetMemoryUsage();
+		// Clusters & levels of detail
+		size += m_clusters.size() * sizeof(Mesh_Cluster);
+		size += m_lods.size() * sizeof(Mesh_Lod);
 
 		return size;
 	}
-}
+
+	void Model::Geometry_Reload()
+	{
+		if (!m_isEvicted)
+			return;
+
+		// Evicted until the geometry has been read, so no other caller sees an empty mesh as resident
+		lock_guard<recursive_mutex> guard(m_evictionMutex);
+		if (!m_isEvicted)
+			return;
+
+		auto file = make_unique<FileStream>(m_resourceFilePath, FileStreamMode_Read);
+		if (!file->IsOpen())
+		{
+			LOGF_ERROR("Model::Geometry_Reload: Failed to reload geometry of \"%s\".", m_resourceName.c_str());
+			m_isEvicted = false;
+			return;
+		}
+
+		// Skip the properties, they are already loaded
+		string name, filePath;
+		float normalizedScale;
+		vector<string> dependencies;
+		unsigned int version;
+		_Model::ReadHeader(file.get(), &name, &filePath, &normalizedScale, &dependencies, &version);
+		_Model::ReadGeometry(file.get(), version, &m_mesh->Indices_Get(), &m_mesh->Vertices_Get());
+
+		m_memoryUsage	= Geometry_ComputeMemoryUsage();
+		m_isEvicted		= false;
+	}
+
+	bool Model::DerivedData_Load(unsigned long long key)
+	{
+		auto directory = m_resourceManager->GetDerivedDataCache()->GetEntryDirectory(key);
+
+		// Restore the files the importer would have written
+		bool restored = FileSystem::CopyFileFromTo(directory + "Model" + EXTENSION_MODEL, GetResourceFilePath());
+		restored &= DerivedDataCache::Entry_CopyFiles(directory + "Materials//", m_modelDirectoryMaterials);
+		restored &= DerivedDataCache::Entry_CopyFiles(directory + "Textures//", m_modelDirectoryTextures);
+
+		// Textures shared with other models go back to where the materials expect them, unless they are still there
+		{
+			vector<string> sharedTexturePaths;
+			auto sharedFile = make_unique<FileStream>(directory + "SharedTextures.paths", FileStreamMode_Read);
+			restored &= sharedFile->IsOpen();
+			if (sharedFile->IsOpen())
+			{
+				sharedFile->Read(&sharedTexturePaths);
+			}
+			for (unsigned int i = 0; i < (unsigned int)sharedTexturePaths.size(); i++)
+			{
+				const auto& texturePath = sharedTexturePaths[i];
+				if (FileSystem::FileExists(texturePath))
+					continue;
+
+				restored &= DerivedDataCache::Entry_CopyFile(directory + "SharedTextures//" + to_string(i) + EXTENSION_TEXTURE, texturePath);
+			}
+		}
+
+		auto file = make_unique<FileStream>(directory + "Hierarchy" + EXTENSION_PREFAB, FileStreamMode_Read);
+		if (!restored || !file->IsOpen() || !LoadFromEngineFormat(GetResourceFilePath()))
+		{
+			LOGF_WARNING("Model::DerivedData_Load: Failed to restore \"%s\", it will be imported instead.", m_resourceName.c_str());
+			return false;
+		}
+
+		// Renderables find their model and materials by name
+		m_resourceManager->Add(GetSharedPtr());
+		for (const auto& filePath : FileSystem::GetFilesInDirectory(m_modelDirectoryMaterials))
+		{
+			if (!FileSystem::IsEngineMaterialFile(filePath))
+				continue;
+
+			if (auto material = m_resourceManager->Load<Material>(filePath))
+			{
+				m_materials.emplace_back(material);
+			}
+		}
+
+		// Actor hierarchy
+		FIRE_EVENT(EVENT_WORLD_STOP);
+		auto& rootActor = m_context->GetSubsystem<World>()->Actor_Create();
+		rootActor->Deserialize(file.get(), nullptr);
+		_Model::RegenerateIDs(rootActor.get());
+		m_rootActor = rootActor;
+		FIRE_EVENT(EVENT_WORLD_START);
+
+		LOGF_INFO("Model::DerivedData_Load: Restored \"%s\" from the derived data cache", m_resourceName.c_str());
+		return true;
+	}
+
+	void Model::DerivedData_Store(unsigned long long key)
+	{
+		auto rootActor = m_rootActor.lock();
+		if (key == 0 || !rootActor)
+			return;
+
+		auto ddc		= m_resourceManager->GetDerivedDataCache();
+		auto directory	= ddc->Entry_Begin(key);
+
+		// Everything the importer wrote
+		bool stored = FileSystem::CopyFileFromTo(GetResourceFilePath(), directory + "Model" + EXTENSION_MODEL);
+		stored &= DerivedDataCache::Entry_CopyFiles(m_modelDirectoryMaterials, directory + "Materials//");
+		stored &= DerivedDataCache::Entry_CopyFiles(m_modelDirectoryTextures, directory + "Textures//");
+
+		// Textures shared with other models live in their directories, they are kept along with their paths
+		vector<string> sharedTexturePaths;
+		for (const auto& materialWeak : m_materials)
+		{
+			auto material = materialWeak.lock();
+			if (!material)
+				continue;
+
+			for (const auto& texturePath : material->GetTexturePaths())
+			{
+				bool isShared = FileSystem::GetDirectoryFromFilePath(texturePath) != m_modelDirectoryTextures;
+				if (isShared && find(sharedTexturePaths.begin(), sharedTexturePaths.end(), texturePath) == sharedTexturePaths.end())
+				{
+					sharedTexturePaths.emplace_back(texturePath);
+				}
+			}
+		}
+		for (unsigned int i = 0; i < (unsigned int)sharedTexturePaths.size(); i++)
+		{
+			stored &= FileSystem::CopyFileFromTo(sharedTexturePaths[i], directory + "SharedTextures//" + to_string(i) + EXTENSION_TEXTURE);
+		}
+		{
+			auto file = make_unique<FileStream>(directory + "SharedTextures.paths", FileStreamMode_Write, true);
+			stored &= file->IsOpen();
+			if (file->IsOpen())
+			{
+				file->Write(sharedTexturePaths);
+			}
+		}
+
+		// Actor hierarchy
+		{
+			auto file = make_unique<FileStream>(directory + "Hierarchy" + EXTENSION_PREFAB, FileStreamMode_Write, true);
+			stored &= file->IsOpen();
+			if (file->IsOpen())
+			{
+				rootActor->Serialize(file.get());
+			}
+		}
+
+		if (stored)
+		{
+			ddc->Entry_Commit(key);
+		}
+	}
+}
\ No newline at end of file
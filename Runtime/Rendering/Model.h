@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Definition.h"
 #include "../Resource/IResource.h"
 #include "../Math/BoundingBox.h"
+#include "../Resource/Import/MeshOptimizer.h"
 #include "Material.h"
 //================================
 
@@ -51,13 +52,21 @@ namespace Directus
 		//= RESOURCE INTERFACE =========================================
 		bool LoadFromFile(const std::string& filePath) override;
 		bool SaveToFile(const std::string& filePath) override;
-		unsigned int GetMemoryUsage() override { return m_memoryUsage; }
+		unsigned long long ComputeContentHash() override;
+		unsigned long long GetMemoryUsage() override { return m_memoryUsage; }
+		unsigned long long Evict() override;
+		std::vector<std::string> GetDependencies() override;
 		//==============================================================
 
+		// Reads the dependencies of a model file without loading it
+		static bool ReadDependencies(const std::string& filePath, std::vector<std::string>* dependencies);
+
 		// Sets the actor that represents this model in the scene
 		void SetRootActor(const std::shared_ptr<Actor>& actor) { m_rootActor = actor; }
 
 		//= GEOMTETRY =============================================
+		// Appended geometry is optimized (see MeshOptimizer), the indices and vertices are reordered in place.
+		// Its levels of detail are appended to the index buffer after it, so indexOffset is all a renderable needs to find them.
 		void Geometry_Append(
 			std::vector<unsigned int>& indices,
 			std::vector<RHI_Vertex_PosUVTBN>& vertices,
@@ -74,6 +83,10 @@ namespace Directus
 		);
 		void Geometry_Update();
 		const Math::BoundingBox& Geometry_AABB() { return m_aabb; }
+		// Clusters of every submesh, sorted by index offset
+		const std::vector<Mesh_Cluster>& Geometry_Clusters() { return m_clusters; }
+		// Levels of detail of every submesh, sorted by the index offset of their submesh and then from the most to the least detailed
+		const std::vector<Mesh_Lod>& Geometry_Lods() { return m_lods; }
 		//=========================================================
 
 		// Adds a new material
@@ -82,8 +95,10 @@ namespace Directus
 		// Adds a new animation
 		std::shared_ptr<Animation> AddAnimation(const std::shared_ptr<Animation>& animation);
 
-		// Adds a texture (the material that uses this texture must be passed as well)
+		// Adds a texture (the material that uses this texture must be passed as well), it's imported by ImportTextures()
 		void AddTexture(const std::shared_ptr<Material>& material, TextureType textureType, const std::string& filePath);
+		// Imports the added textures in parallel, each material gets a texture as soon as it has been imported
+		void ImportTextures();
 
 		bool IsAnimated() { return m_isAnimated; }
 		void SetAnimated(bool isAnimated) { m_isAnimated = isAnimated; }
@@ -101,7 +116,13 @@ namespace Directus
 		// Geometry
 		bool Geometry_CreateBuffers();
 		float Geometry_ComputeNormalizedScale();
-		unsigned int Geometry_ComputeMemoryUsage();
+		unsigned long long Geometry_ComputeMemoryUsage();
+		// Reloads evicted vertices and indices from the engine format
+		void Geometry_Reload();
+
+		// Derived data cache
+		bool DerivedData_Load(unsigned long long key);
+		void DerivedData_Store(unsigned long long key);
 
 		// The root actor that represents this model in the scene
 		std::weak_ptr<Actor> m_rootActor;
@@ -111,10 +132,29 @@ namespace Directus
 		std::shared_ptr<RHI_IndexBuffer> m_indexBuffer;
 		std::shared_ptr<Mesh> m_mesh;
 		Math::BoundingBox m_aabb;
+		std::vector<Mesh_Cluster> m_clusters;
+		std::vector<Mesh_Lod> m_lods;
+		// Of the vertices and indices when they were last resident
+		unsigned long long m_geometryHash = 0;
 		unsigned int meshCount;
+		// Of the geometry appended since the last Geometry_Update()
+		MeshOptimizer_Statistics m_optimizationBefore;
+		MeshOptimizer_Statistics m_optimizationAfter;
 
 		// Material
 		std::vector<std::weak_ptr<Material>> m_materials;
+		std::vector<std::string> m_materialPaths; // as recorded in the file
+
+		// Textures waiting for ImportTextures()
+		struct TextureImport
+		{
+			std::shared_ptr<Material> material;
+			TextureType type;
+			std::string filePath;
+		};
+		std::vector<TextureImport> m_textureImports;
+		// The source files of the imported textures, the derived data of the model depends on them
+		std::vector<std::string> m_textureSourcePaths;
 
 		// Animations
 		std::vector<std::weak_ptr<Animation>> m_animations;
@@ -126,7 +166,7 @@ namespace Directus
 
 		// Misc
 		float m_normalizedScale;
-		unsigned int m_memoryUsage;		
+		unsigned long long m_memoryUsage;
 		bool m_isAnimated;
 		ResourceManager* m_resourceManager;
 		std::shared_ptr<RHI_Device> m_rhiDevice;	
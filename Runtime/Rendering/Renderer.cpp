@@ -29,6 +29,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Deferred/LightShader.h"
 #include "Deferred/GBuffer.h"
 #include "Utilities/Sampling.h"
+#include "Utilities/Quantization.h"
 #include "../RHI/RHI_Device.h"
 #include "../RHI/RHI_CommonBuffers.h"
 #include "../RHI/RHI_VertexBuffer.h"
@@ -154,6 +155,7 @@ namespace Directus
 		m_texWhite = make_shared<RHI_Texture>(m_context);
 		m_texWhite->SetNeedsMipChain(false);
 		m_texWhite->LoadFromFile(textureDirectory + "white.png");
+		g_resourceMng->SetPlaceholder(Resource_Texture, m_texWhite); // shown while textures load asynchronously
 
 		m_texBlack = make_shared<RHI_Texture>(m_context);
 		m_texBlack->SetNeedsMipChain(false);
@@ -181,7 +183,7 @@ namespace Directus
 
 		// G-Buffer
 		m_shaderGBuffer = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderGBuffer->CompileVertex(shaderDirectory + "GBuffer.hlsl", Input_PositionTextureTBN);
+		m_shaderGBuffer->CompileVertex(shaderDirectory + "GBuffer.hlsl", Input_PositionTextureTBN_Quantized);
 
 		// Light
 		m_shaderLight = make_shared<LightShader>(m_rhiDevice);
@@ -189,12 +191,12 @@ namespace Directus
 
 		// Transparent
 		m_shaderTransparent = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderTransparent->CompileVertexPixel(shaderDirectory + "Transparent.hlsl", Input_PositionTextureTBN);
+		m_shaderTransparent->CompileVertexPixel(shaderDirectory + "Transparent.hlsl", Input_PositionTextureTBN_Quantized);
 		m_shaderTransparent->AddBuffer<Struct_Transparency>();
 
 		// Depth
 		m_shaderLightDepth = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderLightDepth->CompileVertexPixel(shaderDirectory + "ShadowingDepth.hlsl", Input_Position);
+		m_shaderLightDepth->CompileVertexPixel(shaderDirectory + "ShadowingDepth.hlsl", Input_PositionTextureTBN_Quantized);
 
 		// Font
 		m_shaderFont = make_shared<RHI_Shader>(m_rhiDevice);
@@ -203,7 +205,7 @@ namespace Directus
 
 		// Transform gizmo
 		m_shaderTransformGizmo = make_shared<RHI_Shader>(m_rhiDevice);
-		m_shaderTransformGizmo->CompileVertexPixel(shaderDirectory + "TransformGizmo.hlsl", Input_PositionTextureTBN);
+		m_shaderTransformGizmo->CompileVertexPixel(shaderDirectory + "TransformGizmo.hlsl", Input_PositionTextureTBN_Quantized);
 		m_shaderTransformGizmo->AddBuffer<Struct_Matrix_Vector3>();
 
 		// SSAO
@@ -384,6 +386,8 @@ namespace Directus
 			m_viewProjection_Orthographic	= m_viewBase * m_projectionOrthographic;
 		}
 
+		Renderables_SelectLods();
+
 		Pass_DepthDirectionalLight(GetLightDirectional());
 		
 		Pass_GBuffer();
@@ -646,6 +650,22 @@ namespace Directus
 			return a_key < b_key;
 		});
 	}
+
+	void Renderer::Renderables_SelectLods()
+	{
+		// Shadows use the levels the camera sees, so they match what's drawn
+		auto screenHeight = (float)Settings::Get().Resolution_GetHeight();
+		for (auto type : { Renderable_ObjectOpaque, Renderable_ObjectTransparent })
+		{
+			for (const auto& actor : m_actors[type])
+			{
+				if (auto renderable = actor->GetRenderable_PtrRaw())
+				{
+					renderable->Geometry_SelectLod(m_camera, screenHeight);
+				}
+			}
+		}
+	}
 	//==========================================================================================================
 
 	//= PASSES =================================================================================================
@@ -713,8 +733,8 @@ namespace Directus
 					currentlyBoundGeometry = geometry->Resource_GetID();
 				}
 
-				SetGlobalBuffer(actor->GetTransform_PtrRaw()->GetMatrix() * light->GetViewMatrix() * light->ShadowMap_GetProjectionMatrix(i));
-				m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
+				SetGlobalBuffer(Utility::Quantization::DequantizationMatrix(geometry->Geometry_AABB()) * actor->GetTransform_PtrRaw()->GetMatrix() * light->GetViewMatrix() * light->ShadowMap_GetProjectionMatrix(i));
+				m_rhiPipeline->DrawIndexed(renderable->Geometry_LodIndexCount(), renderable->Geometry_LodIndexOffset(), renderable->Geometry_VertexOffset());
 			}
 			m_rhiDevice->EventEnd();
 		}
@@ -746,6 +766,7 @@ namespace Directus
 		unsigned int currentlyBoundGeometry = 0;
 		unsigned int currentlyBoundShader	= 0;
 		unsigned int currentlyBoundMaterial = 0;
+		vector<pair<unsigned int, unsigned int>> clusterRanges;
 
 		for (auto actor : m_actors[Renderable_ObjectOpaque])
 		{
@@ -806,11 +827,21 @@ namespace Directus
 			}
 
 			// UPDATE PER OBJECT BUFFER
-			shader->UpdatePerObjectBuffer(actor->GetTransform_PtrRaw(), material, m_view, m_projection);			
+			shader->UpdatePerObjectBuffer(actor->GetTransform_PtrRaw(), material, model->Geometry_AABB(), m_view, m_projection);			
 			m_rhiPipeline->SetConstantBuffer(shader->GetPerObjectBuffer(), 1, Buffer_Global);
 
-			// Render	
-			m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
+			// Render, only the visible clusters of geometry which is split into clusters (and not simplified)
+			if (renderable->Geometry_CullClusters(m_camera, material->GetCullMode() == Cull_Back, &clusterRanges))
+			{
+				for (const auto& range : clusterRanges)
+				{
+					m_rhiPipeline->DrawIndexed(range.second, range.first, renderable->Geometry_VertexOffset());
+				}
+			}
+			else
+			{
+				m_rhiPipeline->DrawIndexed(renderable->Geometry_LodIndexCount(), renderable->Geometry_LodIndexOffset(), renderable->Geometry_VertexOffset());
+			}
 			Profiler::Get().m_rendererMeshesRendered++;
 
 		} // Actor/MESH ITERATION
@@ -864,6 +895,8 @@ namespace Directus
 		TIME_BLOCK_START_MULTI();
 		m_rhiDevice->EventBegin("Pass_Light");
 
+		auto skybox = GetSkybox();
+
 		// Update constant buffer
 		m_shaderLight->UpdateConstantBuffer
 		(
@@ -871,7 +904,8 @@ namespace Directus
 			m_view,
 			m_projection,
 			m_actors[Renderable_Light],
-			Flags_IsSet(Render_PostProcess_SSR)
+			Flags_IsSet(Render_PostProcess_SSR),
+			skybox ? &skybox->GetIrradianceSH() : nullptr
 		);
 
 		m_rhiPipeline->SetRenderTarget(texOut);
@@ -885,8 +919,9 @@ namespace Directus
 		if (Flags_IsSet(Render_PostProcess_SSAO)) { m_rhiPipeline->SetTexture(texSSAO); }
 		else { m_rhiPipeline->SetTexture(m_texBlack); }
 		m_rhiPipeline->SetTexture(m_renderTexFull_HDR_Light2); // SSR
-		m_rhiPipeline->SetTexture(GetSkybox() ? GetSkybox()->GetTexture() : m_texWhite);
+		m_rhiPipeline->SetTexture(skybox ? skybox->GetTexture() : m_texWhite);
 		m_rhiPipeline->SetTexture(m_tex_lutIBL);
+		m_rhiPipeline->SetTexture((skybox && skybox->GetSpecularTexture()) ? skybox->GetSpecularTexture() : m_texWhite);
 		m_rhiPipeline->SetSampler(m_samplerTrilinearClamp);
 		m_rhiPipeline->SetSampler(m_samplerPointClamp);
 		m_rhiPipeline->SetConstantBuffer(m_shaderLight->GetConstantBuffer(), 1, Buffer_Global);
@@ -946,11 +981,12 @@ namespace Directus
 				material->GetColorAlbedo(),
 				m_camera->GetTransform()->GetPosition(),
 				GetLightDirectional()->GetDirection(),
+				model->Geometry_AABB(),
 				material->GetRoughnessMultiplier()
 			);
 			m_shaderTransparent->UpdateBuffer(&buffer);
 			m_rhiPipeline->SetConstantBuffer(m_shaderTransparent->GetConstantBuffer(), 1, Buffer_Global);
-			m_rhiPipeline->DrawIndexed(renderable->Geometry_IndexCount(), renderable->Geometry_IndexOffset(), renderable->Geometry_VertexOffset());
+			m_rhiPipeline->DrawIndexed(renderable->Geometry_LodIndexCount(), renderable->Geometry_LodIndexOffset(), renderable->Geometry_VertexOffset());
 
 			Profiler::Get().m_rendererMeshesRendered++;
 
@@ -1532,17 +1568,17 @@ namespace Directus
 			m_rhiPipeline->SetVertexBuffer(m_transformGizmo->GetVertexBuffer());		
 
 			// X - Axis		
-			auto buffer = Struct_Matrix_Vector3(m_transformGizmo->GetTransformX() * m_viewProjection, Vector3::Right);
+			auto buffer = Struct_Matrix_Vector3(m_transformGizmo->GetDequantization() * m_transformGizmo->GetTransformX() * m_viewProjection, Vector3::Right);
 			m_shaderTransformGizmo->UpdateBuffer(&buffer);
 			m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
 
 			// Y - Axis		
-			buffer = Struct_Matrix_Vector3(m_transformGizmo->GetTransformY() * m_viewProjection, Vector3::Up);
+			buffer = Struct_Matrix_Vector3(m_transformGizmo->GetDequantization() * m_transformGizmo->GetTransformY() * m_viewProjection, Vector3::Up);
 			m_shaderTransformGizmo->UpdateBuffer(&buffer);
 			m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
 
 			// Z - Axis		
-			buffer = Struct_Matrix_Vector3(m_transformGizmo->GetTransformZ() * m_viewProjection, Vector3::Forward);
+			buffer = Struct_Matrix_Vector3(m_transformGizmo->GetDequantization() * m_transformGizmo->GetTransformZ() * m_viewProjection, Vector3::Forward);
 			m_shaderTransformGizmo->UpdateBuffer(&buffer);
 			m_rhiPipeline->DrawIndexed(m_transformGizmo->GetIndexCount(), 0, 0);
 
@@ -157,6 +157,7 @@ namespace Directus
 		);
 		void Renderables_Acquire(const Variant& renderables);
 		void Renderables_Sort(std::vector<Actor*>* renderables);
+		void Renderables_SelectLods();
 
 		//= PASSES ==============================================================================================================================================
 		void Pass_DepthDirectionalLight(Light* directionalLight);
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "..\RHI\RHI_Vertex.h"
 #include "..\RHI\RHI_IndexBuffer.h"
 #include "..\Rendering\Utilities\Geometry.h"
+#include "..\Rendering\Utilities\Quantization.h"
 #include "..\Rendering\Model.h"
 #include "..\World\Components\Transform.h"
 #include "..\World\Actor.h"
@@ -118,6 +119,20 @@ namespace Directus
 		return 0;
 	}
 
+	Matrix TransformGizmo::GetDequantization()
+	{
+		if (m_type == TransformGizmo_Position)
+		{
+			return Utility::Quantization::DequantizationMatrix(m_positionModel->Geometry_AABB());
+		}
+		else if (m_type == TransformGizmo_Scale)
+		{
+			return Utility::Quantization::DequantizationMatrix(m_scaleModel->Geometry_AABB());
+		}
+
+		return Matrix::Identity;
+	}
+
 	shared_ptr<RHI_VertexBuffer> TransformGizmo::GetVertexBuffer()
 	{
 		if (m_type == TransformGizmo_Position)
@@ -59,6 +59,8 @@ namespace Directus
 		const Math::Matrix& GetTransformY() { return m_transformY; }
 		const Math::Matrix& GetTransformZ() { return m_transformZ; }
 		unsigned int GetIndexCount();
+		// The vertex buffers hold quantized positions
+		Math::Matrix GetDequantization();
 		std::shared_ptr<RHI_VertexBuffer> GetVertexBuffer();
 		std::shared_ptr<RHI_IndexBuffer> GetIndexBuffer();
 
@@ -0,0 +1,133 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ====================
+#include <vector>
+#include "../../RHI/RHI_Vertex.h"
+#include "../../Math/MathHelper.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/BoundingBox.h"
+//===============================
+
+namespace Directus::Utility::Quantization
+{
+	// Projects a unit vector onto an octahedron and unfolds it into a square, stored as two snorm16
+	inline void OctahedronEncode(const Math::Vector3& vector, short* encoded)
+	{
+		float sum = fabs(vector.x) + fabs(vector.y) + fabs(vector.z);
+		if (sum == 0.0f)
+		{
+			encoded[0] = 0;
+			encoded[1] = 0;
+			return;
+		}
+
+		float x = vector.x / sum;
+		float y = vector.y / sum;
+		if (vector.z < 0.0f)
+		{
+			float foldedX = (1.0f - fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float foldedY = (1.0f - fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldedX;
+			y = foldedY;
+		}
+
+		encoded[0] = (short)Math::Helper::Round(Math::Helper::Clamp(x, -1.0f, 1.0f) * 32767.0f);
+		encoded[1] = (short)Math::Helper::Round(Math::Helper::Clamp(y, -1.0f, 1.0f) * 32767.0f);
+	}
+
+	// Same as OctahedronDecode() in Vertex.hlsl
+	inline Math::Vector3 OctahedronDecode(const short* encoded)
+	{
+		Math::Vector3 vector;
+		vector.x = Math::Helper::Max(encoded[0] / 32767.0f, -1.0f);
+		vector.y = Math::Helper::Max(encoded[1] / 32767.0f, -1.0f);
+		vector.z = 1.0f - fabs(vector.x) - fabs(vector.y);
+
+		float fold = Math::Helper::Clamp(-vector.z, 0.0f, 1.0f);
+		vector.x += vector.x >= 0.0f ? -fold : fold;
+		vector.y += vector.y >= 0.0f ? -fold : fold;
+
+		return vector.Normalized();
+	}
+
+	// Positions become unorm16 relative to the bounds, the bitangent is reduced to a sign (derived from the normal and the tangent)
+	inline void Quantize(const std::vector<RHI_Vertex_PosUVTBN>& vertices, const Math::BoundingBox& bounds, std::vector<RHI_Vertex_PosUVTBN_Quantized>* quantized)
+	{
+		const Math::Vector3& min	= bounds.GetMin();
+		Math::Vector3 size			= bounds.GetSize();
+		float scale[3]				=
+		{
+			size.x > 0.0f ? 65535.0f / size.x : 0.0f,
+			size.y > 0.0f ? 65535.0f / size.y : 0.0f,
+			size.z > 0.0f ? 65535.0f / size.z : 0.0f
+		};
+
+		quantized->clear();
+		quantized->resize(vertices.size());
+		for (unsigned int i = 0; i < (unsigned int)vertices.size(); i++)
+		{
+			const auto& vertex	= vertices[i];
+			auto& result		= (*quantized)[i];
+
+			result.pos[0] = (unsigned short)Math::Helper::Clamp(Math::Helper::Round((vertex.pos[0] - min.x) * scale[0]), 0.0f, 65535.0f);
+			result.pos[1] = (unsigned short)Math::Helper::Clamp(Math::Helper::Round((vertex.pos[1] - min.y) * scale[1]), 0.0f, 65535.0f);
+			result.pos[2] = (unsigned short)Math::Helper::Clamp(Math::Helper::Round((vertex.pos[2] - min.z) * scale[2]), 0.0f, 65535.0f);
+
+			result.uv[0] = Math::Helper::FloatToHalf(vertex.uv[0]);
+			result.uv[1] = Math::Helper::FloatToHalf(vertex.uv[1]);
+
+			Math::Vector3 normal(vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+			Math::Vector3 tangent(vertex.tangent[0], vertex.tangent[1], vertex.tangent[2]);
+			Math::Vector3 bitangent(vertex.bitangent[0], vertex.bitangent[1], vertex.bitangent[2]);
+			OctahedronEncode(normal, result.normal);
+			OctahedronEncode(tangent, result.tangent);
+			result.pos[3] = Math::Vector3::Dot(Math::Vector3::Cross(normal, tangent), bitangent) < 0.0f ? 0 : 65535;
+		}
+	}
+
+	inline void Dequantize(const std::vector<RHI_Vertex_PosUVTBN_Quantized>& quantized, const Math::BoundingBox& bounds, std::vector<RHI_Vertex_PosUVTBN>* vertices)
+	{
+		const Math::Vector3& min	= bounds.GetMin();
+		Math::Vector3 scale			= bounds.GetSize() / 65535.0f;
+
+		vertices->clear();
+		vertices->reserve(quantized.size());
+		for (const auto& vertex : quantized)
+		{
+			Math::Vector3 position(vertex.pos[0] * scale.x + min.x, vertex.pos[1] * scale.y + min.y, vertex.pos[2] * scale.z + min.z);
+			Math::Vector2 uv(Math::Helper::HalfToFloat(vertex.uv[0]), Math::Helper::HalfToFloat(vertex.uv[1]));
+			Math::Vector3 normal		= OctahedronDecode(vertex.normal);
+			Math::Vector3 tangent		= OctahedronDecode(vertex.tangent);
+			Math::Vector3 bitangent		= Math::Vector3::Cross(normal, tangent) * (vertex.pos[3] ? 1.0f : -1.0f);
+
+			vertices->emplace_back(position, uv, normal, tangent, bitangent);
+		}
+	}
+
+	// Takes quantized positions back to model space (to be combined with the world matrix)
+	inline Math::Matrix DequantizationMatrix(const Math::BoundingBox& bounds)
+	{
+		return Math::Matrix::CreateScale(bounds.GetSize()) * Math::Matrix::CreateTranslation(bounds.GetMin());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "DerivedDataCache.h"
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include "../Core/Hash.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/FileWatcher.h"
+#include "../Logging/Log.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _DerivedDataCache
+	{
+		// Bump when the layout of entries changes
+		static const unsigned int version = 1;
+		// Written last, an entry without it was interrupted
+		static const char* markerFileName = "entry.complete";
+		static const char* dependenciesExtension = ".dependencies";
+		static const char* contentExtension = ".content";
+
+		bool HashFile(const string& filePath, unsigned long long* hash)
+		{
+			// Files in mounted archives are hashed in place
+			const std::byte* data	= nullptr;
+			size_t size				= 0;
+			if (FileSystem::GetMountedFile(filePath, &data, &size))
+			{
+				*hash = Hash::Compute(data, size);
+				return true;
+			}
+
+			ifstream file(filePath, ios::binary | ios::ate);
+			if (!file.is_open())
+				return false;
+
+			vector<char> bytes((size_t)file.tellg());
+			file.seekg(0, ios::beg);
+			file.read(bytes.data(), bytes.size());
+			*hash = Hash::Compute(bytes.data(), bytes.size());
+			return true;
+		}
+	}
+
+	DerivedDataCache::DerivedDataCache(const string& directory)
+	{
+		m_directory = directory;
+		if (!FileSystem::DirectoryExists(m_directory))
+		{
+			FileSystem::CreateDirectory_(m_directory);
+		}
+	}
+
+	unsigned long long DerivedDataCache::ComputeKey(const string& sourceFilePath, unsigned long long settingsHash)
+	{
+		unsigned long long hash = 0;
+		if (!_DerivedDataCache::HashFile(sourceFilePath, &hash))
+		{
+			LOGF_WARNING("DerivedDataCache::ComputeKey: Failed to read \"%s\".", sourceFilePath.c_str());
+			return 0;
+		}
+
+		hash = Hash::Combine(hash, settingsHash);
+		hash = Hash::Combine(hash, Hash::Compute(ENGINE_VERSION));
+		hash = Hash::Combine(hash, Hash::ComputeValue(_DerivedDataCache::version));
+
+		// 0 means "no key"
+		return hash != 0 ? hash : 1;
+	}
+
+	void DerivedDataCache::Dependencies_Set(unsigned long long key, const vector<string>& filePaths)
+	{
+		if (key == 0)
+			return;
+
+		lock_guard<mutex> guard(m_mutex);
+
+		// Kept next to the entries, the entry itself is keyed by the content of the dependencies
+		ofstream file(Dependencies_GetFilePath(key), ios::out | ios::trunc);
+		for (const auto& dependency : filePaths)
+		{
+			file << dependency << "\n";
+		}
+	}
+
+	unsigned long long DerivedDataCache::Dependencies_ComputeKey(unsigned long long key)
+	{
+		if (key == 0)
+			return 0;
+
+		vector<string> filePaths;
+		{
+			lock_guard<mutex> guard(m_mutex);
+
+			ifstream file(Dependencies_GetFilePath(key));
+			string line;
+			while (getline(file, line))
+			{
+				if (!line.empty())
+				{
+					filePaths.emplace_back(line);
+				}
+			}
+		}
+
+		// A dependency which can't be read counts as well, it might show up later
+		for (const auto& filePath : filePaths)
+		{
+			unsigned long long hash = 0;
+			_DerivedDataCache::HashFile(filePath, &hash);
+			key = Hash::Combine(key, Hash::Combine(Hash::Compute(filePath), hash));
+		}
+
+		return key != 0 ? key : 1;
+	}
+
+	string DerivedDataCache::Dependencies_GetFilePath(unsigned long long key)
+	{
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", key);
+		return m_directory + name + _DerivedDataCache::dependenciesExtension;
+	}
+
+	void DerivedDataCache::Content_Set(unsigned long long key, const string& filePath)
+	{
+		if (key == 0)
+			return;
+
+		// The hash tells the file apart from a different one at the same path (e.g. in another project)
+		unsigned long long hash = 0;
+		if (!_DerivedDataCache::HashFile(filePath, &hash))
+			return;
+
+		lock_guard<mutex> guard(m_mutex);
+
+		ofstream file(Content_GetFilePath(key), ios::out | ios::trunc);
+		file << FileSystem::GetRelativeFilePath(filePath) << "\n" << hash;
+	}
+
+	string DerivedDataCache::Content_Get(unsigned long long key)
+	{
+		if (key == 0)
+			return "";
+
+		string filePath;
+		unsigned long long hashRecorded = 0;
+		{
+			lock_guard<mutex> guard(m_mutex);
+
+			ifstream file(Content_GetFilePath(key));
+			getline(file, filePath);
+			file >> hashRecorded;
+		}
+
+		// The file may have been deleted or changed since
+		unsigned long long hash = 0;
+		if (filePath.empty() || !_DerivedDataCache::HashFile(filePath, &hash) || hash != hashRecorded)
+			return "";
+
+		return filePath;
+	}
+
+	string DerivedDataCache::Content_GetFilePath(unsigned long long key)
+	{
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", key);
+		return m_directory + name + _DerivedDataCache::contentExtension;
+	}
+
+	bool DerivedDataCache::Contains(unsigned long long key)
+	{
+		if (key == 0)
+			return false;
+
+		return FileSystem::FileExists(GetEntryDirectory(key) + _DerivedDataCache::markerFileName);
+	}
+
+	string DerivedDataCache::GetEntryDirectory(unsigned long long key)
+	{
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", key);
+		return m_directory + name + "//";
+	}
+
+	string DerivedDataCache::Entry_Begin(unsigned long long key)
+	{
+		lock_guard<mutex> guard(m_mutex);
+
+		// Start from scratch, a previous attempt might have been interrupted
+		auto directory = GetEntryDirectory(key);
+		if (FileSystem::DirectoryExists(directory))
+		{
+			FileSystem::DeleteDirectory(directory);
+		}
+		FileSystem::CreateDirectory_(directory);
+
+		return directory;
+	}
+
+	void DerivedDataCache::Entry_Commit(unsigned long long key)
+	{
+		lock_guard<mutex> guard(m_mutex);
+
+		ofstream marker(GetEntryDirectory(key) + _DerivedDataCache::markerFileName);
+		marker << ENGINE_VERSION;
+	}
+
+	bool DerivedDataCache::Entry_CopyFile(const string& filePathFrom, const string& filePathTo)
+	{
+		// Rewriting a file with what it already holds would only wake up whatever watches it
+		unsigned long long hashFrom = 0, hashTo = 0;
+		if (_DerivedDataCache::HashFile(filePathTo, &hashTo) && _DerivedDataCache::HashFile(filePathFrom, &hashFrom) && hashFrom == hashTo)
+			return true;
+
+		FileWatcher::Suppress_Begin(filePathTo);
+		bool result = FileSystem::CopyFileFromTo(filePathFrom, filePathTo);
+		FileWatcher::Suppress_End(filePathTo);
+
+		return result;
+	}
+
+	bool DerivedDataCache::Entry_CopyFiles(const string& directoryFrom, const string& directoryTo)
+	{
+		if (!FileSystem::DirectoryExists(directoryFrom))
+			return true;
+
+		if (!FileSystem::DirectoryExists(directoryTo))
+		{
+			FileSystem::CreateDirectory_(directoryTo);
+		}
+
+		bool result = true;
+		for (const auto& filePath : FileSystem::GetFilesInDirectory(directoryFrom))
+		{
+			result &= Entry_CopyFile(filePath, directoryTo + FileSystem::GetFileNameFromFilePath(filePath));
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
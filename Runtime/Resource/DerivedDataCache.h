@@ -0,0 +1,79 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <string>
+#include <vector>
+#include <mutex>
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Directus
+{
+	// A local cache of the data that importers derive from foreign files (models, images).
+	// Entries are keyed by a hash of the source bytes, the importer settings, the engine version and the
+	// content of the dependencies the importer recorded (sidecar files, textures), so they can be shared
+	// across projects. An entry only goes stale if the importer reads a file it doesn't record. Each entry is a directory of artifacts.
+	class ENGINE_CLASS DerivedDataCache
+	{
+	public:
+		DerivedDataCache(const std::string& directory);
+		~DerivedDataCache() {}
+
+		// Computes the key of the data derived from a source file, returns 0 if the file can't be read
+		unsigned long long ComputeKey(const std::string& sourceFilePath, unsigned long long settingsHash);
+
+		// Records the files the data derived from a source depends on (e.g. the textures a model references)
+		void Dependencies_Set(unsigned long long key, const std::vector<std::string>& filePaths);
+		// Folds the content of the dependencies recorded for a key into it, so editing them invalidates the derived data
+		unsigned long long Dependencies_ComputeKey(unsigned long long key);
+
+		// Records the engine file which holds some derived content (e.g. a texture by its source or pixel key), so later sessions can share it
+		void Content_Set(unsigned long long key, const std::string& filePath);
+		// Returns the engine file recorded for some content, empty if there is none or it no longer exists
+		std::string Content_Get(unsigned long long key);
+
+		// Checks whether an entry is complete and can be used
+		bool Contains(unsigned long long key);
+		// Returns the directory which holds the artifacts of an entry
+		std::string GetEntryDirectory(unsigned long long key);
+
+		// Creates an empty entry, the artifacts are then written into its directory
+		std::string Entry_Begin(unsigned long long key);
+		// Marks an entry as complete, entries which are never committed are ignored
+		void Entry_Commit(unsigned long long key);
+		// Copies a file into, or out of, an entry, files which already match are left alone
+		static bool Entry_CopyFile(const std::string& filePathFrom, const std::string& filePathTo);
+		// Copies the files of a directory into, or out of, an entry
+		static bool Entry_CopyFiles(const std::string& directoryFrom, const std::string& directoryTo);
+
+		const std::string& GetDirectory() { return m_directory; }
+
+	private:
+		std::string Dependencies_GetFilePath(unsigned long long key);
+		std::string Content_GetFilePath(unsigned long long key);
+
+		std::string m_directory;
+		std::mutex m_mutex;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,308 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================================
+#include "HotReload.h"
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "ResourceManager.h"
+#include "../Core/Context.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/FileWatcher.h"
+#include "../Threading/Threading.h"
+#include "../RHI/RHI_Texture.h"
+#include "../RHI/RHI_Shader.h"
+#include "../Rendering/Material.h"
+#include "../World/World.h"
+#include "../World/Actor.h"
+#include "../World/Components/Script.h"
+//=============================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	// Shared with the worker tasks, so tasks which start after HotReload is gone can bail out safely
+	struct HotReloadBatch
+	{
+		void Add()
+		{
+			lock_guard<mutex> guard(batchMutex);
+			pending++;
+		}
+
+		bool Enter()
+		{
+			lock_guard<mutex> guard(batchMutex);
+			if (stopping)
+				return false;
+
+			tasksRunning++;
+			return true;
+		}
+
+		void Leave()
+		{
+			lock_guard<mutex> guard(batchMutex);
+			tasksRunning--;
+			pending--;
+		}
+
+		bool IsComplete()
+		{
+			lock_guard<mutex> guard(batchMutex);
+			return pending == 0;
+		}
+
+		std::mutex batchMutex;
+		unsigned int pending		= 0;
+		unsigned int tasksRunning	= 0;
+		bool stopping				= false;
+
+		// Results, applied together
+		vector<pair<shared_ptr<RHI_Texture>, shared_ptr<RHI_Texture>>> textures; // cached, reloaded
+		vector<shared_ptr<Material>> materials;
+		vector<string> scripts;
+		bool shaders = false;
+	};
+
+	namespace _HotReload
+	{
+		template <class T>
+		inline shared_ptr<T> Find(const vector<shared_ptr<IResource>>& resources, const string& filePath)
+		{
+			for (const auto& resource : resources)
+			{
+				if (FileSystem::GetRelativeFilePath(resource->GetResourceFilePath()) == filePath)
+					return static_pointer_cast<T>(resource);
+			}
+
+			return nullptr;
+		}
+
+		// The textures which were loaded from a file, or imported from it (textures saved before
+		// they recorded their source are found next to it, where the importer puts them by default)
+		inline vector<shared_ptr<RHI_Texture>> FindTextures(const vector<shared_ptr<IResource>>& resources, const string& filePath)
+		{
+			vector<shared_ptr<RHI_Texture>> textures;
+			string enginePath = FileSystem::GetFilePathWithoutExtension(filePath) + EXTENSION_TEXTURE;
+			for (const auto& resource : resources)
+			{
+				auto texture		= static_pointer_cast<RHI_Texture>(resource);
+				bool isFile			= FileSystem::GetRelativeFilePath(texture->GetResourceFilePath()) == enginePath;
+				bool isSourceFile	= !texture->GetSourceFilePath().empty() && FileSystem::GetRelativeFilePath(texture->GetSourceFilePath()) == filePath;
+				if (isFile || isSourceFile)
+				{
+					textures.emplace_back(texture);
+				}
+			}
+
+			return textures;
+		}
+	}
+
+	HotReload::HotReload(Context* context)
+	{
+		m_context = context;
+		m_watcher = make_unique<FileWatcher>();
+	}
+
+	HotReload::~HotReload()
+	{
+		if (!m_batch)
+			return;
+
+		// Wait for any reloads which are in progress
+		{
+			lock_guard<mutex> guard(m_batch->batchMutex);
+			m_batch->stopping = true;
+		}
+		while (true)
+		{
+			{
+				lock_guard<mutex> guard(m_batch->batchMutex);
+				if (m_batch->tasksRunning == 0)
+					break;
+			}
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+	}
+
+	void HotReload::Watch(const vector<string>& directories)
+	{
+		m_watcher->RemoveDirectories();
+		for (const auto& directory : directories)
+		{
+			m_watcher->AddDirectory(directory);
+		}
+	}
+
+	void HotReload::Tick()
+	{
+		m_watcher->GetChanges(&m_changes);
+
+		// One batch at a time, changes keep accumulating meanwhile
+		if (m_batch)
+		{
+			if (!m_batch->IsComplete())
+				return;
+
+			Apply();
+			m_batch = nullptr;
+		}
+
+		if (m_changes.empty())
+			return;
+
+		sort(m_changes.begin(), m_changes.end());
+		m_changes.erase(unique(m_changes.begin(), m_changes.end()), m_changes.end());
+		Reload(m_changes);
+		m_changes.clear();
+	}
+
+	void HotReload::Reload(const vector<string>& filePaths)
+	{
+		auto resourceManager	= m_context->GetSubsystem<ResourceManager>();
+		auto threading			= m_context->GetSubsystem<Threading>();
+		auto textures			= resourceManager->GetResourcesByType(Resource_Texture);
+		auto materials			= resourceManager->GetResourcesByType(Resource_Material);
+		auto context			= m_context;
+		auto batch				= make_shared<HotReloadBatch>();
+		bool shaders			= false;
+
+		for (const auto& filePath : filePaths)
+		{
+			// Shaders include each other, any change recompiles all of them
+			if (FileSystem::IsSupportedShaderFile(filePath))
+			{
+				shaders = true;
+			}
+			// Scripts are compiled by the script engine, which runs on the main thread
+			else if (FileSystem::IsEngineScriptFile(filePath))
+			{
+				batch->scripts.emplace_back(filePath);
+			}
+			// Materials are small and refer to live textures, they are reloaded in place
+			else if (FileSystem::IsEngineMaterialFile(filePath))
+			{
+				if (auto material = _HotReload::Find<Material>(materials, filePath))
+				{
+					batch->materials.emplace_back(material);
+				}
+			}
+			// Textures which were imported from an image are cached under their engine format path (which can be
+			// elsewhere, e.g. in a model's directory), so images are mapped through the source path they recorded
+			else if (FileSystem::IsEngineTextureFile(filePath) || FileSystem::IsSupportedImageFile(filePath))
+			{
+				for (const auto& texture : _HotReload::FindTextures(textures, filePath))
+				{
+					if (texture->GetLoadState() == LoadState_Started)
+						continue;
+
+					batch->Add();
+					threading->AddTask([batch, texture, filePath, context]()
+					{
+						if (!batch->Enter())
+							return;
+
+						auto reloaded = make_shared<RHI_Texture>(context);
+						reloaded->SetNeedsMipChain(texture->GetNeedsMipChain());
+						reloaded->SetSRGB(texture->GetSRGB());
+						reloaded->SetMipAlphaReference(texture->GetMipAlphaReference());
+						reloaded->SetCompression(texture->GetCompression());
+						reloaded->SetStreamed(texture->GetStreamed());
+						if (reloaded->LoadFromFile(filePath))
+						{
+							lock_guard<mutex> guard(batch->batchMutex);
+							batch->textures.emplace_back(texture, reloaded);
+						}
+
+						batch->Leave();
+					});
+				}
+			}
+		}
+
+		if (shaders)
+		{
+			batch->Add();
+			threading->AddTask([batch, context]()
+			{
+				if (!batch->Enter())
+					return;
+
+				RHI_Shader::Reload_CompileAll(context);
+				{
+					lock_guard<mutex> guard(batch->batchMutex);
+					batch->shaders = true;
+				}
+
+				batch->Leave();
+			});
+		}
+
+		m_batch = batch;
+	}
+
+	void HotReload::Apply()
+	{
+		// Textures go first, the materials which are reloaded below may refer to them
+		for (const auto& texture : m_batch->textures)
+		{
+			texture.first->Reload_Swap(texture.second.get());
+			LOGF_INFO("HotReload::Apply: Reloaded \"%s\"", texture.first->GetResourceFilePath().c_str());
+		}
+
+		if (m_batch->shaders)
+		{
+			RHI_Shader::Reload_ApplyAll();
+		}
+
+		for (const auto& material : m_batch->materials)
+		{
+			if (material->LoadFromFile(material->GetResourceFilePath()))
+			{
+				LOGF_INFO("HotReload::Apply: Reloaded \"%s\"", material->GetResourceFilePath().c_str());
+			}
+		}
+
+		if (m_batch->scripts.empty())
+			return;
+
+		for (const auto& actor : m_context->GetSubsystem<World>()->Actors_GetAll())
+		{
+			for (const auto& script : actor->GetComponents<Script>())
+			{
+				auto filePath = FileSystem::GetRelativeFilePath(script->GetScriptPath());
+				if (find(m_batch->scripts.begin(), m_batch->scripts.end(), filePath) == m_batch->scripts.end())
+					continue;
+
+				if (script->SetScript(filePath))
+				{
+					LOGF_INFO("HotReload::Apply: Reloaded \"%s\" on \"%s\"", filePath.c_str(), actor->GetName().c_str());
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =================
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Core/EngineDefs.h"
+//============================
+
+namespace Directus
+{
+	class Context;
+	class FileWatcher;
+
+	// Reloads textures, materials, shaders and scripts when their files change on disk (e.g. when edited with an
+	// external tool). Changed files are mapped to the cached resources which were loaded from them and only those
+	// are reloaded, with the expensive part (decoding, compiling) done on the worker threads. The results of a batch
+	// are swapped in together at the start of a frame, so a frame never sees a mix of old and new resources.
+	class ENGINE_CLASS HotReload
+	{
+	public:
+		HotReload(Context* context);
+		~HotReload();
+
+		// Watches directories (and their subdirectories), replacing any which were watched before
+		void Watch(const std::vector<std::string>& directories);
+		// Starts reloading files which changed and applies a batch once it's complete, call at the start of a frame
+		void Tick();
+
+	private:
+		void Reload(const std::vector<std::string>& filePaths);
+		void Apply();
+
+		Context* m_context;
+		std::unique_ptr<FileWatcher> m_watcher;
+		std::shared_ptr<struct HotReloadBatch> m_batch;
+		std::vector<std::string> m_changes;
+	};
+}
\ No newline at end of file
@@ -32,6 +32,12 @@ using namespace std;
 using namespace Directus;
 //=======================
 
+namespace _IResource
+{
+	// Increases every time a resource is used, orders resources from least to most recently used
+	static atomic<unsigned long long> useCounter = 0;
+}
+
 template <typename T>
 Resource_Type IResource::DeduceResourceType() { return Resource_Unknown; }
 #define INSTANTIATE_ToResourceType(T, enumT) template<> ENGINE_CLASS Resource_Type IResource::DeduceResourceType<T>() { return enumT; }
@@ -56,14 +62,39 @@ IResource::IResource(Context* context, Resource_Type type)
 
 shared_ptr<IResource> IResource::_Cache()
 {
-	auto resource = m_resourceManager->GetResourceByName(GetResourceName(), m_resourceType);
-	if (!resource)
+	// Returns the already cached resource with the same name, if any
+	return m_resourceManager->Add<IResource>(GetSharedPtr());
+}
+
+bool IResource::SaveToFileIfDirty()
+{
+	if (!m_isDirty || !HasFilePath())
+		return true;
+
+	// Flagged as dirty, but the content may have been changed back (or not at all)
+	auto contentHash = ComputeContentHash();
+	if (contentHash != 0 && contentHash == m_contentHash && FileSystem::FileExists(m_resourceFilePath))
 	{
-		m_resourceManager->Add(GetSharedPtr());
-		resource = m_resourceManager->GetResourceByName(GetResourceName(), m_resourceType);
+		m_isDirty = false;
+		return true;
 	}
 
-	return resource;
+	if (!SaveToFile(m_resourceFilePath))
+		return false;
+
+	m_contentHash	= contentHash;
+	m_isDirty		= false;
+	return true;
+}
+
+void IResource::Touch()
+{
+	m_lastUsed = ++_IResource::useCounter;
+}
+
+unsigned long long IResource::GetLastUsedGlobal()
+{
+	return _IResource::useCounter;
 }
 
 bool IResource::_IsCached()
@@ -23,6 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "../Core/Context.h"
 #include "../Core/GUIDGenerator.h"
 #include "../FileSystem/FileSystem.h"
@@ -56,6 +59,13 @@ namespace Directus
 		LoadState_Failed
 	};
 
+	enum LoadPriority
+	{
+		LoadPriority_Low,
+		LoadPriority_Normal,
+		LoadPriority_High
+	};
+
 	class ENGINE_CLASS IResource : public std::enable_shared_from_this<IResource>
 	{
 	public:
@@ -112,9 +122,39 @@ namespace Directus
 		//= IO =================================================================
 		virtual bool SaveToFile(const std::string& filePath)	{ return true; }
 		virtual bool LoadFromFile(const std::string& filePath)	{ return true; }
-		virtual unsigned int GetMemoryUsage()					{ return 0; }
+		// System memory held by the resource, which is what memory budgets apply to
+		virtual unsigned long long GetMemoryUsage()				{ return 0; }
+		// Saves to the resource's file path, but only if its content changed since it was last loaded or saved
+		bool SaveToFileIfDirty();
+		// Asynchronous loading runs in two stages, LoadAsync_Read() on a worker thread and LoadAsync_Finalize()
+		// on the main thread (GPU resource creation). By default, everything happens in the first stage.
+		virtual bool LoadAsync_Read(const std::string& filePath)	{ return LoadFromFile(filePath); }
+		virtual bool LoadAsync_Finalize()							{ return true; }
+		// File paths of the resources this resource needs, engine formats record them in their header
+		virtual std::vector<std::string> GetDependencies()		{ return std::vector<std::string>(); }
 		//======================================================================
 
+		//= EVICTION ===========================================================================================
+		// Frees CPU-side data which can be reloaded from the engine format, returns the amount of memory freed.
+		// Evicted data is reloaded transparently the next time it's accessed. Eviction and reloading hold the
+		// eviction mutex, and the cache only evicts idle resources (not loading and not referenced elsewhere).
+		virtual unsigned long long Evict()	{ return 0; }
+		bool IsEvicted()					{ return m_isEvicted; }
+		// Marks the resource as the most recently used one
+		void Touch();
+		unsigned long long GetLastUsed()	{ return m_lastUsed; }
+		// Value of the most recent Touch(), across all resources
+		static unsigned long long GetLastUsedGlobal();
+		//=====================================================================================================
+
+		//= DIRTY TRACKING =================================================================
+		bool IsDirty()							{ return m_isDirty; }
+		void SetDirty(bool isDirty = true)		{ m_isDirty = isDirty; }
+		unsigned long long GetContentHash()		{ return m_contentHash; }
+		// Hash of the serialized content, 0 when it can't be computed cheaply
+		virtual unsigned long long ComputeContentHash() { return 0; }
+		//==================================================================================
+
 		//= TYPE ================================
 		template <typename T>
 		static Resource_Type DeduceResourceType();
@@ -136,6 +176,11 @@ namespace Directus
 		std::string m_resourceFilePath		= NOT_ASSIGNED;
 		Resource_Type m_resourceType			= Resource_Unknown;
 		LoadState m_loadState				= LoadState_Idle;
+		bool m_isDirty						= true; // resources created in memory have never been saved
+		unsigned long long m_contentHash	= 0;
+		std::atomic<bool> m_isEvicted		= false;
+		std::recursive_mutex m_evictionMutex;
+		std::atomic<unsigned long long> m_lastUsed = 0;
 		Context* m_context					= nullptr;
 		ResourceManager* m_resourceManager	= nullptr;
 	};
@@ -0,0 +1,719 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "BlockCompressor.h"
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include "../../Threading/Threading.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _BlockCompressor
+	{
+		// Rows of blocks per task
+		static const unsigned int tileRows			= 16;
+		// Levels with fewer blocks are encoded on the calling thread
+		static const unsigned int parallelBlocks	= 32 * 32;
+		// Iterations of the power method which finds the principal axis of a block
+		static const unsigned int axisIterations	= 8;
+		// Interpolation weights (out of 64) of the 4-bit BC7 indices
+		static const unsigned int bc7Weights[16]	= { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		struct Block
+		{
+			float texels[16][4];
+		};
+
+		struct BitWriter
+		{
+			BitWriter(unsigned char* data) { this->data = data; }
+
+			void Write(unsigned int value, unsigned int count)
+			{
+				for (unsigned int i = 0; i < count; i++, bit++)
+				{
+					data[bit >> 3] |= (unsigned char)(((value >> i) & 1) << (bit & 7));
+				}
+			}
+
+			unsigned char* data;
+			unsigned int bit = 0;
+		};
+
+		inline float Clamp255(float value) { return min(max(value, 0.0f), 255.0f); }
+
+		// Texels past the edge of mips smaller than a block repeat the last row/column
+		inline void LoadBlock(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned int blockX, unsigned int blockY, Block* block)
+		{
+			for (unsigned int y = 0; y < 4; y++)
+			{
+				unsigned int sourceY = min(blockY * 4 + y, height - 1);
+				for (unsigned int x = 0; x < 4; x++)
+				{
+					unsigned int sourceX		= min(blockX * 4 + x, width - 1);
+					const unsigned char* texel	= rgba + ((size_t)sourceY * width + sourceX) * 4;
+					for (unsigned int c = 0; c < 4; c++)
+					{
+						block->texels[y * 4 + x][c] = texel[c];
+					}
+				}
+			}
+		}
+
+		inline bool HasTransparentTexels(const Block& block)
+		{
+			for (const auto& texel : block.texels)
+			{
+				if (texel[3] < 128.0f)
+					return true;
+			}
+
+			return false;
+		}
+
+		// Endpoints at the extremes of the block's projection onto its principal axis (first N channels)
+		template <unsigned int N>
+		void FitEndpoints(const Block& block, float* endpoint0, float* endpoint1)
+		{
+			float mean[N]		= {};
+			float lowest[N];
+			float highest[N];
+			for (unsigned int c = 0; c < N; c++)
+			{
+				lowest[c]	= FLT_MAX;
+				highest[c]	= -FLT_MAX;
+			}
+
+			for (const auto& texel : block.texels)
+			{
+				for (unsigned int c = 0; c < N; c++)
+				{
+					mean[c]		+= texel[c] / 16.0f;
+					lowest[c]	= min(lowest[c], texel[c]);
+					highest[c]	= max(highest[c], texel[c]);
+				}
+			}
+
+			float covariance[N][N] = {};
+			for (const auto& texel : block.texels)
+			{
+				for (unsigned int a = 0; a < N; a++)
+				{
+					for (unsigned int b = 0; b < N; b++)
+					{
+						covariance[a][b] += (texel[a] - mean[a]) * (texel[b] - mean[b]);
+					}
+				}
+			}
+
+			// Power method, starting from the diagonal of the bounding box
+			float axis[N];
+			for (unsigned int c = 0; c < N; c++)
+			{
+				axis[c] = highest[c] - lowest[c];
+			}
+
+			for (unsigned int i = 0; i < axisIterations; i++)
+			{
+				float next[N]	= {};
+				float largest	= 0.0f;
+				for (unsigned int a = 0; a < N; a++)
+				{
+					for (unsigned int b = 0; b < N; b++)
+					{
+						next[a] += covariance[a][b] * axis[b];
+					}
+					largest = max(largest, fabs(next[a]));
+				}
+
+				if (largest == 0.0f)
+					break;
+
+				for (unsigned int c = 0; c < N; c++)
+				{
+					axis[c] = next[c] / largest;
+				}
+			}
+
+			float length = 0.0f;
+			for (unsigned int c = 0; c < N; c++)
+			{
+				length += axis[c] * axis[c];
+			}
+			length = length > 0.0f ? 1.0f / sqrt(length) : 0.0f;
+
+			float tMin = FLT_MAX;
+			float tMax = -FLT_MAX;
+			for (const auto& texel : block.texels)
+			{
+				float t = 0.0f;
+				for (unsigned int c = 0; c < N; c++)
+				{
+					t += (texel[c] - mean[c]) * axis[c] * length;
+				}
+				tMin = min(tMin, t);
+				tMax = max(tMax, t);
+			}
+
+			for (unsigned int c = 0; c < N; c++)
+			{
+				endpoint0[c] = Clamp255(mean[c] + axis[c] * length * tMin);
+				endpoint1[c] = Clamp255(mean[c] + axis[c] * length * tMax);
+			}
+		}
+
+		// Least squares endpoints for texels which interpolate them with the given weights (of the second endpoint)
+		template <unsigned int N>
+		bool RefineEndpoints(const Block& block, const float* weights, float* endpoint0, float* endpoint1)
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[N] = {};
+			float bx[N] = {};
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				float b = weights[i];
+				float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (unsigned int c = 0; c < N; c++)
+				{
+					ax[c] += a * block.texels[i][c];
+					bx[c] += b * block.texels[i][c];
+				}
+			}
+
+			float determinant = aa * bb - ab * ab;
+			if (fabs(determinant) < 1e-4f)
+				return false;
+
+			for (unsigned int c = 0; c < N; c++)
+			{
+				endpoint0[c] = Clamp255((ax[c] * bb - bx[c] * ab) / determinant);
+				endpoint1[c] = Clamp255((bx[c] * aa - ax[c] * ab) / determinant);
+			}
+
+			return true;
+		}
+
+		//= BC1 ========================================================================================================
+		inline unsigned short To565(const float* color)
+		{
+			unsigned int r = (unsigned int)(color[0] * 31.0f / 255.0f + 0.5f);
+			unsigned int g = (unsigned int)(color[1] * 63.0f / 255.0f + 0.5f);
+			unsigned int b = (unsigned int)(color[2] * 31.0f / 255.0f + 0.5f);
+			return (unsigned short)((r << 11) | (g << 5) | b);
+		}
+
+		inline void From565(unsigned short value, float* color)
+		{
+			unsigned int r = (value >> 11) & 31;
+			unsigned int g = (value >> 5) & 63;
+			unsigned int b = value & 31;
+			color[0] = float((r << 3) | (r >> 2));
+			color[1] = float((g << 2) | (g >> 4));
+			color[2] = float((b << 3) | (b >> 2));
+		}
+
+		// Picks the closest palette entry for every texel, returns the squared error
+		inline float SelectColorIndices(const Block& block, unsigned short color0, unsigned short color1, unsigned int* indices)
+		{
+			float palette[4][3];
+			From565(color0, palette[0]);
+			From565(color1, palette[1]);
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+				palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+			}
+
+			float error = 0.0f;
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				float best = FLT_MAX;
+				for (unsigned int entry = 0; entry < 4; entry++)
+				{
+					float distance = 0.0f;
+					for (unsigned int c = 0; c < 3; c++)
+					{
+						float d		= block.texels[i][c] - palette[entry][c];
+						distance	+= d * d;
+					}
+
+					if (distance < best)
+					{
+						best		= distance;
+						indices[i]	= entry;
+					}
+				}
+				error += best;
+			}
+
+			return error;
+		}
+
+		inline void WriteColorBlock(unsigned short color0, unsigned short color1, const unsigned int* indices, unsigned char* dest)
+		{
+			unsigned int bits = 0;
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				bits |= indices[i] << (i * 2);
+			}
+
+			dest[0] = (unsigned char)(color0 & 0xff);
+			dest[1] = (unsigned char)(color0 >> 8);
+			dest[2] = (unsigned char)(color1 & 0xff);
+			dest[3] = (unsigned char)(color1 >> 8);
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				dest[4 + i] = (unsigned char)((bits >> (i * 8)) & 0xff);
+			}
+		}
+
+		// 4 color mode, which is also the only mode of the color part of a BC3 block
+		void EncodeColor(const Block& block, unsigned char* dest)
+		{
+			float endpoint0[3], endpoint1[3];
+			FitEndpoints<3>(block, endpoint0, endpoint1);
+
+			// Pull the endpoints in a little, the extremes are rarely worth a whole palette entry
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				float inset = (endpoint1[c] - endpoint0[c]) / 16.0f;
+				endpoint0[c] += inset;
+				endpoint1[c] -= inset;
+			}
+
+			unsigned short color0 = To565(endpoint0);
+			unsigned short color1 = To565(endpoint1);
+			unsigned int indices[16];
+			float error = SelectColorIndices(block, color0, color1, indices);
+
+			// One least squares pass over the chosen indices
+			static const float entryWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			float weights[16];
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				weights[i] = entryWeights[indices[i]];
+			}
+
+			if (RefineEndpoints<3>(block, weights, endpoint0, endpoint1))
+			{
+				unsigned short refined0 = To565(endpoint0);
+				unsigned short refined1 = To565(endpoint1);
+				unsigned int refinedIndices[16];
+				if (SelectColorIndices(block, refined0, refined1, refinedIndices) < error)
+				{
+					color0 = refined0;
+					color1 = refined1;
+					memcpy(indices, refinedIndices, sizeof(indices));
+				}
+			}
+
+			// The first endpoint has to be the larger one for the 4 color mode
+			if (color0 < color1)
+			{
+				swap(color0, color1);
+				for (auto& index : indices)
+				{
+					index ^= 1;
+				}
+			}
+			else if (color0 == color1)
+			{
+				memset(indices, 0, sizeof(indices));
+			}
+
+			WriteColorBlock(color0, color1, indices, dest);
+		}
+
+		// 3 color mode, texels with less than half alpha get the transparent entry (BC1 only)
+		void EncodeColorTransparent(const Block& block, unsigned char* dest)
+		{
+			// The transparent texels take the color of an opaque one so they don't pull the endpoints
+			Block opaque	= block;
+			int reference	= -1;
+			for (unsigned int i = 0; i < 16 && reference == -1; i++)
+			{
+				reference = block.texels[i][3] < 128.0f ? -1 : (int)i;
+			}
+
+			unsigned short color0 = 0;
+			unsigned short color1 = 0;
+			if (reference != -1)
+			{
+				for (auto& texel : opaque.texels)
+				{
+					if (texel[3] < 128.0f)
+					{
+						memcpy(texel, block.texels[reference], sizeof(texel));
+					}
+				}
+
+				float endpoint0[3], endpoint1[3];
+				FitEndpoints<3>(opaque, endpoint0, endpoint1);
+				color0 = To565(endpoint0);
+				color1 = To565(endpoint1);
+
+				// The first endpoint can't be the larger one in the 3 color mode
+				if (color0 > color1)
+				{
+					swap(color0, color1);
+				}
+			}
+
+			float palette[3][3];
+			From565(color0, palette[0]);
+			From565(color1, palette[1]);
+			for (unsigned int c = 0; c < 3; c++)
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+			}
+
+			unsigned int indices[16];
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				indices[i] = 3;
+				if (block.texels[i][3] < 128.0f)
+					continue;
+
+				float best = FLT_MAX;
+				for (unsigned int entry = 0; entry < 3; entry++)
+				{
+					float distance = 0.0f;
+					for (unsigned int c = 0; c < 3; c++)
+					{
+						float d		= block.texels[i][c] - palette[entry][c];
+						distance	+= d * d;
+					}
+
+					if (distance < best)
+					{
+						best		= distance;
+						indices[i]	= entry;
+					}
+				}
+			}
+
+			WriteColorBlock(color0, color1, indices, dest);
+		}
+		//==============================================================================================================
+
+		//= BC4 ========================================================================================================
+		// 8 value mode of a single channel, which is also the alpha part of a BC3 block
+		void EncodeChannel(const Block& block, unsigned int channel, unsigned char* dest)
+		{
+			float lowest	= 255.0f;
+			float highest	= 0.0f;
+			for (const auto& texel : block.texels)
+			{
+				lowest	= min(lowest, texel[channel]);
+				highest	= max(highest, texel[channel]);
+			}
+
+			unsigned int value0		= (unsigned int)(highest + 0.5f);
+			unsigned int value1		= (unsigned int)(lowest + 0.5f);
+			unsigned long long bits	= 0;
+			if (value0 > value1)
+			{
+				// Codes 0 and 1 are the endpoints, 2 to 7 step from the first endpoint to the second
+				float scale = 7.0f / float(value0 - value1);
+				for (unsigned int i = 0; i < 16; i++)
+				{
+					unsigned int step = (unsigned int)((value0 - block.texels[i][channel]) * scale + 0.5f);
+					unsigned long long code = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+					bits |= code << (i * 3);
+				}
+			}
+
+			dest[0] = (unsigned char)value0;
+			dest[1] = (unsigned char)value1;
+			for (unsigned int i = 0; i < 6; i++)
+			{
+				dest[2 + i] = (unsigned char)((bits >> (i * 8)) & 0xff);
+			}
+		}
+		//==============================================================================================================
+
+		//= BC7 ========================================================================================================
+		// 7 bits per channel plus a p-bit shared by the channels of the endpoint. Opaque blocks keep
+		// the p-bit set, as alpha can only decode to 255 with it (the RGB error could favor the other one).
+		inline void QuantizeEndpoint(const float* endpoint, bool opaque, unsigned int* quantized, unsigned int* pBit)
+		{
+			float bestError = FLT_MAX;
+			for (unsigned int p = opaque ? 1 : 0; p < 2; p++)
+			{
+				unsigned int candidate[4];
+				float error = 0.0f;
+				for (unsigned int c = 0; c < 4; c++)
+				{
+					candidate[c]	= (opaque && c == 3) ? 127 : (unsigned int)min(max((int)((endpoint[c] - p) / 2.0f + 0.5f), 0), 127);
+					float d			= float(candidate[c] * 2 + p) - endpoint[c];
+					error			+= d * d;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					*pBit = p;
+					memcpy(quantized, candidate, sizeof(candidate));
+				}
+			}
+		}
+
+		inline float SelectBC7Indices(const Block& block, const unsigned int* quantized0, unsigned int pBit0, const unsigned int* quantized1, unsigned int pBit1, unsigned int* indices)
+		{
+			float palette[16][4];
+			for (unsigned int c = 0; c < 4; c++)
+			{
+				unsigned int a = quantized0[c] * 2 + pBit0;
+				unsigned int b = quantized1[c] * 2 + pBit1;
+				for (unsigned int i = 0; i < 16; i++)
+				{
+					palette[i][c] = float(((64 - bc7Weights[i]) * a + bc7Weights[i] * b + 32) >> 6);
+				}
+			}
+
+			float error = 0.0f;
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				float best = FLT_MAX;
+				for (unsigned int entry = 0; entry < 16; entry++)
+				{
+					float distance = 0.0f;
+					for (unsigned int c = 0; c < 4; c++)
+					{
+						float d		= block.texels[i][c] - palette[entry][c];
+						distance	+= d * d;
+					}
+
+					if (distance < best)
+					{
+						best		= distance;
+						indices[i]	= entry;
+					}
+				}
+				error += best;
+			}
+
+			return error;
+		}
+
+		// Mode 6: a single RGBA line with 4-bit indices
+		void EncodeBC7(const Block& block, unsigned char* dest)
+		{
+			float endpoint0[4], endpoint1[4];
+			FitEndpoints<4>(block, endpoint0, endpoint1);
+
+			bool opaque = true;
+			for (const auto& texel : block.texels)
+			{
+				opaque &= texel[3] == 255.0f;
+			}
+
+			unsigned int quantized0[4], quantized1[4], pBit0, pBit1;
+			QuantizeEndpoint(endpoint0, opaque, quantized0, &pBit0);
+			QuantizeEndpoint(endpoint1, opaque, quantized1, &pBit1);
+			unsigned int indices[16];
+			float error = SelectBC7Indices(block, quantized0, pBit0, quantized1, pBit1, indices);
+
+			// One least squares pass over the chosen indices
+			float weights[16];
+			for (unsigned int i = 0; i < 16; i++)
+			{
+				weights[i] = bc7Weights[indices[i]] / 64.0f;
+			}
+
+			if (RefineEndpoints<4>(block, weights, endpoint0, endpoint1))
+			{
+				unsigned int refined0[4], refined1[4], refinedBit0, refinedBit1, refinedIndices[16];
+				QuantizeEndpoint(endpoint0, opaque, refined0, &refinedBit0);
+				QuantizeEndpoint(endpoint1, opaque, refined1, &refinedBit1);
+				if (SelectBC7Indices(block, refined0, refinedBit0, refined1, refinedBit1, refinedIndices) < error)
+				{
+					memcpy(quantized0, refined0, sizeof(refined0));
+					memcpy(quantized1, refined1, sizeof(refined1));
+					memcpy(indices, refinedIndices, sizeof(indices));
+					pBit0 = refinedBit0;
+					pBit1 = refinedBit1;
+				}
+			}
+
+			// The index of the first texel is stored without its top bit, so it has to be in the first half
+			if (indices[0] & 8)
+			{
+				for (unsigned int c = 0; c < 4; c++)
+				{
+					swap(quantized0[c], quantized1[c]);
+				}
+				swap(pBit0, pBit1);
+				for (auto& index : indices)
+				{
+					index = 15 - index;
+				}
+			}
+
+			memset(dest, 0, 16);
+			BitWriter writer(dest);
+			writer.Write(1 << 6, 7);
+			for (unsigned int c = 0; c < 4; c++)
+			{
+				writer.Write(quantized0[c], 7);
+				writer.Write(quantized1[c], 7);
+			}
+			writer.Write(pBit0, 1);
+			writer.Write(pBit1, 1);
+			writer.Write(indices[0], 3);
+			for (unsigned int i = 1; i < 16; i++)
+			{
+				writer.Write(indices[i], 4);
+			}
+		}
+		//==============================================================================================================
+	}
+
+	BlockCompressor::BlockCompressor(Threading* threading)
+	{
+		m_threading = threading;
+	}
+
+	bool BlockCompressor::Compress(vector<vector<byte>>* mips, unsigned int width, unsigned int height, Texture_Format format)
+	{
+		unsigned int blockSize = GetBlockSize(format);
+		if (!mips || mips->empty() || blockSize == 0 || width % 4 != 0 || height % 4 != 0)
+		{
+			LOGF_ERROR("BlockCompressor::Compress: Can't compress a %dx%d texture to format %d", width, height, format);
+			return false;
+		}
+
+		// Validate the whole chain first, a partially compressed chain would be useless
+		for (unsigned int i = 0, levelWidth = width, levelHeight = height; i < (unsigned int)mips->size(); i++)
+		{
+			if ((*mips)[i].size() != (size_t)levelWidth * levelHeight * 4)
+			{
+				LOGF_ERROR("BlockCompressor::Compress: Mip level %d doesn't hold %dx%d RGBA8 texels", i, levelWidth, levelHeight);
+				return false;
+			}
+			levelWidth	= max(levelWidth / 2, 1u);
+			levelHeight	= max(levelHeight / 2, 1u);
+		}
+
+		for (auto& mip : *mips)
+		{
+			unsigned int blocksX	= (width + 3) / 4;
+			unsigned int blocksY	= (height + 3) / 4;
+			auto source				= reinterpret_cast<const unsigned char*>(mip.data());
+			vector<byte> blocks((size_t)blocksX * blocksY * blockSize);
+			auto dest				= reinterpret_cast<unsigned char*>(blocks.data());
+
+			ParallelBlockRows(blocksY, blocksX, [source, dest, width, height, blocksX, blockSize, format](unsigned int yStart, unsigned int yEnd)
+			{
+				_BlockCompressor::Block block;
+				for (unsigned int y = yStart; y < yEnd; y++)
+				{
+					for (unsigned int x = 0; x < blocksX; x++)
+					{
+						_BlockCompressor::LoadBlock(source, width, height, x, y, &block);
+						unsigned char* output = dest + ((size_t)y * blocksX + x) * blockSize;
+						switch (format)
+						{
+							case Texture_Format_BC1_UNORM:
+								if (_BlockCompressor::HasTransparentTexels(block))
+								{
+									_BlockCompressor::EncodeColorTransparent(block, output);
+								}
+								else
+								{
+									_BlockCompressor::EncodeColor(block, output);
+								}
+								break;
+							case Texture_Format_BC3_UNORM:
+								_BlockCompressor::EncodeChannel(block, 3, output);
+								_BlockCompressor::EncodeColor(block, output + 8);
+								break;
+							case Texture_Format_BC4_UNORM:
+								_BlockCompressor::EncodeChannel(block, 0, output);
+								break;
+							case Texture_Format_BC5_UNORM:
+								_BlockCompressor::EncodeChannel(block, 0, output);
+								_BlockCompressor::EncodeChannel(block, 1, output + 8);
+								break;
+							default:
+								_BlockCompressor::EncodeBC7(block, output);
+								break;
+						}
+					}
+				}
+			});
+
+			mip		= move(blocks);
+			width	= max(width / 2, 1u);
+			height	= max(height / 2, 1u);
+		}
+
+		return true;
+	}
+
+	unsigned int BlockCompressor::GetBlockSize(Texture_Format format)
+	{
+		switch (format)
+		{
+			case Texture_Format_BC1_UNORM:
+			case Texture_Format_BC4_UNORM:
+				return 8;
+			case Texture_Format_BC3_UNORM:
+			case Texture_Format_BC5_UNORM:
+			case Texture_Format_BC7_UNORM:
+				return 16;
+			default:
+				return 0;
+		}
+	}
+
+	void BlockCompressor::ParallelBlockRows(unsigned int rows, unsigned int blocksPerRow, const function<void(unsigned int, unsigned int)>& work)
+	{
+		if (!m_threading || (size_t)rows * blocksPerRow < _BlockCompressor::parallelBlocks)
+		{
+			work(0, rows);
+			return;
+		}
+
+		// The tasks only reference the work while this function waits for them
+		TaskGroup group;
+		for (unsigned int y = 0; y < rows; y += _BlockCompressor::tileRows)
+		{
+			unsigned int yEnd = min(y + _BlockCompressor::tileRows, rows);
+			m_threading->AddTask([&work, y, yEnd]() { work(y, yEnd); }, &group);
+		}
+
+		m_threading->Wait(&group);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =========================
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include "../../Core/EngineDefs.h"
+#include "../../RHI/RHI_Definition.h"
+//====================================
+
+namespace Directus
+{
+	class Threading;
+
+	// Encodes RGBA8 texels as 4x4 blocks (BC1 with 1-bit alpha, BC3, BC4, BC5 and BC7 mode 6). Endpoints are fitted along the principal
+	// axis of each block and refined with a least squares pass, the rows of blocks of each mip are split into tiles
+	// which are processed by the worker threads.
+	class ENGINE_CLASS BlockCompressor
+	{
+	public:
+		BlockCompressor(Threading* threading);
+		~BlockCompressor() {}
+
+		// Replaces every level of an RGBA8 mip chain with its blocks, level 0 has to be a multiple of 4 in both dimensions
+		bool Compress(std::vector<std::vector<std::byte>>* mips, unsigned int width, unsigned int height, Texture_Format format);
+
+		// Bytes per 4x4 block, 0 if the compressor can't produce the format
+		static unsigned int GetBlockSize(Texture_Format format);
+
+		// Changes whenever the output would be different
+		static unsigned int GetVersion() { return 2; }
+
+	private:
+		void ParallelBlockRows(unsigned int rows, unsigned int blocksPerRow, const std::function<void(unsigned int, unsigned int)>& work);
+
+		Threading* m_threading;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,592 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =====================
+#include "IBLGenerator.h"
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <emmintrin.h>
+#include "../../Threading/Threading.h"
+#include "../../Logging/Log.h"
+#include "../../Math/MathHelper.h"
+//================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	namespace _IBLGenerator
+	{
+		// Rows of a level per task
+		static const unsigned int tileRows			= 16;
+		// Levels with fewer texels are processed on the calling thread
+		static const unsigned int parallelTexels	= 64 * 64;
+		// Size of the pyramid base, which is also the first (mirror like) level of the specular chain
+		static const unsigned int baseWidth			= 1024;
+		static const unsigned int baseHeight		= 512;
+		// 1024x512 down to 16x8, the roughness goes from 0 to 1 in steps of 1/6
+		static const unsigned int specularLevels	= 7;
+		// GGX samples per texel, filtered importance sampling hides the noise the rest would
+		static const unsigned int specularSamples	= 64;
+		// Width of the pyramid level which is projected onto the spherical harmonics
+		static const unsigned int irradianceWidth	= 256;
+		static const unsigned int shCount			= 9;
+		static const unsigned int cubemapFaces		= 6;
+		// Largest finite half float
+		static const float halfMax					= 65504.0f;
+
+		// Direction of a point of an equirectangular texture, the inverse of DirectionToSphereUV() in the shaders
+		inline void UVToDirection(float u, float v, float* direction)
+		{
+			float theta		= v * Helper::PI;
+			float phi		= u * Helper::PI_2;
+			float sinTheta	= sinf(theta);
+			direction[0]	= sinTheta * cosf(phi);
+			direction[1]	= cosf(theta);
+			direction[2]	= -sinTheta * sinf(phi);
+		}
+
+		inline void DirectionToUV(const float* direction, float* u, float* v)
+		{
+			float phi	= atan2f(direction[2], direction[0]);
+			*u			= -phi / Helper::PI_2;
+			*u			= *u < 0.0f ? *u + 1.0f : *u;
+			*v			= acosf(Helper::Clamp(direction[1], -1.0f, 1.0f)) / Helper::PI;
+		}
+
+		// Face and texel coordinates of a direction, the faces are laid out the way Direct3D samples them
+		inline unsigned int DirectionToFace(const float* direction, unsigned int size, float* x, float* y)
+		{
+			float ax = fabsf(direction[0]);
+			float ay = fabsf(direction[1]);
+			float az = fabsf(direction[2]);
+			unsigned int face;
+			float sc, tc, ma;
+			if (ax >= ay && ax >= az)
+			{
+				face	= direction[0] > 0.0f ? 0 : 1;
+				sc		= direction[0] > 0.0f ? -direction[2] : direction[2];
+				tc		= -direction[1];
+				ma		= ax;
+			}
+			else if (ay >= az)
+			{
+				face	= direction[1] > 0.0f ? 2 : 3;
+				sc		= direction[0];
+				tc		= direction[1] > 0.0f ? direction[2] : -direction[2];
+				ma		= ay;
+			}
+			else
+			{
+				face	= direction[2] > 0.0f ? 4 : 5;
+				sc		= direction[2] > 0.0f ? direction[0] : -direction[0];
+				tc		= -direction[1];
+				ma		= az;
+			}
+
+			*x = (sc / ma + 1.0f) * 0.5f * size - 0.5f;
+			*y = (tc / ma + 1.0f) * 0.5f * size - 0.5f;
+			return face;
+		}
+
+		// Texel coordinates, equirectangular textures wrap around horizontally
+		inline __m128 Bilinear(const float* texels, unsigned int width, unsigned int height, float x, float y, bool wrap)
+		{
+			float fx	= floorf(x);
+			float fy	= floorf(y);
+			__m128 tx	= _mm_set1_ps(x - fx);
+			__m128 ty	= _mm_set1_ps(y - fy);
+			int w		= (int)width;
+			int h		= (int)height;
+			int x0		= (int)fx;
+			int y0		= Helper::Clamp((int)fy, 0, h - 1);
+			int x1		= x0 + 1;
+			int y1		= Helper::Clamp((int)fy + 1, 0, h - 1);
+			if (wrap)
+			{
+				x0 = ((x0 % w) + w) % w;
+				x1 = ((x1 % w) + w) % w;
+			}
+			else
+			{
+				x0 = Helper::Clamp(x0, 0, w - 1);
+				x1 = Helper::Clamp(x1, 0, w - 1);
+			}
+
+			__m128 a		= _mm_loadu_ps(texels + ((size_t)y0 * width + x0) * 4);
+			__m128 b		= _mm_loadu_ps(texels + ((size_t)y0 * width + x1) * 4);
+			__m128 c		= _mm_loadu_ps(texels + ((size_t)y1 * width + x0) * 4);
+			__m128 d		= _mm_loadu_ps(texels + ((size_t)y1 * width + x1) * 4);
+			__m128 top		= _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), tx));
+			__m128 bottom	= _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(d, c), tx));
+			return _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), ty));
+		}
+
+		// Real spherical harmonics, bands 0 to 2
+		inline void EvaluateSH(const float* direction, float* sh)
+		{
+			float x = direction[0];
+			float y = direction[1];
+			float z = direction[2];
+			sh[0] = 0.282095f;
+			sh[1] = 0.488603f * y;
+			sh[2] = 0.488603f * z;
+			sh[3] = 0.488603f * x;
+			sh[4] = 1.092548f * x * y;
+			sh[5] = 1.092548f * y * z;
+			sh[6] = 0.315392f * (3.0f * z * z - 1.0f);
+			sh[7] = 1.092548f * x * z;
+			sh[8] = 0.546274f * (x * x - y * y);
+		}
+
+		// Van der Corput sequence, the second coordinate of the Hammersley points
+		inline float RadicalInverse(unsigned int bits)
+		{
+			bits = (bits << 16u) | (bits >> 16u);
+			bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+			bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+			bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+			bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+			return float(bits) * 2.3283064365386963e-10f;
+		}
+
+		// A light direction around +Z (N = V = R), its weight and the pyramid level whose texels cover the same solid angle
+		struct Sample
+		{
+			float direction[3];
+			float weight;
+			unsigned int level;
+			float blend;
+		};
+
+		inline vector<Sample> ComputeSamples(float roughness, unsigned int pyramidLevels)
+		{
+			// Same as the shaders
+			float alpha				= max(0.001f, roughness * roughness);
+			float alpha2			= alpha * alpha;
+			float texelSolidAngle	= 4.0f * Helper::PI / float(baseWidth * baseHeight);
+
+			vector<Sample> samples;
+			for (unsigned int i = 0; i < specularSamples; i++)
+			{
+				float phi		= Helper::PI_2 * i / float(specularSamples);
+				float e			= RadicalInverse(i);
+				float cosH2		= (1.0f - e) / (1.0f + (alpha2 - 1.0f) * e);
+				float cosH		= sqrtf(cosH2);
+				float sinH		= sqrtf(max(0.0f, 1.0f - cosH2));
+				float nDotL		= 2.0f * cosH2 - 1.0f;
+				if (nDotL <= 0.0f)
+					continue;
+
+				// With N = V the pdf of the reflected direction is D / 4
+				float denominator		= cosH2 * (alpha2 - 1.0f) + 1.0f;
+				float pdf				= alpha2 / (Helper::PI * denominator * denominator) * 0.25f;
+				float sampleSolidAngle	= 1.0f / (specularSamples * pdf + 0.0001f);
+				float level				= Helper::Clamp(0.5f * log2f(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f, float(pyramidLevels - 1));
+
+				Sample sample;
+				sample.direction[0]	= 2.0f * cosH * sinH * cosf(phi);
+				sample.direction[1]	= 2.0f * cosH * sinH * sinf(phi);
+				sample.direction[2]	= nDotL;
+				sample.weight		= nDotL;
+				sample.level		= min((unsigned int)level, pyramidLevels - 1);
+				sample.blend		= sample.level + 1 < pyramidLevels ? level - sample.level : 0.0f;
+				samples.emplace_back(sample);
+			}
+
+			return samples;
+		}
+	}
+
+	IBLGenerator::IBLGenerator(Threading* threading)
+	{
+		m_threading = threading;
+	}
+
+	bool IBLGenerator::Generate(const vector<vector<byte>>& mips, unsigned int width, unsigned int height, Texture_Format format, bool isCubemap, bool isSRGB)
+	{
+		m_irradianceSH.clear();
+		m_specularMips.clear();
+		m_specularWidth		= 0;
+		m_specularHeight	= 0;
+
+		unsigned int faces = isCubemap ? _IBLGenerator::cubemapFaces : 1;
+		if (mips.empty() || mips.size() % faces != 0 || width == 0 || height == 0)
+		{
+			LOG_ERROR("IBLGenerator::Generate: Invalid environment");
+			return false;
+		}
+
+		// Start from the smallest mip which is still as detailed as the pyramid base (a face covers a quarter of its width)
+		unsigned int mipCount	= (unsigned int)mips.size() / faces;
+		unsigned int target		= isCubemap ? _IBLGenerator::baseWidth / 4 : _IBLGenerator::baseWidth;
+		unsigned int mip		= 0;
+		while (mip + 1 < mipCount && max(width >> (mip + 1), 1u) >= target)
+		{
+			mip++;
+		}
+
+		vector<Level> sources(faces);
+		for (unsigned int i = 0; i < faces; i++)
+		{
+			if (!Decode(mips[i * mipCount + mip], max(width >> mip, 1u), max(height >> mip, 1u), format, isSRGB, &sources[i]))
+				return false;
+
+			// Larger sources are box filtered first, so that the bilinear resampling doesn't skip texels
+			while (sources[i].width >= target * 2 && sources[i].height >= 2)
+			{
+				sources[i] = Downsample(sources[i]);
+			}
+		}
+
+		// Resample into the base of the pyramid
+		vector<Level> pyramid(1);
+		auto& base		= pyramid.front();
+		base.width		= _IBLGenerator::baseWidth;
+		base.height		= _IBLGenerator::baseHeight;
+		base.texels.resize((size_t)base.width * base.height * 4);
+		ParallelRows(base.height, base.width, [&base, &sources, isCubemap](unsigned int yStart, unsigned int yEnd)
+		{
+			for (unsigned int y = yStart; y < yEnd; y++)
+			{
+				float v = (y + 0.5f) / base.height;
+				for (unsigned int x = 0; x < base.width; x++)
+				{
+					float u = (x + 0.5f) / base.width;
+					__m128 texel;
+					if (isCubemap)
+					{
+						float direction[3], faceX, faceY;
+						_IBLGenerator::UVToDirection(u, v, direction);
+						const auto& face = sources[_IBLGenerator::DirectionToFace(direction, sources.front().width, &faceX, &faceY)];
+						texel = _IBLGenerator::Bilinear(face.texels.data(), face.width, face.height, faceX, faceY, false);
+					}
+					else
+					{
+						const auto& source = sources.front();
+						texel = _IBLGenerator::Bilinear(source.texels.data(), source.width, source.height, u * source.width - 0.5f, v * source.height - 0.5f, true);
+					}
+					_mm_storeu_ps(base.texels.data() + ((size_t)y * base.width + x) * 4, texel);
+				}
+			}
+		});
+		sources.clear();
+
+		while (pyramid.back().width > 1 && pyramid.back().height > 1)
+		{
+			Level level = Downsample(pyramid.back());
+			pyramid.emplace_back(move(level));
+		}
+
+		// Diffuse
+		for (const auto& level : pyramid)
+		{
+			if (level.width <= _IBLGenerator::irradianceWidth)
+			{
+				ProjectIrradiance(level);
+				break;
+			}
+		}
+
+		// Specular, a mirror doesn't blur the environment
+		m_specularWidth		= pyramid.front().width;
+		m_specularHeight	= pyramid.front().height;
+		m_specularMips.emplace_back(EncodeHalf(pyramid.front()));
+		for (unsigned int i = 1; i < _IBLGenerator::specularLevels; i++)
+		{
+			Level level;
+			Prefilter(pyramid, i, i / float(_IBLGenerator::specularLevels - 1), &level);
+			m_specularMips.emplace_back(EncodeHalf(level));
+		}
+
+		return true;
+	}
+
+	bool IBLGenerator::Decode(const vector<byte>& mip, unsigned int width, unsigned int height, Texture_Format format, bool isSRGB, Level* level)
+	{
+		unsigned int bytesPerTexel = 0;
+		switch (format)
+		{
+			case Texture_Format_R8G8B8A8_UNORM:		bytesPerTexel = 4;	break;
+			case Texture_Format_R16G16B16A16_FLOAT:	bytesPerTexel = 8;	break;
+			case Texture_Format_R32G32B32_FLOAT:	bytesPerTexel = 12;	break;
+			case Texture_Format_R32G32B32A32_FLOAT:	bytesPerTexel = 16;	break;
+			default: break;
+		}
+
+		if (bytesPerTexel == 0)
+		{
+			LOGF_ERROR("IBLGenerator::Decode: Format %d is not supported", (int)format);
+			return false;
+		}
+
+		if (mip.size() < (size_t)width * height * bytesPerTexel)
+		{
+			LOG_ERROR("IBLGenerator::Decode: The mip holds less texels than its dimensions suggest");
+			return false;
+		}
+
+		float unorm8[256];
+		for (unsigned int i = 0; i < 256; i++)
+		{
+			float c		= i / 255.0f;
+			unorm8[i]	= !isSRGB ? c : (c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f));
+		}
+
+		level->width	= width;
+		level->height	= height;
+		level->texels.resize((size_t)width * height * 4);
+		ParallelRows(height, width, [&mip, &unorm8, level, width, format, bytesPerTexel](unsigned int yStart, unsigned int yEnd)
+		{
+			for (size_t i = (size_t)yStart * width; i < (size_t)yEnd * width; i++)
+			{
+				const byte* source	= mip.data() + i * bytesPerTexel;
+				float* dest			= level->texels.data() + i * 4;
+				if (format == Texture_Format_R8G8B8A8_UNORM)
+				{
+					auto bytes = reinterpret_cast<const unsigned char*>(source);
+					for (unsigned int c = 0; c < 3; c++)
+					{
+						dest[c] = unorm8[bytes[c]];
+					}
+				}
+				else if (format == Texture_Format_R16G16B16A16_FLOAT)
+				{
+					unsigned short halves[3];
+					memcpy(halves, source, sizeof(halves));
+					for (unsigned int c = 0; c < 3; c++)
+					{
+						dest[c] = Helper::HalfToFloat(halves[c]);
+					}
+				}
+				else
+				{
+					memcpy(dest, source, 3 * sizeof(float));
+				}
+
+				// Alpha isn't lit
+				dest[3] = 1.0f;
+			}
+		});
+
+		return true;
+	}
+
+	IBLGenerator::Level IBLGenerator::Downsample(const Level& level)
+	{
+		Level result;
+		result.width	= max(level.width / 2, 1u);
+		result.height	= max(level.height / 2, 1u);
+		result.texels.resize((size_t)result.width * result.height * 4);
+		ParallelRows(result.height, result.width, [&level, &result](unsigned int yStart, unsigned int yEnd)
+		{
+			__m128 quarter = _mm_set1_ps(0.25f);
+			for (unsigned int y = yStart; y < yEnd; y++)
+			{
+				const float* row0 = level.texels.data() + (size_t)min(y * 2, level.height - 1) * level.width * 4;
+				const float* row1 = level.texels.data() + (size_t)min(y * 2 + 1, level.height - 1) * level.width * 4;
+				for (unsigned int x = 0; x < result.width; x++)
+				{
+					unsigned int x0 = min(x * 2, level.width - 1) * 4;
+					unsigned int x1 = min(x * 2 + 1, level.width - 1) * 4;
+					__m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)), _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+					_mm_storeu_ps(result.texels.data() + ((size_t)y * result.width + x) * 4, _mm_mul_ps(sum, quarter));
+				}
+			}
+		});
+
+		return result;
+	}
+
+	void IBLGenerator::ProjectIrradiance(const Level& level)
+	{
+		// Every tile keeps its own sums, they are added up in order so the result doesn't depend on the scheduling
+		unsigned int tiles = (level.height + _IBLGenerator::tileRows - 1) / _IBLGenerator::tileRows;
+		vector<float> partial((size_t)tiles * _IBLGenerator::shCount * 4, 0.0f);
+		ParallelRows(level.height, level.width, [&level, &partial](unsigned int yStart, unsigned int yEnd)
+		{
+			__m128 sums[_IBLGenerator::shCount];
+			for (auto& sum : sums)
+			{
+				sum = _mm_setzero_ps();
+			}
+
+			// Equirectangular texels shrink towards the poles
+			float texelSolidAngle = (Helper::PI_2 / level.width) * (Helper::PI / level.height);
+			for (unsigned int y = yStart; y < yEnd; y++)
+			{
+				float v				= (y + 0.5f) / level.height;
+				__m128 solidAngle	= _mm_set1_ps(texelSolidAngle * sinf(v * Helper::PI));
+				for (unsigned int x = 0; x < level.width; x++)
+				{
+					float direction[3], sh[_IBLGenerator::shCount];
+					_IBLGenerator::UVToDirection((x + 0.5f) / level.width, v, direction);
+					_IBLGenerator::EvaluateSH(direction, sh);
+
+					__m128 radiance = _mm_mul_ps(_mm_loadu_ps(level.texels.data() + ((size_t)y * level.width + x) * 4), solidAngle);
+					for (unsigned int i = 0; i < _IBLGenerator::shCount; i++)
+					{
+						sums[i] = _mm_add_ps(sums[i], _mm_mul_ps(radiance, _mm_set1_ps(sh[i])));
+					}
+				}
+			}
+
+			float* dest = partial.data() + (size_t)(yStart / _IBLGenerator::tileRows) * _IBLGenerator::shCount * 4;
+			for (unsigned int i = 0; i < _IBLGenerator::shCount; i++)
+			{
+				_mm_storeu_ps(dest + i * 4, sums[i]);
+			}
+		});
+
+		// Convolve with the clamped cosine (PI, 2PI/3 and PI/4 per band) and divide by PI
+		static const float bands[_IBLGenerator::shCount] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+		m_irradianceSH.assign(_IBLGenerator::shCount, Vector3::Zero);
+		for (unsigned int tile = 0; tile < tiles; tile++)
+		{
+			const float* sums = partial.data() + (size_t)tile * _IBLGenerator::shCount * 4;
+			for (unsigned int i = 0; i < _IBLGenerator::shCount; i++)
+			{
+				m_irradianceSH[i] += Vector3(sums[i * 4], sums[i * 4 + 1], sums[i * 4 + 2]);
+			}
+		}
+
+		for (unsigned int i = 0; i < _IBLGenerator::shCount; i++)
+		{
+			m_irradianceSH[i] *= bands[i];
+		}
+	}
+
+	void IBLGenerator::Prefilter(const vector<Level>& pyramid, unsigned int index, float roughness, Level* level)
+	{
+		auto samples	= _IBLGenerator::ComputeSamples(roughness, (unsigned int)pyramid.size());
+		level->width	= max(pyramid.front().width >> index, 1u);
+		level->height	= max(pyramid.front().height >> index, 1u);
+		level->texels.resize((size_t)level->width * level->height * 4);
+
+		float weights = 0.0f;
+		for (const auto& sample : samples)
+		{
+			weights += sample.weight;
+		}
+
+		if (samples.empty() || weights <= 0.0f)
+			return;
+
+		ParallelRows(level->height, level->width * (unsigned int)samples.size(), [&pyramid, &samples, level, weights](unsigned int yStart, unsigned int yEnd)
+		{
+			__m128 normalize = _mm_set1_ps(1.0f / weights);
+			for (unsigned int y = yStart; y < yEnd; y++)
+			{
+				float v = (y + 0.5f) / level->height;
+				for (unsigned int x = 0; x < level->width; x++)
+				{
+					// Tangent frame around the normal
+					float n[3];
+					_IBLGenerator::UVToDirection((x + 0.5f) / level->width, v, n);
+					float up[3]			= { 0.0f, 1.0f, 0.0f };
+					if (fabsf(n[1]) >= 0.999f)
+					{
+						up[0] = 1.0f;
+						up[1] = 0.0f;
+					}
+					float t[3]			= { up[1] * n[2] - up[2] * n[1], up[2] * n[0] - up[0] * n[2], up[0] * n[1] - up[1] * n[0] };
+					float tLength		= sqrtf(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+					t[0]				/= tLength;
+					t[1]				/= tLength;
+					t[2]				/= tLength;
+					float b[3]			= { n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0] };
+
+					__m128 sum = _mm_setzero_ps();
+					for (const auto& sample : samples)
+					{
+						const float* s		= sample.direction;
+						float direction[3]	=
+						{
+							t[0] * s[0] + b[0] * s[1] + n[0] * s[2],
+							t[1] * s[0] + b[1] * s[1] + n[1] * s[2],
+							t[2] * s[0] + b[2] * s[1] + n[2] * s[2]
+						};
+
+						float u, w;
+						_IBLGenerator::DirectionToUV(direction, &u, &w);
+
+						// Trilinear
+						const auto& source	= pyramid[sample.level];
+						__m128 texel		= _IBLGenerator::Bilinear(source.texels.data(), source.width, source.height, u * source.width - 0.5f, w * source.height - 0.5f, true);
+						if (sample.blend > 0.0f)
+						{
+							const auto& next	= pyramid[sample.level + 1];
+							__m128 texelNext	= _IBLGenerator::Bilinear(next.texels.data(), next.width, next.height, u * next.width - 0.5f, w * next.height - 0.5f, true);
+							texel				= _mm_add_ps(texel, _mm_mul_ps(_mm_sub_ps(texelNext, texel), _mm_set1_ps(sample.blend)));
+						}
+						sum = _mm_add_ps(sum, _mm_mul_ps(texel, _mm_set1_ps(sample.weight)));
+					}
+
+					_mm_storeu_ps(level->texels.data() + ((size_t)y * level->width + x) * 4, _mm_mul_ps(sum, normalize));
+				}
+			}
+		});
+	}
+
+	vector<byte> IBLGenerator::EncodeHalf(const Level& level)
+	{
+		vector<byte> mip((size_t)level.width * level.height * 4 * sizeof(unsigned short));
+		auto dest = reinterpret_cast<unsigned short*>(mip.data());
+		ParallelRows(level.height, level.width, [&level, dest](unsigned int yStart, unsigned int yEnd)
+		{
+			for (size_t i = (size_t)yStart * level.width; i < (size_t)yEnd * level.width; i++)
+			{
+				// Clamped, a bright sun shouldn't turn into infinity
+				for (unsigned int c = 0; c < 3; c++)
+				{
+					dest[i * 4 + c] = Helper::FloatToHalf(Helper::Clamp(level.texels[i * 4 + c], 0.0f, _IBLGenerator::halfMax));
+				}
+				dest[i * 4 + 3] = Helper::FloatToHalf(1.0f);
+			}
+		});
+
+		return mip;
+	}
+
+	void IBLGenerator::ParallelRows(unsigned int rows, unsigned int texelsPerRow, const function<void(unsigned int, unsigned int)>& work)
+	{
+		if (!m_threading || (size_t)rows * texelsPerRow < _IBLGenerator::parallelTexels)
+		{
+			work(0, rows);
+			return;
+		}
+
+		// The tasks only reference the work while this function waits for them
+		TaskGroup group;
+		for (unsigned int y = 0; y < rows; y += _IBLGenerator::tileRows)
+		{
+			unsigned int yEnd = min(y + _IBLGenerator::tileRows, rows);
+			m_threading->AddTask([&work, y, yEnd]() { work(y, yEnd); }, &group);
+		}
+
+		m_threading->Wait(&group);
+	}
+}
\ No newline at end of file
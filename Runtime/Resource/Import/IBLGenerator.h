@@ -0,0 +1,81 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =========================
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include "../../Core/EngineDefs.h"
+#include "../../RHI/RHI_Definition.h"
+#include "../../Math/Vector3.h"
+//====================================
+
+namespace Directus
+{
+	class Threading;
+
+	// Precomputes the image based lighting of an environment: the irradiance, projected onto 9 spherical harmonics, and
+	// a specular chain whose levels are the environment convolved with GGX lobes of increasing roughness. The environment
+	// is resampled into an equirectangular float pyramid which the (importance sampled) lobes read with filtered importance
+	// sampling. Texels are filtered with SSE2 and the rows of each level are split into tiles processed by the worker threads.
+	class ENGINE_CLASS IBLGenerator
+	{
+	public:
+		IBLGenerator(Threading* threading);
+		~IBLGenerator() {}
+
+		// Takes the mips of an equirectangular environment, or the faces of a cubemap (+X, -X, +Y, -Y, +Z, -Z, each followed by its mips)
+		bool Generate(const std::vector<std::vector<std::byte>>& mips, unsigned int width, unsigned int height, Texture_Format format, bool isCubemap, bool isSRGB);
+
+		// Already convolved with the cosine lobe and divided by PI, evaluating them for a normal gives the diffuse light of a white surface
+		const std::vector<Math::Vector3>& GetIrradianceSH()				{ return m_irradianceSH; }
+		// Equirectangular R16G16B16A16_FLOAT levels, the roughness of level i is i / (count - 1)
+		std::vector<std::vector<std::byte>>& GetSpecularMips()			{ return m_specularMips; }
+		unsigned int GetSpecularWidth()									{ return m_specularWidth; }
+		unsigned int GetSpecularHeight()								{ return m_specularHeight; }
+
+		// Changes whenever the output would be different
+		static unsigned int GetVersion() { return 1; }
+
+	private:
+		struct Level
+		{
+			unsigned int width	= 0;
+			unsigned int height	= 0;
+			std::vector<float> texels; // RGBA
+		};
+
+		bool Decode(const std::vector<std::byte>& mip, unsigned int width, unsigned int height, Texture_Format format, bool isSRGB, Level* level);
+		Level Downsample(const Level& level);
+		void ProjectIrradiance(const Level& level);
+		void Prefilter(const std::vector<Level>& pyramid, unsigned int index, float roughness, Level* level);
+		std::vector<std::byte> EncodeHalf(const Level& level);
+		void ParallelRows(unsigned int rows, unsigned int texelsPerRow, const std::function<void(unsigned int, unsigned int)>& work);
+
+		Threading* m_threading;
+		std::vector<Math::Vector3> m_irradianceSH;
+		std::vector<std::vector<std::byte>> m_specularMips;
+		unsigned int m_specularWidth	= 0;
+		unsigned int m_specularHeight	= 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===================
+#include "ImageAnalyzer.h"
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+#include <emmintrin.h>
+#include "../../Logging/Log.h"
+//==============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	bool ImageAnalyzer::Analyze(const byte* data, unsigned int texels, unsigned int channels, unsigned int bytesPerChannel, ImageAnalysis* analysis)
+	{
+		bool validChannelSize = bytesPerChannel == 1 || bytesPerChannel == 2 || bytesPerChannel == 4;
+		if (!data || !analysis || texels == 0 || channels == 0 || channels > 4 || !validChannelSize)
+		{
+			LOGF_ERROR("ImageAnalyzer::Analyze: Can't analyze %d texels of %d channels of %d bytes", texels, channels, bytesPerChannel);
+			return false;
+		}
+
+		*analysis = ImageAnalysis();
+		if (channels == 4 && bytesPerChannel == 1)
+		{
+			AnalyzeUInt8RGBA(reinterpret_cast<const unsigned char*>(data), texels, analysis);
+		}
+		else if (channels == 4 && bytesPerChannel == 4)
+		{
+			AnalyzeFloatRGBA(reinterpret_cast<const float*>(data), texels, analysis);
+		}
+		else
+		{
+			AnalyzeGeneric(data, texels, channels, bytesPerChannel, analysis);
+		}
+
+		Finish(channels, analysis);
+		return true;
+	}
+
+	void ImageAnalyzer::AnalyzeUInt8RGBA(const unsigned char* data, unsigned int texels, ImageAnalysis* analysis)
+	{
+		// A register holds 4 texels, so byte i always holds channel i % 4
+		const __m128i zero		= _mm_setzero_si128();
+		const __m128i ones		= _mm_set1_epi8(-1);
+		const __m128i alphaMask	= _mm_set1_epi32((int)0xff000000);
+		const __m128i colorMask	= _mm_set1_epi32(0x0000ffff);
+		__m128i lowest			= ones;
+		__m128i highest			= zero;
+		__m128i colorDifference	= zero;
+		__m128i partialAlpha	= zero;
+
+		unsigned int vectorTexels = texels & ~3u;
+		for (unsigned int i = 0; i < vectorTexels; i += 4)
+		{
+			__m128i texel4	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (size_t)i * 4));
+			lowest			= _mm_min_epu8(lowest, texel4);
+			highest			= _mm_max_epu8(highest, texel4);
+
+			// Shifting every texel down a channel lines up green with red and blue with green
+			colorDifference = _mm_or_si128(colorDifference, _mm_and_si128(_mm_xor_si128(texel4, _mm_srli_epi32(texel4, 8)), colorMask));
+
+			// Alpha which is neither 0 nor 255
+			__m128i extreme	= _mm_or_si128(_mm_cmpeq_epi8(texel4, zero), _mm_cmpeq_epi8(texel4, ones));
+			partialAlpha	= _mm_or_si128(partialAlpha, _mm_andnot_si128(extreme, alphaMask));
+		}
+
+		unsigned char lowestLanes[16], highestLanes[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lowestLanes), lowest);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(highestLanes), highest);
+		unsigned char lowestChannel[4]	= { 255, 255, 255, 255 };
+		unsigned char highestChannel[4]	= { 0, 0, 0, 0 };
+		for (unsigned int lane = 0; lane < 16; lane++)
+		{
+			lowestChannel[lane % 4]		= min(lowestChannel[lane % 4], lowestLanes[lane]);
+			highestChannel[lane % 4]	= max(highestChannel[lane % 4], highestLanes[lane]);
+		}
+		bool grayscale		= _mm_movemask_epi8(_mm_cmpeq_epi8(colorDifference, zero)) == 0xffff;
+		bool alphaBinary	= _mm_movemask_epi8(_mm_cmpeq_epi8(partialAlpha, zero)) == 0xffff;
+
+		// The texels which don't fill a register
+		for (unsigned int i = vectorTexels; i < texels; i++)
+		{
+			const unsigned char* texel = data + (size_t)i * 4;
+			for (unsigned int c = 0; c < 4; c++)
+			{
+				lowestChannel[c]	= min(lowestChannel[c], texel[c]);
+				highestChannel[c]	= max(highestChannel[c], texel[c]);
+			}
+			grayscale	= grayscale && texel[0] == texel[1] && texel[1] == texel[2];
+			alphaBinary	= alphaBinary && (texel[3] == 0 || texel[3] == 255);
+		}
+
+		for (unsigned int c = 0; c < 4; c++)
+		{
+			analysis->minimum[c] = lowestChannel[c] / 255.0f;
+			analysis->maximum[c] = highestChannel[c] / 255.0f;
+		}
+		analysis->grayscale		= grayscale;
+		analysis->alphaBinary	= alphaBinary;
+	}
+
+	void ImageAnalyzer::AnalyzeFloatRGBA(const float* data, unsigned int texels, ImageAnalysis* analysis)
+	{
+		// A register holds a texel
+		const __m128 zero			= _mm_setzero_ps();
+		const __m128 one			= _mm_set1_ps(1.0f);
+		__m128 lowest				= _mm_set1_ps(FLT_MAX);
+		__m128 highest				= _mm_set1_ps(-FLT_MAX);
+		__m128 colorDifference		= zero;
+		__m128 partialAlpha			= zero;
+
+		for (unsigned int i = 0; i < texels; i++)
+		{
+			__m128 texel	= _mm_loadu_ps(data + (size_t)i * 4);
+			lowest			= _mm_min_ps(lowest, texel);
+			highest			= _mm_max_ps(highest, texel);
+
+			// Red against green and green against blue, in the first two lanes
+			colorDifference = _mm_or_ps(colorDifference, _mm_cmpneq_ps(texel, _mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 2, 1))));
+
+			// Alpha (the last lane) which is neither 0 nor 1
+			partialAlpha = _mm_or_ps(partialAlpha, _mm_and_ps(_mm_cmpneq_ps(texel, zero), _mm_cmpneq_ps(texel, one)));
+		}
+
+		_mm_storeu_ps(analysis->minimum, lowest);
+		_mm_storeu_ps(analysis->maximum, highest);
+		analysis->grayscale		= (_mm_movemask_ps(colorDifference) & 3) == 0;
+		analysis->alphaBinary	= (_mm_movemask_ps(partialAlpha) & 8) == 0;
+	}
+
+	void ImageAnalyzer::AnalyzeGeneric(const byte* data, unsigned int texels, unsigned int channels, unsigned int bytesPerChannel, ImageAnalysis* analysis)
+	{
+		float lowest[4]		= { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX };
+		float highest[4]	= { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		bool grayscale		= channels >= 3;
+		bool alphaBinary	= true;
+
+		for (unsigned int i = 0; i < texels; i++)
+		{
+			float texel[4];
+			for (unsigned int c = 0; c < channels; c++)
+			{
+				const byte* value = data + ((size_t)i * channels + c) * bytesPerChannel;
+				switch (bytesPerChannel)
+				{
+					case 1:
+						texel[c] = static_cast<unsigned char>(*value) / 255.0f;
+						break;
+					case 2:
+					{
+						unsigned short word;
+						memcpy(&word, value, sizeof(word));
+						texel[c] = word / 65535.0f;
+						break;
+					}
+					default:
+						memcpy(&texel[c], value, sizeof(float));
+						break;
+				}
+
+				lowest[c]	= min(lowest[c], texel[c]);
+				highest[c]	= max(highest[c], texel[c]);
+			}
+
+			grayscale	= grayscale && texel[0] == texel[1] && texel[1] == texel[2];
+			alphaBinary	= alphaBinary && (channels < 4 || texel[3] == 0.0f || texel[3] == 1.0f);
+		}
+
+		memcpy(analysis->minimum, lowest, sizeof(float) * channels);
+		memcpy(analysis->maximum, highest, sizeof(float) * channels);
+		analysis->grayscale		= grayscale || channels == 1;
+		analysis->alphaBinary	= alphaBinary;
+	}
+
+	void ImageAnalyzer::Finish(unsigned int channels, ImageAnalysis* analysis)
+	{
+		for (unsigned int c = 0; c < 4; c++)
+		{
+			// Missing channels read as 0, except alpha which reads as 1
+			if (c >= channels)
+			{
+				analysis->minimum[c] = analysis->maximum[c] = c == 3 ? 1.0f : 0.0f;
+			}
+
+			analysis->constant[c]	= analysis->minimum[c] == analysis->maximum[c];
+			analysis->range			= max(analysis->range, max(fabs(analysis->minimum[c]), fabs(analysis->maximum[c])));
+		}
+
+		analysis->alphaUsed = analysis->minimum[3] < 1.0f;
+	}
+}
\ No newline at end of file
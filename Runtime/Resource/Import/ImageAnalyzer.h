@@ -0,0 +1,64 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <cstddef>
+#include "../../Core/EngineDefs.h"
+//================================
+
+namespace Directus
+{
+	// What the texels of an image actually use, values are normalized (integer channels map to 0-1)
+	struct ImageAnalysis
+	{
+		float minimum[4]	= { 0.0f, 0.0f, 0.0f, 0.0f };
+		float maximum[4]	= { 0.0f, 0.0f, 0.0f, 0.0f };
+		bool constant[4]	= { true, true, true, true };
+		// Red, green and blue are equal in every texel
+		bool grayscale		= false;
+		// Some texel is not fully opaque
+		bool alphaUsed		= false;
+		// Every texel is either fully transparent or fully opaque
+		bool alphaBinary	= true;
+		// The largest magnitude of any channel
+		float range			= 0.0f;
+	};
+
+	// A single pass over decoded texels which finds the value range of every channel and how the channels relate to
+	// each other, so the importer can store the image in the smallest format which keeps what the shaders read.
+	// 8-bit RGBA and float RGBA texels are processed four channels at a time with SSE2.
+	class ENGINE_CLASS ImageAnalyzer
+	{
+	public:
+		static bool Analyze(const std::byte* data, unsigned int texels, unsigned int channels, unsigned int bytesPerChannel, ImageAnalysis* analysis);
+
+		// Changes whenever the result would be different
+		static unsigned int GetVersion() { return 1; }
+
+	private:
+		static void AnalyzeUInt8RGBA(const unsigned char* data, unsigned int texels, ImageAnalysis* analysis);
+		static void AnalyzeFloatRGBA(const float* data, unsigned int texels, ImageAnalysis* analysis);
+		static void AnalyzeGeneric(const std::byte* data, unsigned int texels, unsigned int channels, unsigned int bytesPerChannel, ImageAnalysis* analysis);
+		static void Finish(unsigned int channels, ImageAnalysis* analysis);
+	};
+}
\ No newline at end of file
@@ -23,12 +23,16 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =========================
 #include "ImageImporter.h"
+#include "MipGenerator.h"
+#include "BlockCompressor.h"
+#include "ImageAnalyzer.h"
 #include <FreeImage.h>
 #include <Utilities.h>
 #include "../../Threading/Threading.h"
 #include "../../Core/Settings.h"
 #include "../../RHI/RHI_Texture.h"
 #include "../../Math/MathHelper.h"
+#include "../../Core/Hash.h"
 //====================================
 
 //= NAMESPACES =====
@@ -38,23 +42,14 @@ using namespace std;
 namespace _ImagImporter
 {
 	FREE_IMAGE_FILTER rescaleFilter = FILTER_LANCZOS3;
+	// Largest finite half float
+	static const float halfMax = 65504.0f;
 
-	// A struct that rescaling threads will work with
-	struct RescaleJob
+	// Number of channels the shaders read, for the textures that declare it
+	inline unsigned int ComputeReadChannels(Directus::Texture_Compression compression)
 	{
-		unsigned int width		= 0;
-		unsigned int height		= 0;
-		unsigned int channels	= 0;
-		vector<byte>* data		= nullptr;
-		bool done				= false;
-
-		RescaleJob(unsigned int width, unsigned int height, unsigned int channels)
-		{
-			this->width		= width;
-			this->height	= height;
-			this->channels	= channels;
-		}
-	};
+		return compression == Directus::Texture_Compression_Red ? 1 : compression == Directus::Texture_Compression_Normal ? 2 : 4;
+	}
 }
 
 namespace Directus
@@ -84,8 +79,13 @@ namespace Directus
 			return false;
 		}
 
+		// Files in mounted archives are decoded straight from memory
+		const std::byte* data	= nullptr;
+		size_t size				= 0;
+		FIMEMORY* memory		= FileSystem::GetMountedFile(filePath, &data, &size) ? FreeImage_OpenMemory((BYTE*)data, (DWORD)size) : nullptr;
+
 		// Get image format
-		FREE_IMAGE_FORMAT format = FreeImage_GetFileType(filePath.c_str(), 0);
+		FREE_IMAGE_FORMAT format = memory ? FreeImage_GetFileTypeFromMemory(memory, 0) : FreeImage_GetFileType(filePath.c_str(), 0);
 
 		// If the format is unknown
 		if (format == FIF_UNKNOWN)
@@ -98,6 +98,7 @@ namespace Directus
 			if (!FreeImage_FIFSupportsReading(format))
 			{
 				LOGF_ERROR("ImageImporter::Load: Failed to detect the image format.");
+				if (memory) FreeImage_CloseMemory(memory);
 				return false;
 			}
 
@@ -105,7 +106,8 @@ namespace Directus
 		}
 
 		// Load the image
-		FIBITMAP* bitmap = FreeImage_Load(format, filePath.c_str());
+		FIBITMAP* bitmap = memory ? FreeImage_LoadFromMemory(format, memory) : FreeImage_Load(format, filePath.c_str());
+		if (memory) FreeImage_CloseMemory(memory);
 	
 		// Perform some fix ups
 		bitmap = ApplyBitmapCorrections(bitmap);
@@ -127,17 +129,46 @@ namespace Directus
 		bool image_grayscale				= IsVisuallyGrayscale(bitmap);
 
 		// Fill RGBA vector with the data from the FIBITMAP
-		auto mip = texture->Data_AddMipLevel();
-		GetBitsFromFIBITMAP(mip, bitmap, image_width, image_height, image_channels);
+		vector<MipLevel> mips(1);
+		GetBitsFromFIBITMAP(&mips.front(), bitmap, image_width, image_height, image_channels);
+
+		// Free memory 
+		FreeImage_Unload(bitmap);
+
+		// Find out what the texels actually use, textures which say what the shaders read from them are stored in the smallest format that keeps it
+		ImageAnalysis analysis;
+		bool analyzed						= ImageAnalyzer::Analyze(mips.front().data(), image_width * image_height, image_channels, image_bpc, &analysis);
+		Texture_Compression compression		= analyzed ? texture->GetCompression() : Texture_Compression_None;
+		image_transparency					= analyzed ? analysis.alphaUsed : image_transparency;
+		image_grayscale						= image_grayscale || (analyzed && analysis.grayscale);
+
+		// A grayscale normal map is a height map (see Material), which only needs its red channel
+		compression = (compression == Texture_Compression_Normal && image_grayscale) ? Texture_Compression_Red : compression;
+
+		// A single color is stored as a single texel, it samples the same
+		if (compression != Texture_Compression_None && IsConstant(analysis, _ImagImporter::ComputeReadChannels(compression)))
+		{
+			mips.front().resize(image_channels * image_bpc);
+			image_width		= 1;
+			image_height	= 1;
+		}
 
 		// If the texture requires mip-maps, generate them
 		if (texture->GetNeedsMipChain())
 		{
-			GenerateMipmaps(bitmap, texture, image_width, image_height, image_channels);
+			GenerateMipmaps(&mips, texture, image_width, image_height, image_channels, image_bpc);
 		}
 
-		// Free memory 
-		FreeImage_Unload(bitmap);
+		if (compression != Texture_Compression_None)
+		{
+			ReduceFormat(&mips, compression, analysis, image_width, image_height, &image_channels, &image_bpc, &image_format);
+			image_bpp = image_channels * image_bpc * 8;
+		}
+
+		for (auto& mip : mips)
+		{
+			*texture->Data_AddMipLevel() = move(mip);
+		}
 
 		// Fill RHI_Texture with image properties
 		texture->SetBPP(image_bpp);
@@ -152,6 +183,20 @@ namespace Directus
 		return true;
 	}
 
+	unsigned long long ImageImporter::GetSettingsHash(RHI_Texture* texture)
+	{
+		unsigned long long hash = Hash::Compute(Settings::Get().m_versionFreeImage);
+		hash = Hash::Combine(hash, Hash::ComputeValue(texture ? texture->GetNeedsMipChain() : false));
+		hash = Hash::Combine(hash, Hash::ComputeValue(MipGenerator::GetVersion()));
+		hash = Hash::Combine(hash, Hash::ComputeValue(texture ? texture->GetSRGB() : false));
+		hash = Hash::Combine(hash, Hash::ComputeValue(texture ? texture->GetMipAlphaReference() : 0.0f));
+		hash = Hash::Combine(hash, Hash::ComputeValue(BlockCompressor::GetVersion()));
+		hash = Hash::Combine(hash, Hash::ComputeValue(texture ? texture->GetCompression() : Texture_Compression_None));
+		hash = Hash::Combine(hash, Hash::ComputeValue(ImageAnalyzer::GetVersion()));
+
+		return hash;
+	}
+
 	bool ImageImporter::GetBitsFromFIBITMAP(vector<byte>* data, FIBITMAP* bitmap, unsigned int width, unsigned int height, unsigned int channels)
 	{
 		if (!data || width == 0 || height == 0 || channels == 0)
@@ -176,61 +221,29 @@ namespace Directus
 		return true;
 	}
 
-	void ImageImporter::GenerateMipmaps(FIBITMAP* bitmap, RHI_Texture* texture, unsigned int width, unsigned int height, unsigned int channels)
+	void ImageImporter::GenerateMipmaps(vector<vector<byte>>* mips, RHI_Texture* texture, unsigned int width, unsigned int height, unsigned int channels, unsigned int bytesPerChannel)
 	{
-		if (!texture)
+		if (!mips || !texture)
 			return;
-	
-		// Create a RescaleJob for every mip that we need
-		vector<_ImagImporter::RescaleJob> jobs;
-		while (width > 1 && height > 1)
-		{
-			width	= Math::Helper::Max(width / 2, (unsigned int)1);
-			height	= Math::Helper::Max(height / 2, (unsigned int)1);
-			jobs.emplace_back(width, height, channels);
-			
-			// Resize the RHI_Texture vector accordingly
-			unsigned int size = width * height * channels;
-			vector<byte>* mip = texture->Data_AddMipLevel();
-			mip->reserve(size);
-			mip->resize(size);
-		}
 
-		// Pass data pointers (now that the RHI_Texture mip vector has been constructed)
-		for (unsigned int i = 0; i < jobs.size(); i++)
+		Mip_Channel type;
+		switch (bytesPerChannel)
 		{
-			// reminder: i + 1 because the 0 mip is the default image size
-			jobs[i].data = texture->Data_GetMipLevel(i + 1);
-		}
-
-		// Parallelize mipmap generation using multiple threads (because FreeImage_Rescale() using FILTER_LANCZOS3 is expensive)
-		auto threading = m_context->GetSubsystem<Threading>();
-		for (auto& job : jobs)
-		{
-			threading->AddTask([this, &job, &bitmap]()
-			{
-				FIBITMAP* bitmapScaled = FreeImage_Rescale(bitmap, job.width, job.height, _ImagImporter::rescaleFilter);
-				if (!GetBitsFromFIBITMAP(job.data, bitmapScaled, job.width, job.height, job.channels))
-				{
-					LOGF_ERROR("ImageImporter:GenerateMipmapsFromFIBITMAP: Failed to create mip level %dx%d", job.width, job.height);
-				}
-				FreeImage_Unload(bitmapScaled);
-				job.done = true;
-			});
+			case 1:		type = Mip_UInt8;	break;
+			case 2:		type = Mip_UInt16;	break;
+			case 4:		type = Mip_Float;	break;
+			default:
+				LOGF_ERROR("ImageImporter::GenerateMipmaps: Unsupported channel size (%d bytes)", bytesPerChannel);
+				return;
 		}
 
-		// Wait until all mipmaps have been generated
-		bool ready = false;
-		while (!ready)
+		// Every mip is filtered from the previous one, the rows of each mip are split across the worker threads
+		MipGenerator generator(m_context->GetSubsystem<Threading>());
+		generator.SetSRGB(texture->GetSRGB());
+		generator.SetAlphaReference(texture->GetMipAlphaReference());
+		if (!generator.Generate(mips, width, height, channels, type))
 		{
-			ready = true;
-			for (const auto& job : jobs)
-			{
-				if (!job.done)
-				{
-					ready = false;
-				}
-			}
+			LOGF_ERROR("ImageImporter::GenerateMipmaps: Failed to generate mip chain for %dx%d image", width, height);
 		}
 	}
 
@@ -289,6 +302,97 @@ namespace Directus
 		return Texture_Format_R8G8B8A8_UNORM;
 	}
 
+	void ImageImporter::ReduceFormat(vector<MipLevel>* mips, Texture_Compression compression, const ImageAnalysis& analysis, unsigned int width, unsigned int height, unsigned int* channels, unsigned int* bytesPerChannel, Texture_Format* format)
+	{
+		unsigned int readChannels = _ImagImporter::ComputeReadChannels(compression);
+
+		// 8-bit RGBA is block compressed when the blocks line up, the rest only keeps the channels that are read
+		if (*bytesPerChannel == 1 && *channels == 4)
+		{
+			if (width % 4 == 0 && height % 4 == 0)
+			{
+				Texture_Format compressedFormat = ComputeCompressedFormat(compression, analysis);
+				if (BlockCompressor(m_context->GetSubsystem<Threading>()).Compress(mips, width, height, compressedFormat))
+				{
+					*format = compressedFormat;
+					return;
+				}
+			}
+
+			// There is no 3 channel 8-bit format, so color keeps its (unused) alpha
+			if (readChannels == 4)
+				return;
+
+			for (auto& mip : *mips)
+			{
+				size_t texels = mip.size() / 4;
+				for (size_t i = 0; i < texels; i++)
+				{
+					for (unsigned int c = 0; c < readChannels; c++)
+					{
+						mip[i * readChannels + c] = mip[i * 4 + c];
+					}
+				}
+				mip.resize(texels * readChannels);
+				mip.shrink_to_fit();
+			}
+
+			*channels	= readChannels;
+			*format		= readChannels == 1 ? Texture_Format_R8_UNORM : Texture_Format_R8G8_UNORM;
+			return;
+		}
+
+		// HDR is stored as half floats when it fits their range, color gets an opaque alpha as there is no 3 channel half format
+		if (*bytesPerChannel == 4 && analysis.range <= _ImagImporter::halfMax)
+		{
+			for (auto& mip : *mips)
+			{
+				size_t texels = mip.size() / (*channels * sizeof(float));
+				vector<byte> halves(texels * readChannels * sizeof(unsigned short));
+				auto source	= reinterpret_cast<const float*>(mip.data());
+				auto dest	= reinterpret_cast<unsigned short*>(halves.data());
+				for (size_t i = 0; i < texels; i++)
+				{
+					for (unsigned int c = 0; c < readChannels; c++)
+					{
+						float value = c < *channels ? source[i * *channels + c] : 1.0f;
+						dest[i * readChannels + c] = Math::Helper::FloatToHalf(value);
+					}
+				}
+				mip = move(halves);
+			}
+
+			*channels			= readChannels;
+			*bytesPerChannel	= 2;
+			*format				= readChannels == 1 ? Texture_Format_R16_FLOAT : readChannels == 2 ? Texture_Format_R16G16_FLOAT : Texture_Format_R16G16B16A16_FLOAT;
+		}
+	}
+
+	Texture_Format ImageImporter::ComputeCompressedFormat(Texture_Compression compression, const ImageAnalysis& analysis)
+	{
+		switch (compression)
+		{
+			case Texture_Compression_Red:				return Texture_Format_BC4_UNORM;
+			case Texture_Compression_Normal:			return Texture_Format_BC5_UNORM;
+			case Texture_Compression_ColorHighQuality:	return Texture_Format_BC7_UNORM;
+			default: break;
+		}
+
+		// BC1 can only store alpha which is on or off
+		return (!analysis.alphaUsed || analysis.alphaBinary) ? Texture_Format_BC1_UNORM : Texture_Format_BC3_UNORM;
+	}
+
+	bool ImageImporter::IsConstant(const ImageAnalysis& analysis, unsigned int channels)
+	{
+		for (unsigned int c = 0; c < channels; c++)
+		{
+			if (!analysis.constant[c])
+				return false;
+		}
+
+		return true;
+	}
+
 	bool ImageImporter::IsVisuallyGrayscale(FIBITMAP* bitmap)
 	{
 		switch (FreeImage_GetBPP(bitmap))
@@ -69,6 +69,7 @@ struct FIBITMAP;
 namespace Directus
 {
 	class Context;
+	struct ImageAnalysis;
 
 	class ENGINE_CLASS ImageImporter
 	{
@@ -77,14 +78,19 @@ namespace Directus
 		~ImageImporter();
 
 		bool Load(const std::string& filePath, RHI_Texture* texture);
+		// Hash of anything that affects the imported data, other than the source file
+		unsigned long long GetSettingsHash(RHI_Texture* texture);
 
 	private:	
 		bool GetBitsFromFIBITMAP(std::vector<std::byte>* data, FIBITMAP* bitmap, unsigned int width, unsigned int height, unsigned int channels);
-		void GenerateMipmaps(FIBITMAP* bitmap, RHI_Texture* texture, unsigned int width, unsigned int height, unsigned int channels);
+		void GenerateMipmaps(std::vector<std::vector<std::byte>>* mips, RHI_Texture* texture, unsigned int width, unsigned int height, unsigned int channels, unsigned int bytesPerChannel);
 
 		unsigned int ComputeChannelCount(FIBITMAP* bitmap);
 		unsigned int ComputeBytesPerChannel(FIBITMAP* bitmap);
 		Texture_Format ComputeTextureFormat(unsigned int bpp, unsigned int channels);
+		void ReduceFormat(std::vector<std::vector<std::byte>>* mips, Texture_Compression compression, const ImageAnalysis& analysis, unsigned int width, unsigned int height, unsigned int* channels, unsigned int* bytesPerChannel, Texture_Format* format);
+		Texture_Format ComputeCompressedFormat(Texture_Compression compression, const ImageAnalysis& analysis);
+		bool IsConstant(const ImageAnalysis& analysis, unsigned int channels);
 		bool IsVisuallyGrayscale(FIBITMAP* bitmap);
 		FIBITMAP* ApplyBitmapCorrections(FIBITMAP* bitmap);
 		FIBITMAP* _FreeImage_ConvertTo32Bits(FIBITMAP* bitmap);
@@ -0,0 +1,913 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include "../../RHI/RHI_Vertex.h"
+#include "../../Math/BoundingBox.h"
+#include "../../Logging/Log.h"
+//=================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	namespace _MeshOptimizer
+	{
+		// Post-transform cache entries the optimizer targets and the statistics simulate
+		static const unsigned int cacheSize	= 16;
+		static const unsigned int invalid	= ~0u;
+		// Cluster size, a cluster which already has clusterMinTriangles ends at the first triangle that isn't connected to it
+		static const unsigned int clusterMinTriangles	= 64;
+		static const unsigned int clusterMaxTriangles	= 128;
+		static const unsigned int clusterMaxVertices	= 128;
+
+		// Levels of detail, a level is only kept when it has no more than lodMaxRatio of the triangles of the previous level
+		static const unsigned int lodMaxLevels		= 4;
+		static const unsigned int lodMinTriangles	= 64;
+		static const float lodMaxRatio				= 0.75f;
+		// Largest error of a level, relative to the size of the submesh
+		static const float lodMaxError				= 0.05f;
+		// A triangle may not end up further than about 75 degrees from the normals of its vertices, which keeps it from standing on its edge
+		static const float lodMinNormalDot			= 0.25f;
+		// How much more than the surface open edges resist being moved
+		static const float lodBorderWeight			= 10.0f;
+
+		// A FIFO cache which remembers when each vertex went in, a vertex is still in there
+		// when fewer than cacheSize vertices went in after it
+		struct FifoCache
+		{
+			FifoCache(unsigned int vertexCount) : timestamps(vertexCount, 0) {}
+
+			unsigned int Touch(unsigned int vertex)
+			{
+				if (time - timestamps[vertex] <= cacheSize)
+					return 0;
+
+				timestamps[vertex] = time++;
+				return 1;
+			}
+
+			unsigned int Touch(const unsigned int* triangle)
+			{
+				return Touch(triangle[0]) + Touch(triangle[1]) + Touch(triangle[2]);
+			}
+
+			void Flush() { time += cacheSize + 1; }
+
+			vector<unsigned int> timestamps;
+			unsigned int time = cacheSize + 1;
+		};
+
+		// The triangles which use each vertex
+		struct Adjacency
+		{
+			Adjacency(const vector<unsigned int>& indices, unsigned int vertexCount)
+			{
+				counts.assign(vertexCount, 0);
+				for (auto index : indices)
+				{
+					counts[index]++;
+				}
+
+				offsets.resize(vertexCount + 1);
+				offsets[0] = 0;
+				for (unsigned int i = 0; i < vertexCount; i++)
+				{
+					offsets[i + 1] = offsets[i] + counts[i];
+				}
+
+				triangles.resize(indices.size());
+				vector<unsigned int> cursors(offsets.begin(), offsets.end() - 1);
+				for (unsigned int i = 0; i < (unsigned int)indices.size(); i++)
+				{
+					triangles[cursors[indices[i]]++] = i / 3;
+				}
+			}
+
+			vector<unsigned int> counts;
+			vector<unsigned int> offsets;
+			vector<unsigned int> triangles;
+		};
+
+		static Mesh_Cluster ComputeCluster(const vector<unsigned int>& indices, const vector<RHI_Vertex_PosUVTBN>& vertices, unsigned int start, unsigned int end)
+		{
+			auto position = [&](unsigned int index) { const auto& vertex = vertices[indices[index]]; return Vector3(vertex.pos[0], vertex.pos[1], vertex.pos[2]); };
+
+			Mesh_Cluster cluster;
+			cluster.indexOffset	= start * 3;
+			cluster.indexCount	= (end - start) * 3;
+
+			// Sphere around the center of the bounding box
+			BoundingBox bounds;
+			for (auto i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i++)
+			{
+				bounds.Merge(BoundingBox(position(i), position(i)));
+			}
+			cluster.center = bounds.GetCenter();
+			for (auto i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i++)
+			{
+				cluster.radius = Helper::Max(cluster.radius, (position(i) - cluster.center).Length());
+			}
+
+			// Cone around the average normal, which is only of use when it's narrower than a hemisphere
+			vector<Vector3> normals;
+			normals.reserve(end - start);
+			for (auto triangle = start; triangle < end; triangle++)
+			{
+				auto a		= position(triangle * 3 + 0);
+				auto normal	= Vector3::Cross(position(triangle * 3 + 1) - a, position(triangle * 3 + 2) - a);
+				float area	= normal.Length();
+				if (area > 0.0f)
+				{
+					normals.emplace_back(normal / area);
+					cluster.coneAxis += normals.back();
+				}
+			}
+
+			float length = cluster.coneAxis.Length();
+			if (length <= 0.0f)
+				return cluster;
+			cluster.coneAxis = cluster.coneAxis / length;
+
+			float minDot = 1.0f;
+			for (const auto& normal : normals)
+			{
+				minDot = Helper::Min(minDot, Vector3::Dot(normal, cluster.coneAxis));
+			}
+			cluster.coneCutoff = minDot > 0.0f ? Helper::Sqrt(1.0f - minDot * minDot) : 1.0f;
+
+			return cluster;
+		}
+
+		// Squared distances to planes, weighted by area. The weights add up so that the error is an average distance.
+		struct Quadric
+		{
+			void AddPlane(const Vector3& normal, float distance, float planeWeight)
+			{
+				double a = normal.x, b = normal.y, c = normal.z, d = distance, w = planeWeight;
+				xx += w * a * a; xy += w * a * b; xz += w * a * c;
+				yy += w * b * b; yz += w * b * c; zz += w * c * c;
+				xd += w * a * d; yd += w * b * d; zd += w * c * d;
+				dd += w * d * d;
+				weight += w;
+			}
+
+			void Add(const Quadric& other)
+			{
+				xx += other.xx; xy += other.xy; xz += other.xz;
+				yy += other.yy; yz += other.yz; zz += other.zz;
+				xd += other.xd; yd += other.yd; zd += other.zd;
+				dd += other.dd;
+				weight += other.weight;
+			}
+
+			float GetError(const Vector3& position) const
+			{
+				if (weight <= 0.0)
+					return 0.0f;
+
+				double x = position.x, y = position.y, z = position.z;
+				double error =
+					xx * x * x + yy * y * y + zz * z * z +
+					2.0 * (xy * x * y + xz * x * z + yz * y * z) +
+					2.0 * (xd * x + yd * y + zd * z) +
+					dd;
+
+				return (float)sqrt(max(error / weight, 0.0));
+			}
+
+			double xx = 0.0, xy = 0.0, xz = 0.0, yy = 0.0, yz = 0.0, zz = 0.0;
+			double xd = 0.0, yd = 0.0, zd = 0.0, dd = 0.0;
+			double weight = 0.0;
+		};
+
+		// How a vertex may move during simplification
+		enum Simplify_Vertex
+		{
+			Simplify_Vertex_Manifold,	// anywhere along its edges
+			Simplify_Vertex_Border,		// along the open edges it's on
+			Simplify_Vertex_Locked		// not at all, it's on a UV seam or where the surface isn't a manifold
+		};
+
+		// Vertices at the same position are one vertex to the simplification, this maps each vertex to the first one at its position
+		static vector<unsigned int> ComputePositionRemap(const vector<RHI_Vertex_PosUVTBN>& vertices)
+		{
+			auto less = [&vertices](unsigned int a, unsigned int b) { return lexicographical_compare(vertices[a].pos, vertices[a].pos + 3, vertices[b].pos, vertices[b].pos + 3); };
+
+			vector<unsigned int> order(vertices.size());
+			for (unsigned int i = 0; i < (unsigned int)order.size(); i++)
+			{
+				order[i] = i;
+			}
+			stable_sort(order.begin(), order.end(), less);
+
+			vector<unsigned int> remap(vertices.size());
+			for (unsigned int i = 0; i < (unsigned int)order.size(); i++)
+			{
+				remap[order[i]] = (i != 0 && !less(order[i - 1], order[i])) ? remap[order[i - 1]] : order[i];
+			}
+
+			return remap;
+		}
+
+		static unsigned long long EdgeKey(unsigned int a, unsigned int b)
+		{
+			return a < b ? ((unsigned long long)a << 32) | b : ((unsigned long long)b << 32) | a;
+		}
+
+		static bool Validate(const vector<unsigned int>& indices, unsigned int vertexCount)
+		{
+			if (indices.size() % 3 != 0)
+				return false;
+
+			for (auto index : indices)
+			{
+				if (index >= vertexCount)
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+	bool MeshOptimizer::Optimize(vector<unsigned int>* indices, vector<RHI_Vertex_PosUVTBN>* vertices, MeshOptimizer_Statistics* before, MeshOptimizer_Statistics* after)
+	{
+		if (!indices || !vertices || !_MeshOptimizer::Validate(*indices, (unsigned int)vertices->size()))
+		{
+			LOG_WARNING("MeshOptimizer::Optimize: Expected an indexed triangle list");
+			return false;
+		}
+
+		if (before)
+		{
+			before->Add(Analyze(*indices, (unsigned int)vertices->size()));
+		}
+
+		OptimizeVertexCache(indices, (unsigned int)vertices->size());
+		OptimizeOverdraw(indices, *vertices);
+		OptimizeVertexFetch(indices, vertices);
+
+		if (after)
+		{
+			after->Add(Analyze(*indices, (unsigned int)vertices->size()));
+		}
+
+		return true;
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(vector<unsigned int>* indices, unsigned int vertexCount)
+	{
+		using namespace _MeshOptimizer;
+
+		auto triangleCount = (unsigned int)indices->size() / 3;
+		if (triangleCount == 0)
+			return;
+
+		Adjacency adjacency(*indices, vertexCount);
+		auto& liveTriangles = adjacency.counts;
+		vector<unsigned int> timestamps(vertexCount, 0);
+		vector<bool> emitted(triangleCount, false);
+		vector<unsigned int> deadEnds;
+		vector<unsigned int> candidates;
+		vector<unsigned int> result;
+		deadEnds.reserve(indices->size());
+		result.reserve(indices->size());
+		unsigned int time	= cacheSize + 1;
+		unsigned int cursor	= 0;
+
+		// Vertices which were used recently and still have triangles left, then any vertex which has triangles left
+		auto skipDeadEnd = [&]()
+		{
+			while (!deadEnds.empty())
+			{
+				auto vertex = deadEnds.back();
+				deadEnds.pop_back();
+				if (liveTriangles[vertex] > 0)
+					return vertex;
+			}
+
+			for (; cursor < vertexCount; cursor++)
+			{
+				if (liveTriangles[cursor] > 0)
+					return cursor;
+			}
+
+			return invalid;
+		};
+
+		auto fanning = skipDeadEnd();
+		while (fanning != invalid)
+		{
+			// Emit the remaining triangles around the fanning vertex
+			candidates.clear();
+			for (auto i = adjacency.offsets[fanning]; i < adjacency.offsets[fanning + 1]; i++)
+			{
+				auto triangle = adjacency.triangles[i];
+				if (emitted[triangle])
+					continue;
+
+				for (unsigned int corner = 0; corner < 3; corner++)
+				{
+					auto vertex = (*indices)[triangle * 3 + corner];
+					result.emplace_back(vertex);
+					deadEnds.emplace_back(vertex);
+					candidates.emplace_back(vertex);
+					liveTriangles[vertex]--;
+
+					if (time - timestamps[vertex] > cacheSize)
+					{
+						timestamps[vertex] = time++;
+					}
+				}
+				emitted[triangle] = true;
+			}
+
+			// Fan around the candidate which entered the cache the earliest but will still be in there after its triangles are emitted
+			auto next		= invalid;
+			int priority	= -1;
+			for (auto vertex : candidates)
+			{
+				if (liveTriangles[vertex] == 0)
+					continue;
+
+				auto age					= time - timestamps[vertex];
+				int candidatePriority		= age + 2 * liveTriangles[vertex] <= cacheSize ? (int)age : 0;
+				if (candidatePriority > priority)
+				{
+					priority	= candidatePriority;
+					next		= vertex;
+				}
+			}
+
+			fanning = next != invalid ? next : skipDeadEnd();
+		}
+
+		indices->swap(result);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(vector<unsigned int>* indices, const vector<RHI_Vertex_PosUVTBN>& vertices, float threshold)
+	{
+		using namespace _MeshOptimizer;
+
+		auto triangleCount = (unsigned int)indices->size() / 3;
+		if (triangleCount == 0)
+			return;
+
+		const auto* triangles = indices->data();
+		FifoCache cache((unsigned int)vertices.size());
+
+		// Vertex cache order jumps to a new patch of the surface wherever a triangle misses all three vertices
+		vector<unsigned int> patches = { 0 };
+		cache.Touch(&triangles[0]);
+		for (unsigned int i = 1; i < triangleCount; i++)
+		{
+			if (cache.Touch(&triangles[i * 3]) == 3)
+			{
+				patches.emplace_back(i);
+			}
+		}
+		patches.emplace_back(triangleCount);
+
+		// Split the patches into clusters, a cluster ends as soon as drawing it on its own is about
+		// as cache efficient as drawing the whole patch, so drawing clusters in any order costs little
+		vector<unsigned int> clusters;
+		for (unsigned int patch = 0; patch + 1 < (unsigned int)patches.size(); patch++)
+		{
+			auto start	= patches[patch];
+			auto end	= patches[patch + 1];
+
+			cache.Flush();
+			unsigned int patchMisses = 0;
+			for (auto i = start; i < end; i++)
+			{
+				patchMisses += cache.Touch(&triangles[i * 3]);
+			}
+			float clusterThreshold = threshold * (float)patchMisses / (float)(end - start);
+
+			cache.Flush();
+			clusters.emplace_back(start);
+			unsigned int misses		= 0;
+			unsigned int count		= 0;
+			for (auto i = start; i < end; i++)
+			{
+				misses += cache.Touch(&triangles[i * 3]);
+				count++;
+
+				if (i + 1 < end && (float)misses <= clusterThreshold * (float)count)
+				{
+					clusters.emplace_back(i + 1);
+					misses	= 0;
+					count	= 0;
+					cache.Flush();
+				}
+			}
+		}
+		clusters.emplace_back(triangleCount);
+		auto clusterCount = (unsigned int)clusters.size() - 1;
+
+		// Area weighted centroid and normal of each cluster and of the whole mesh
+		auto position = [&vertices](unsigned int index) { return Vector3(vertices[index].pos[0], vertices[index].pos[1], vertices[index].pos[2]); };
+		vector<Vector3> clusterCentroids(clusterCount, Vector3::Zero);
+		vector<Vector3> clusterNormals(clusterCount, Vector3::Zero);
+		Vector3 meshCentroid	= Vector3::Zero;
+		float meshArea			= 0.0f;
+		for (unsigned int cluster = 0; cluster < clusterCount; cluster++)
+		{
+			float clusterArea = 0.0f;
+			for (auto i = clusters[cluster]; i < clusters[cluster + 1]; i++)
+			{
+				auto a		= position(triangles[i * 3 + 0]);
+				auto b		= position(triangles[i * 3 + 1]);
+				auto c		= position(triangles[i * 3 + 2]);
+				auto normal	= Vector3::Cross(b - a, c - a);
+				float area	= normal.Length();
+
+				clusterCentroids[cluster]	+= (a + b + c) * (area / 3.0f);
+				clusterNormals[cluster]		+= normal;
+				clusterArea					+= area;
+			}
+
+			meshCentroid		+= clusterCentroids[cluster];
+			meshArea			+= clusterArea;
+			clusterCentroids[cluster] = clusterArea > 0.0f ? clusterCentroids[cluster] / clusterArea : position(triangles[clusters[cluster] * 3]);
+		}
+		meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : Vector3::Zero;
+
+		// Clusters which face away from the center are on the outside, they go first so they occlude the rest
+		vector<float> sortKeys(clusterCount);
+		vector<unsigned int> order(clusterCount);
+		for (unsigned int cluster = 0; cluster < clusterCount; cluster++)
+		{
+			float length		= clusterNormals[cluster].Length();
+			sortKeys[cluster]	= length > 0.0f ? Vector3::Dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster] / length) : 0.0f;
+			order[cluster]		= cluster;
+		}
+		stable_sort(order.begin(), order.end(), [&sortKeys](unsigned int a, unsigned int b) { return sortKeys[a] > sortKeys[b]; });
+
+		vector<unsigned int> result;
+		result.reserve(indices->size());
+		for (auto cluster : order)
+		{
+			result.insert(result.end(), indices->begin() + clusters[cluster] * 3, indices->begin() + clusters[cluster + 1] * 3);
+		}
+		indices->swap(result);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(vector<unsigned int>* indices, vector<RHI_Vertex_PosUVTBN>* vertices)
+	{
+		using namespace _MeshOptimizer;
+
+		// Number the vertices in the order the index buffer first uses them
+		vector<unsigned int> remap(vertices->size(), invalid);
+		unsigned int next = 0;
+		for (auto& index : *indices)
+		{
+			if (remap[index] == invalid)
+			{
+				remap[index] = next++;
+			}
+			index = remap[index];
+		}
+
+		// Unused vertices go last, so the vertex count doesn't change
+		for (auto& index : remap)
+		{
+			if (index == invalid)
+			{
+				index = next++;
+			}
+		}
+
+		vector<RHI_Vertex_PosUVTBN> result(vertices->size());
+		for (unsigned int i = 0; i < (unsigned int)vertices->size(); i++)
+		{
+			result[remap[i]] = (*vertices)[i];
+		}
+		vertices->swap(result);
+	}
+
+	void MeshOptimizer::BuildClusters(const vector<unsigned int>& indices, const vector<RHI_Vertex_PosUVTBN>& vertices, vector<Mesh_Cluster>* clusters)
+	{
+		using namespace _MeshOptimizer;
+
+		if (!clusters || !Validate(indices, (unsigned int)vertices.size()))
+			return;
+
+		// Triangles are taken in index order, which the vertex cache optimization keeps coherent
+		auto triangleCount				= (unsigned int)indices.size() / 3;
+		vector<unsigned int> owners(vertices.size(), invalid);
+		unsigned int clusterIndex		= 0;
+		unsigned int clusterStart		= 0;
+		unsigned int clusterVertices	= 0;
+		for (unsigned int triangle = 0; triangle < triangleCount; triangle++)
+		{
+			const auto* corners = &indices[triangle * 3];
+
+			unsigned int newVertices = 0;
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				newVertices += owners[corners[corner]] != clusterIndex ? 1 : 0;
+			}
+
+			auto clusterTriangles	= triangle - clusterStart;
+			bool full				= clusterTriangles == clusterMaxTriangles || clusterVertices + newVertices > clusterMaxVertices;
+			bool disconnected		= clusterTriangles >= clusterMinTriangles && newVertices == 3;
+			if (clusterTriangles != 0 && (full || disconnected))
+			{
+				clusters->emplace_back(ComputeCluster(indices, vertices, clusterStart, triangle));
+				clusterIndex++;
+				clusterStart	= triangle;
+				clusterVertices	= 0;
+			}
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				if (owners[corners[corner]] != clusterIndex)
+				{
+					owners[corners[corner]] = clusterIndex;
+					clusterVertices++;
+				}
+			}
+		}
+
+		if (clusterStart < triangleCount)
+		{
+			clusters->emplace_back(ComputeCluster(indices, vertices, clusterStart, triangleCount));
+		}
+	}
+
+	float MeshOptimizer::Simplify(const vector<unsigned int>& indices, const vector<RHI_Vertex_PosUVTBN>& vertices, unsigned int targetIndexCount, float targetError, vector<unsigned int>* result)
+	{
+		using namespace _MeshOptimizer;
+
+		if (!result)
+			return 0.0f;
+
+		auto vertexCount = (unsigned int)vertices.size();
+		if (!Validate(indices, vertexCount))
+		{
+			LOG_WARNING("MeshOptimizer::Simplify: Expected an indexed triangle list");
+			*result = indices;
+			return 0.0f;
+		}
+
+		auto position	= [&vertices](unsigned int vertex) { const auto& v = vertices[vertex]; return Vector3(v.pos[0], v.pos[1], v.pos[2]); };
+		auto normal		= [&vertices](unsigned int vertex) { const auto& v = vertices[vertex]; return Vector3(v.normal[0], v.normal[1], v.normal[2]); };
+		auto remap		= ComputePositionRemap(vertices);
+
+		// Triangles with two corners at the same position have no area, they are dropped
+		result->clear();
+		result->reserve(indices.size());
+		for (unsigned int i = 0; i < (unsigned int)indices.size(); i += 3)
+		{
+			auto a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+			if (a != b && b != c && c != a)
+			{
+				result->insert(result->end(), indices.begin() + i, indices.begin() + i + 3);
+			}
+		}
+
+		// Edges which one triangle uses are open, edges which more than two triangles use aren't part of a manifold
+		unordered_map<unsigned long long, unsigned int> edgeTriangles;
+		for (unsigned int i = 0; i < (unsigned int)result->size(); i++)
+		{
+			auto next = i % 3 == 2 ? i - 2 : i + 1;
+			edgeTriangles[EdgeKey(remap[(*result)[i]], remap[(*result)[next]])]++;
+		}
+
+		// A vertex is locked when it has more than one set of attributes (a UV seam) or when the surface around it isn't a manifold
+		vector<unsigned int> wedges(vertexCount, invalid);
+		vector<unsigned int> borderEdges(vertexCount, 0);
+		vector<Simplify_Vertex> kinds(vertexCount, Simplify_Vertex_Manifold);
+		for (unsigned int i = 0; i < (unsigned int)result->size(); i++)
+		{
+			auto vertex	= (*result)[i];
+			auto a		= remap[vertex];
+			auto b		= remap[(*result)[i % 3 == 2 ? i - 2 : i + 1]];
+
+			if (wedges[a] == invalid)
+			{
+				wedges[a] = vertex;
+			}
+			else if (wedges[a] != vertex)
+			{
+				kinds[a] = Simplify_Vertex_Locked;
+			}
+
+			auto triangles = edgeTriangles[EdgeKey(a, b)];
+			if (triangles == 1)
+			{
+				borderEdges[a]++;
+				borderEdges[b]++;
+			}
+			else if (triangles > 2)
+			{
+				kinds[a] = Simplify_Vertex_Locked;
+				kinds[b] = Simplify_Vertex_Locked;
+			}
+		}
+		for (unsigned int vertex = 0; vertex < vertexCount; vertex++)
+		{
+			if (kinds[vertex] == Simplify_Vertex_Manifold && borderEdges[vertex] != 0)
+			{
+				kinds[vertex] = borderEdges[vertex] == 2 ? Simplify_Vertex_Border : Simplify_Vertex_Locked;
+			}
+		}
+
+		// The planes of the triangles around each vertex, open edges add a plane which is perpendicular to their triangle
+		vector<Quadric> quadrics(vertexCount);
+		for (unsigned int i = 0; i < (unsigned int)result->size(); i += 3)
+		{
+			const unsigned int corners[3] = { remap[(*result)[i]], remap[(*result)[i + 1]], remap[(*result)[i + 2]] };
+			Vector3 normal	= Vector3::Cross(position(corners[1]) - position(corners[0]), position(corners[2]) - position(corners[0]));
+			float length	= normal.Length();
+			if (length <= 0.0f)
+				continue;
+			normal = normal / length;
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				quadrics[corners[corner]].AddPlane(normal, -Vector3::Dot(normal, position(corners[0])), length * 0.5f);
+			}
+
+			for (unsigned int corner = 0; corner < 3; corner++)
+			{
+				auto a = corners[corner], b = corners[(corner + 1) % 3];
+				if (edgeTriangles[EdgeKey(a, b)] != 1)
+					continue;
+
+				Vector3 edge		= position(b) - position(a);
+				Vector3 edgeNormal	= Vector3::Cross(edge, normal).Normalized();
+				float edgeDistance	= -Vector3::Dot(edgeNormal, position(a));
+				quadrics[a].AddPlane(edgeNormal, edgeDistance, edge.LengthSquared() * lodBorderWeight);
+				quadrics[b].AddPlane(edgeNormal, edgeDistance, edge.LengthSquared() * lodBorderWeight);
+			}
+		}
+
+		struct Collapse
+		{
+			unsigned int from;
+			unsigned int to;
+			float error;
+		};
+
+		// Every pass collapses the cheapest edges whose surroundings no other collapse of the pass has changed
+		auto targetTriangles = targetIndexCount / 3;
+		float error = 0.0f;
+		vector<unsigned int> corners;
+		vector<Collapse> collapses;
+		vector<unsigned int> targets(vertexCount);
+		vector<bool> locked(vertexCount);
+		vector<unsigned int> ringFrom, ringTo;
+		while ((unsigned int)result->size() / 3 > targetTriangles)
+		{
+			corners.resize(result->size());
+			for (unsigned int i = 0; i < (unsigned int)result->size(); i++)
+			{
+				corners[i] = remap[(*result)[i]];
+			}
+			Adjacency adjacency(corners, vertexCount);
+
+			auto sharedTriangles = [&](unsigned int from, unsigned int to)
+			{
+				unsigned int shared = 0;
+				for (auto i = adjacency.offsets[from]; i < adjacency.offsets[from + 1]; i++)
+				{
+					const auto* triangle = &corners[adjacency.triangles[i] * 3];
+					shared += (triangle[0] == to || triangle[1] == to || triangle[2] == to) ? 1 : 0;
+				}
+				return shared;
+			};
+
+			auto canCollapse = [&](unsigned int from, unsigned int to)
+			{
+				return kinds[from] == Simplify_Vertex_Manifold || (kinds[from] == Simplify_Vertex_Border && sharedTriangles(from, to) == 1);
+			};
+
+			auto collapseError = [&](unsigned int from, unsigned int to)
+			{
+				Quadric quadric = quadrics[from];
+				quadric.Add(quadrics[to]);
+				return quadric.GetError(position(to));
+			};
+
+			// The cheaper direction of every edge which can collapse
+			collapses.clear();
+			for (unsigned int i = 0; i < (unsigned int)corners.size(); i++)
+			{
+				auto a			= corners[i];
+				auto b			= corners[i % 3 == 2 ? i - 2 : i + 1];
+				bool collapseA	= canCollapse(a, b);
+				bool collapseB	= canCollapse(b, a);
+				float errorA	= collapseA ? collapseError(a, b) : 0.0f;
+				float errorB	= collapseB ? collapseError(b, a) : 0.0f;
+				if (collapseA && (!collapseB || errorA <= errorB))
+				{
+					collapses.push_back({ a, b, errorA });
+				}
+				else if (collapseB)
+				{
+					collapses.push_back({ b, a, errorB });
+				}
+			}
+			stable_sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+			auto removable			= (unsigned int)result->size() / 3 - targetTriangles;
+			unsigned int removed	= 0;
+			fill(targets.begin(), targets.end(), invalid);
+			fill(locked.begin(), locked.end(), false);
+			for (const auto& collapse : collapses)
+			{
+				if (collapse.error > targetError || removed >= removable)
+					break;
+
+				auto from	= collapse.from;
+				auto to		= collapse.to;
+				if (locked[from] || locked[to])
+					continue;
+
+				// The triangles which only 'from' is on move with it, none of them may flip or turn away from the normals of their vertices
+				unsigned int shared	= 0;
+				unsigned int wedge	= invalid;
+				bool flips			= false;
+				ringFrom.clear();
+				for (auto i = adjacency.offsets[from]; i < adjacency.offsets[from + 1]; i++)
+				{
+					auto triangle				= adjacency.triangles[i] * 3;
+					const auto* triangleCorners	= &corners[triangle];
+					ringFrom.insert(ringFrom.end(), triangleCorners, triangleCorners + 3);
+
+					Vector3 before[3], after[3];
+					bool collapsing = false;
+					for (unsigned int corner = 0; corner < 3; corner++)
+					{
+						before[corner]	= position(triangleCorners[corner]);
+						after[corner]	= triangleCorners[corner] == from ? position(to) : before[corner];
+						if (triangleCorners[corner] == to)
+						{
+							collapsing	= true;
+							wedge		= (*result)[triangle + corner];
+						}
+					}
+
+					if (collapsing)
+					{
+						shared++;
+						continue;
+					}
+
+					Vector3 normalBefore	= Vector3::Cross(before[1] - before[0], before[2] - before[0]);
+					Vector3 normalAfter		= Vector3::Cross(after[1] - after[0], after[2] - after[0]);
+					flips = flips || Vector3::Dot(normalBefore, normalAfter) <= 0.0f;
+					for (unsigned int corner = 0; corner < 3; corner++)
+					{
+						Vector3 vertexNormal = normal(triangleCorners[corner] == from ? to : triangleCorners[corner]);
+						flips = flips || (vertexNormal != Vector3::Zero && Vector3::Dot(normalAfter, vertexNormal) <= lodMinNormalDot * normalAfter.Length() * vertexNormal.Length());
+					}
+				}
+				if (flips || wedge == invalid)
+					continue;
+
+				// The only neighbours 'from' and 'to' may share are those of the triangles which collapse, or the surface would fold onto itself
+				ringTo.clear();
+				for (auto i = adjacency.offsets[to]; i < adjacency.offsets[to + 1]; i++)
+				{
+					const auto* triangleCorners = &corners[adjacency.triangles[i] * 3];
+					ringTo.insert(ringTo.end(), triangleCorners, triangleCorners + 3);
+				}
+				sort(ringFrom.begin(), ringFrom.end());
+				ringFrom.erase(unique(ringFrom.begin(), ringFrom.end()), ringFrom.end());
+				sort(ringTo.begin(), ringTo.end());
+				ringTo.erase(unique(ringTo.begin(), ringTo.end()), ringTo.end());
+				unsigned int common = 0;
+				for (auto vertex : ringFrom)
+				{
+					common += (vertex != from && vertex != to && binary_search(ringTo.begin(), ringTo.end(), vertex)) ? 1 : 0;
+				}
+				if (common != shared)
+					continue;
+
+				targets[from] = wedge;
+				quadrics[to].Add(quadrics[from]);
+				error	= max(error, collapse.error);
+				removed	+= shared;
+
+				// The triangles around 'from' change, they are left alone for the rest of the pass
+				for (auto vertex : ringFrom)
+				{
+					locked[vertex] = true;
+				}
+			}
+
+			if (removed == 0)
+				break;
+
+			// Move the corners of the collapsed vertices and drop the triangles which have lost their area
+			unsigned int count = 0;
+			for (unsigned int i = 0; i < (unsigned int)result->size(); i += 3)
+			{
+				unsigned int triangle[3];
+				for (unsigned int corner = 0; corner < 3; corner++)
+				{
+					auto vertex		= (*result)[i + corner];
+					auto target		= targets[remap[vertex]];
+					triangle[corner] = target != invalid ? target : vertex;
+				}
+
+				auto a = remap[triangle[0]], b = remap[triangle[1]], c = remap[triangle[2]];
+				if (a == b || b == c || c == a)
+					continue;
+
+				(*result)[count++] = triangle[0];
+				(*result)[count++] = triangle[1];
+				(*result)[count++] = triangle[2];
+			}
+			result->resize(count);
+		}
+
+		return error;
+	}
+
+	void MeshOptimizer::BuildLods(const vector<unsigned int>& indices, const vector<RHI_Vertex_PosUVTBN>& vertices, vector<Mesh_Lod>* lods, vector<unsigned int>* lodIndices)
+	{
+		using namespace _MeshOptimizer;
+
+		auto vertexCount = (unsigned int)vertices.size();
+		if (!lods || !lodIndices || !Validate(indices, vertexCount))
+			return;
+
+		// Every level is simplified from the submesh itself, so the errors don't add up
+		float maxError			= BoundingBox(vertices).GetExtents().Length() * lodMaxError;
+		auto previousCount		= (unsigned int)indices.size();
+		float previousError		= 0.0f;
+		vector<unsigned int> levelIndices;
+		for (unsigned int level = 1; level <= lodMaxLevels; level++)
+		{
+			auto targetCount = (previousCount / 6) * 3;
+			if (targetCount < lodMinTriangles * 3)
+				break;
+
+			float error = Simplify(indices, vertices, targetCount, maxError, &levelIndices);
+			if (levelIndices.empty() || (float)levelIndices.size() > (float)previousCount * lodMaxRatio)
+				break;
+			OptimizeVertexCache(&levelIndices, vertexCount);
+
+			Mesh_Lod lod;
+			lod.indexOffset	= (unsigned int)lodIndices->size();
+			lod.indexCount	= (unsigned int)levelIndices.size();
+			lod.error		= max(error, previousError);
+			lods->emplace_back(lod);
+			lodIndices->insert(lodIndices->end(), levelIndices.begin(), levelIndices.end());
+
+			previousCount	= lod.indexCount;
+			previousError	= lod.error;
+		}
+	}
+
+	MeshOptimizer_Statistics MeshOptimizer::Analyze(const vector<unsigned int>& indices, unsigned int vertexCount)
+	{
+		MeshOptimizer_Statistics statistics;
+		if (!_MeshOptimizer::Validate(indices, vertexCount))
+			return statistics;
+
+		_MeshOptimizer::FifoCache cache(vertexCount);
+		vector<bool> used(vertexCount, false);
+		for (auto index : indices)
+		{
+			statistics.transforms += cache.Touch(index);
+			if (!used[index])
+			{
+				used[index] = true;
+				statistics.vertices++;
+			}
+		}
+		statistics.triangles = (unsigned int)indices.size() / 3;
+
+		return statistics;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include "../../Core/EngineDefs.h"
+#include "../../RHI/RHI_Definition.h"
+#include "../../Math/Vector3.h"
+//================================
+
+namespace Directus
+{
+	// How well an index buffer uses the post-transform cache (simulated as a 16 entry FIFO)
+	struct MeshOptimizer_Statistics
+	{
+		void Add(const MeshOptimizer_Statistics& other)
+		{
+			triangles	+= other.triangles;
+			vertices	+= other.vertices;
+			transforms	+= other.transforms;
+		}
+
+		// Average cache miss ratio, vertex shader invocations per triangle (0.5 is the best a regular grid can do)
+		float GetACMR() const { return triangles ? (float)transforms / (float)triangles : 0.0f; }
+		// Average transform to vertex ratio, vertex shader invocations per vertex (1.0 is optimal)
+		float GetATVR() const { return vertices ? (float)transforms / (float)vertices : 0.0f; }
+
+		unsigned int triangles	= 0;
+		unsigned int vertices	= 0;
+		unsigned int transforms	= 0;
+	};
+
+	// A run of up to 128 triangles which is culled as a whole
+	struct Mesh_Cluster
+	{
+		unsigned int indexOffset	= 0;
+		unsigned int indexCount		= 0;
+		// Bounding sphere
+		Math::Vector3 center		= Math::Vector3::Zero;
+		float radius				= 0.0f;
+		// Normal cone, every triangle faces away from an eye where dot(center - eye, coneAxis) >= coneCutoff * |center - eye| + radius
+		Math::Vector3 coneAxis		= Math::Vector3::Zero;
+		float coneCutoff			= 1.0f;
+	};
+
+	// A simplified version of a submesh, it's drawn with the vertices of the submesh
+	struct Mesh_Lod
+	{
+		// Index offset of the submesh
+		unsigned int sourceIndexOffset	= 0;
+		unsigned int indexOffset		= 0;
+		unsigned int indexCount			= 0;
+		// How far the surface moved from the submesh's surface, in the units of the vertices
+		float error						= 0.0f;
+	};
+
+	// Reorders the triangles of an indexed triangle list for the post-transform cache (Tipsify), then reorders
+	// clusters of those triangles so that the ones facing away from the center of the mesh are drawn first (less
+	// overdraw), and finally reorders the vertices in the order they are first used (vertex fetch locality).
+	class ENGINE_CLASS MeshOptimizer
+	{
+	public:
+		// All three passes, statistics are optional. Indices are relative to the vertices, unused vertices are moved to the end.
+		static bool Optimize(
+			std::vector<unsigned int>* indices,
+			std::vector<RHI_Vertex_PosUVTBN>* vertices,
+			MeshOptimizer_Statistics* before	= nullptr,
+			MeshOptimizer_Statistics* after		= nullptr
+		);
+
+		static void OptimizeVertexCache(std::vector<unsigned int>* indices, unsigned int vertexCount);
+		// Expects indices which are already in vertex cache order, threshold is how much worse than that order a cluster may get
+		static void OptimizeOverdraw(std::vector<unsigned int>* indices, const std::vector<RHI_Vertex_PosUVTBN>& vertices, float threshold = 1.05f);
+		static void OptimizeVertexFetch(std::vector<unsigned int>* indices, std::vector<RHI_Vertex_PosUVTBN>* vertices);
+		static MeshOptimizer_Statistics Analyze(const std::vector<unsigned int>& indices, unsigned int vertexCount);
+
+		// Splits optimized indices into runs of neighbouring triangles, index offsets are relative to the indices
+		static void BuildClusters(const std::vector<unsigned int>& indices, const std::vector<RHI_Vertex_PosUVTBN>& vertices, std::vector<Mesh_Cluster>* clusters);
+
+		// Collapses edges, in the order of the least quadric error, until there are no more than targetIndexCount indices or the next
+		// collapse would move the surface by more than targetError. The vertices are left untouched. Returns the error of the result.
+		static float Simplify(
+			const std::vector<unsigned int>& indices,
+			const std::vector<RHI_Vertex_PosUVTBN>& vertices,
+			unsigned int targetIndexCount,
+			float targetError,
+			std::vector<unsigned int>* result
+		);
+
+		// Simplifies optimized indices into levels with half the triangles of the previous level, the indices of every level are
+		// appended to lodIndices (in vertex cache order) and the index offsets are relative to it
+		static void BuildLods(const std::vector<unsigned int>& indices, const std::vector<RHI_Vertex_PosUVTBN>& vertices, std::vector<Mesh_Lod>* lods, std::vector<unsigned int>* lodIndices);
+
+		// Changes whenever the output would be different
+		static unsigned int GetVersion() { return 3; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,468 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+//= INCLUDES =====================
+#include "MipGenerator.h"
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <emmintrin.h>
+#include "../../Threading/Threading.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	namespace _MipGenerator
+	{
+		// Rows of a level per task
+		static const unsigned int tileRows			= 32;
+		// Levels with fewer texels are filtered on the calling thread
+		static const unsigned int parallelTexels	= 128 * 128;
+		// Entries of the table which encodes linear values as sRGB, enough for every 8-bit output to be exact
+		static const unsigned int srgbEncodeSize	= 16384;
+		// Iterations of the search for the alpha scale which preserves coverage
+		static const unsigned int coverageSteps		= 10;
+
+		struct Tables
+		{
+			Tables()
+			{
+				for (unsigned int i = 0; i < 256; i++)
+				{
+					float c			= i / 255.0f;
+					unorm8[i]		= c;
+					srgbDecode[i]	= c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+				}
+
+				for (unsigned int i = 0; i < srgbEncodeSize; i++)
+				{
+					float l			= i / float(srgbEncodeSize - 1);
+					float c			= l <= 0.0031308f ? l * 12.92f : 1.055f * pow(l, 1.0f / 2.4f) - 0.055f;
+					srgbEncode[i]	= (unsigned char)(c * 255.0f + 0.5f);
+				}
+			}
+
+			float unorm8[256];
+			float srgbDecode[256];
+			unsigned char srgbEncode[srgbEncodeSize];
+		};
+
+		inline const Tables& GetTables()
+		{
+			static Tables tables;
+			return tables;
+		}
+
+		// The source texels which contribute to a destination texel
+		struct Taps
+		{
+			unsigned int first	= 0;
+			unsigned int count	= 0;
+			float weights[3]	= { 0.0f, 0.0f, 0.0f };
+		};
+
+		inline vector<Taps> ComputeTaps(unsigned int sourceSize, unsigned int size)
+		{
+			vector<Taps> taps(size);
+			for (unsigned int i = 0; i < size; i++)
+			{
+				auto& tap = taps[i];
+				if (sourceSize == 1)
+				{
+					tap.count		= 1;
+					tap.weights[0]	= 1.0f;
+				}
+				else if (sourceSize % 2 == 0)
+				{
+					tap.first		= i * 2;
+					tap.count		= 2;
+					tap.weights[0]	= 0.5f;
+					tap.weights[1]	= 0.5f;
+				}
+				else
+				{
+					// Odd sizes (2n + 1 to n), every source texel contributes equally to the level
+					float n			= float(size * 2 + 1);
+					tap.first		= i * 2;
+					tap.count		= 3;
+					tap.weights[0]	= (size - i) / n;
+					tap.weights[1]	= size / n;
+					tap.weights[2]	= (i + 1) / n;
+				}
+			}
+
+			return taps;
+		}
+
+		inline void FilterRow(const float* source, const vector<Taps>& taps, unsigned int channels, float* dest)
+		{
+			// A texel per register
+			if (channels == 4)
+			{
+				for (size_t x = 0; x < taps.size(); x++)
+				{
+					const auto& tap	= taps[x];
+					const float* s	= source + tap.first * 4;
+					__m128 sum		= _mm_mul_ps(_mm_loadu_ps(s), _mm_set1_ps(tap.weights[0]));
+					for (unsigned int i = 1; i < tap.count; i++)
+					{
+						sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(s + i * 4), _mm_set1_ps(tap.weights[i])));
+					}
+					_mm_storeu_ps(dest + x * 4, sum);
+				}
+				return;
+			}
+
+			for (size_t x = 0; x < taps.size(); x++)
+			{
+				const auto& tap	= taps[x];
+				const float* s	= source + tap.first * channels;
+				for (unsigned int c = 0; c < channels; c++)
+				{
+					float sum = 0.0f;
+					for (unsigned int i = 0; i < tap.count; i++)
+					{
+						sum += s[i * channels + c] * tap.weights[i];
+					}
+					dest[x * channels + c] = sum;
+				}
+			}
+		}
+
+		// dest = source * weight, or dest += source * weight
+		inline void Accumulate(const float* source, float weight, unsigned int count, bool add, float* dest)
+		{
+			__m128 w		= _mm_set1_ps(weight);
+			unsigned int i	= 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 v = _mm_mul_ps(_mm_loadu_ps(source + i), w);
+				_mm_storeu_ps(dest + i, add ? _mm_add_ps(_mm_loadu_ps(dest + i), v) : v);
+			}
+			for (; i < count; i++)
+			{
+				dest[i] = add ? dest[i] + source[i] * weight : source[i] * weight;
+			}
+		}
+
+		inline __m128 Saturate(__m128 v)
+		{
+			return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+		}
+
+		inline float Saturate(float v)
+		{
+			return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+		}
+
+		// Rounds half up, the same as the scalar (v * scale + 0.5f) casts, so every texel of a row rounds alike
+		inline __m128i Quantize(__m128 v, __m128 scale)
+		{
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(Saturate(v), scale), _mm_set1_ps(0.5f)));
+		}
+
+		inline float ComputeCoverage(const float* texels, size_t count, float alphaReference, float alphaScale)
+		{
+			size_t covered = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				covered += texels[i * 4 + 3] * alphaScale > alphaReference ? 1 : 0;
+			}
+
+			return count != 0 ? covered / float(count) : 0.0f;
+		}
+
+		// Binary search for the alpha scale which gives a level the coverage of level 0 (or the closest to it)
+		inline float ComputeAlphaScale(const float* texels, size_t count, float alphaReference, float coverage)
+		{
+			float low		= 0.0f;
+			float high		= 4.0f;
+			float best		= 1.0f;
+			float bestError	= fabs(ComputeCoverage(texels, count, alphaReference, best) - coverage);
+			for (unsigned int i = 0; i < coverageSteps && bestError > 0.0f; i++)
+			{
+				float scale			= (low + high) * 0.5f;
+				float levelCoverage	= ComputeCoverage(texels, count, alphaReference, scale);
+				float error			= fabs(levelCoverage - coverage);
+				if (error < bestError)
+				{
+					best		= scale;
+					bestError	= error;
+				}
+
+				if (levelCoverage < coverage)
+				{
+					low = scale;
+				}
+				else
+				{
+					high = scale;
+				}
+			}
+
+			return best;
+		}
+	}
+
+	MipGenerator::MipGenerator(Threading* threading)
+	{
+		m_threading = threading;
+	}
+
+	bool MipGenerator::Generate(vector<vector<byte>>* mips, unsigned int width, unsigned int height, unsigned int channels, Mip_Channel type)
+	{
+		unsigned int bytesPerChannel = type == Mip_UInt8 ? 1 : (type == Mip_UInt16 ? 2 : 4);
+		if (!mips || mips->empty() || width == 0 || height == 0 || channels == 0 || channels > 4 || mips->front().size() < (size_t)width * height * channels * bytesPerChannel)
+		{
+			LOG_ERROR("MipGenerator::Generate: Invalid parameters");
+			return false;
+		}
+
+		// Level 0 is decoded as it's read, every following level is filtered from the float version of the previous one
+		vector<float> previous;
+		auto sourceRow = [this, mips, &previous, &width, channels, type, bytesPerChannel](unsigned int y, float* scratch) -> const float*
+		{
+			if (!previous.empty())
+				return previous.data() + (size_t)y * width * channels;
+
+			DecodeRow(mips->front().data() + (size_t)y * width * channels * bytesPerChannel, width, channels, type, scratch);
+			return scratch;
+		};
+
+		// Coverage of level 0
+		bool preserveCoverage	= m_alphaReference > 0.0f && channels == 4;
+		float coverage			= 0.0f;
+		if (preserveCoverage)
+		{
+			vector<float> row((size_t)width * channels);
+			for (unsigned int y = 0; y < height; y++)
+			{
+				coverage += _MipGenerator::ComputeCoverage(sourceRow(y, row.data()), width, m_alphaReference, 1.0f);
+			}
+			coverage /= height;
+		}
+
+		while (width > 1 || height > 1)
+		{
+			unsigned int levelWidth		= max(width / 2, 1u);
+			unsigned int levelHeight	= max(height / 2, 1u);
+			size_t rowSize				= (size_t)levelWidth * channels;
+
+			vector<float> level(rowSize * levelHeight);
+			Filter(sourceRow, width, height, levelWidth, levelHeight, channels, level.data());
+
+			// Alpha is scaled on output only, so the next level is filtered from the actual texels
+			float alphaScale = preserveCoverage ? _MipGenerator::ComputeAlphaScale(level.data(), (size_t)levelWidth * levelHeight, m_alphaReference, coverage) : 1.0f;
+
+			auto& mip = mips->emplace_back(rowSize * levelHeight * bytesPerChannel);
+			ParallelRows(levelHeight, levelWidth, [this, &level, &mip, rowSize, levelWidth, channels, type, alphaScale, bytesPerChannel](unsigned int yStart, unsigned int yEnd)
+			{
+				vector<float> scratch(rowSize);
+				for (unsigned int y = yStart; y < yEnd; y++)
+				{
+					EncodeRow(level.data() + y * rowSize, levelWidth, channels, type, alphaScale, mip.data() + y * rowSize * bytesPerChannel, scratch.data());
+				}
+			});
+
+			previous	= move(level);
+			width		= levelWidth;
+			height		= levelHeight;
+		}
+
+		return true;
+	}
+
+	void MipGenerator::Filter(const function<const float*(unsigned int, float*)>& sourceRow, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int width, unsigned int height, unsigned int channels, float* dest)
+	{
+		auto tapsX = _MipGenerator::ComputeTaps(sourceWidth, width);
+		auto tapsY = _MipGenerator::ComputeTaps(sourceHeight, height);
+
+		// Separable, each source row is filtered horizontally and then weighted into the destination row
+		ParallelRows(height, width, [&](unsigned int yStart, unsigned int yEnd)
+		{
+			vector<float> scratch((size_t)sourceWidth * channels);
+			vector<float> filtered((size_t)width * channels);
+			unsigned int count = width * channels;
+
+			for (unsigned int y = yStart; y < yEnd; y++)
+			{
+				const auto& tap = tapsY[y];
+				for (unsigned int i = 0; i < tap.count; i++)
+				{
+					_MipGenerator::FilterRow(sourceRow(tap.first + i, scratch.data()), tapsX, channels, filtered.data());
+					_MipGenerator::Accumulate(filtered.data(), tap.weights[i], count, i != 0, dest + (size_t)y * count);
+				}
+			}
+		});
+	}
+
+	void MipGenerator::DecodeRow(const byte* source, unsigned int texels, unsigned int channels, Mip_Channel type, float* dest)
+	{
+		const auto& tables	= _MipGenerator::GetTables();
+		unsigned int count	= texels * channels;
+		unsigned int i		= 0;
+		__m128i zero		= _mm_setzero_si128();
+
+		if (type == Mip_UInt8)
+		{
+			auto bytes = reinterpret_cast<const unsigned char*>(source);
+			if (m_sRGB)
+			{
+				for (; i < count; i++)
+				{
+					bool alpha	= channels == 4 && (i & 3) == 3;
+					dest[i]		= alpha ? tables.unorm8[bytes[i]] : tables.srgbDecode[bytes[i]];
+				}
+				return;
+			}
+
+			__m128 scale = _mm_set1_ps(1.0f / 255.0f);
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i v	= _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+				__m128i lo	= _mm_unpacklo_epi8(v, zero);
+				__m128i hi	= _mm_unpackhi_epi8(v, zero);
+				_mm_storeu_ps(dest + i,			_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dest + i + 4,		_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dest + i + 8,		_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+				_mm_storeu_ps(dest + i + 12,	_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+			}
+			for (; i < count; i++)
+			{
+				dest[i] = tables.unorm8[bytes[i]];
+			}
+		}
+		else if (type == Mip_UInt16)
+		{
+			auto words		= reinterpret_cast<const unsigned short*>(source);
+			__m128 scale	= _mm_set1_ps(1.0f / 65535.0f);
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+				_mm_storeu_ps(dest + i,		_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+				_mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+			}
+			for (; i < count; i++)
+			{
+				dest[i] = words[i] / 65535.0f;
+			}
+		}
+		else
+		{
+			memcpy(dest, source, count * sizeof(float));
+		}
+	}
+
+	void MipGenerator::EncodeRow(const float* source, unsigned int texels, unsigned int channels, Mip_Channel type, float alphaScale, byte* dest, float* scratch)
+	{
+		const auto& tables	= _MipGenerator::GetTables();
+		unsigned int count	= texels * channels;
+		unsigned int i		= 0;
+
+		if (alphaScale != 1.0f && channels == 4)
+		{
+			memcpy(scratch, source, count * sizeof(float));
+			for (unsigned int a = 3; a < count; a += 4)
+			{
+				scratch[a] *= alphaScale;
+			}
+			source = scratch;
+		}
+
+		if (type == Mip_UInt8)
+		{
+			auto bytes = reinterpret_cast<unsigned char*>(dest);
+			if (m_sRGB)
+			{
+				for (; i < count; i++)
+				{
+					float v		= _MipGenerator::Saturate(source[i]);
+					bool alpha	= channels == 4 && (i & 3) == 3;
+					bytes[i]	= alpha ? (unsigned char)(v * 255.0f + 0.5f) : tables.srgbEncode[(unsigned int)(v * (_MipGenerator::srgbEncodeSize - 1) + 0.5f)];
+				}
+				return;
+			}
+
+			__m128 scale = _mm_set1_ps(255.0f);
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i a = _MipGenerator::Quantize(_mm_loadu_ps(source + i), scale);
+				__m128i b = _MipGenerator::Quantize(_mm_loadu_ps(source + i + 4), scale);
+				__m128i c = _MipGenerator::Quantize(_mm_loadu_ps(source + i + 8), scale);
+				__m128i d = _MipGenerator::Quantize(_mm_loadu_ps(source + i + 12), scale);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+			}
+			for (; i < count; i++)
+			{
+				bytes[i] = (unsigned char)(_MipGenerator::Saturate(source[i]) * 255.0f + 0.5f);
+			}
+		}
+		else if (type == Mip_UInt16)
+		{
+			// SSE2 can only pack to signed words, so the values are biased into that range and back
+			auto words		= reinterpret_cast<unsigned short*>(dest);
+			__m128 scale	= _mm_set1_ps(65535.0f);
+			__m128i bias32	= _mm_set1_epi32(32768);
+			__m128i bias16	= _mm_set1_epi16(-32768);
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i a = _mm_sub_epi32(_MipGenerator::Quantize(_mm_loadu_ps(source + i), scale), bias32);
+				__m128i b = _mm_sub_epi32(_MipGenerator::Quantize(_mm_loadu_ps(source + i + 4), scale), bias32);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+			}
+			for (; i < count; i++)
+			{
+				words[i] = (unsigned short)(_MipGenerator::Saturate(source[i]) * 65535.0f + 0.5f);
+			}
+		}
+		else
+		{
+			memcpy(dest, source, count * sizeof(float));
+		}
+	}
+
+	void MipGenerator::ParallelRows(unsigned int rows, unsigned int texelsPerRow, const function<void(unsigned int, unsigned int)>& work)
+	{
+		if (!m_threading || (size_t)rows * texelsPerRow < _MipGenerator::parallelTexels)
+		{
+			work(0, rows);
+			return;
+		}
+
+		// The tasks only reference the work while this function waits for them
+		TaskGroup group;
+		for (unsigned int y = 0; y < rows; y += _MipGenerator::tileRows)
+		{
+			unsigned int yEnd = min(y + _MipGenerator::tileRows, rows);
+			m_threading->AddTask([&work, y, yEnd]() { work(y, yEnd); }, &group);
+		}
+
+		m_threading->Wait(&group);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include "../../Core/EngineDefs.h"
+//================================
+
+namespace Directus
+{
+	class Threading;
+
+	enum Mip_Channel
+	{
+		Mip_UInt8,
+		Mip_UInt16,
+		Mip_Float
+	};
+
+	// Generates a mip chain where every level is filtered from the previous one (a 2x2 box filter, or a 3-tap
+	// polyphase filter for odd dimensions so nothing shifts). Texels are filtered as floats with SSE2 kernels
+	// and the rows of each level are split into tiles which are processed by the worker threads.
+	class ENGINE_CLASS MipGenerator
+	{
+	public:
+		MipGenerator(Threading* threading);
+		~MipGenerator() {}
+
+		// Filter 8-bit color in linear space, for textures which hold sRGB color (alpha is always linear)
+		void SetSRGB(bool sRGB)							{ m_sRGB = sRGB; }
+		// Keep the fraction of texels whose alpha passes this alpha test reference the same at every level, 0 disables it
+		void SetAlphaReference(float alphaReference)	{ m_alphaReference = alphaReference; }
+
+		// Appends levels to a chain that holds level 0, down to 1x1
+		bool Generate(std::vector<std::vector<std::byte>>* mips, unsigned int width, unsigned int height, unsigned int channels, Mip_Channel type);
+
+		// Changes whenever the output would be different
+		static unsigned int GetVersion() { return 2; }
+
+	private:
+		void Filter(const std::function<const float*(unsigned int, float*)>& sourceRow, unsigned int sourceWidth, unsigned int sourceHeight, unsigned int width, unsigned int height, unsigned int channels, float* dest);
+		void DecodeRow(const std::byte* source, unsigned int texels, unsigned int channels, Mip_Channel type, float* dest);
+		void EncodeRow(const float* source, unsigned int texels, unsigned int channels, Mip_Channel type, float alphaScale, std::byte* dest, float* scratch);
+		void ParallelRows(unsigned int rows, unsigned int texelsPerRow, const std::function<void(unsigned int, unsigned int)>& work);
+
+		Threading* m_threading;
+		bool m_sRGB				= false;
+		float m_alphaReference	= 0.0f;
+	};
+}
\ No newline at end of file
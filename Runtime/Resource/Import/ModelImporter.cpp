@@ -25,8 +25,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <assimp/postprocess.h>
 #include <assimp/version.h>
 #include <assimp/ProgressHandler.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/DefaultIOSystem.h>
+#include <cstring>
+#include <algorithm>
 #include "AssimpHelper.h"
+#include "MeshOptimizer.h"
 #include "../../Core/Settings.h"
+#include "../../Core/Hash.h"
 #include "../../Rendering/Model.h"
 #include "../../Rendering/Animation.h"
 #include "../../Rendering/Material.h"
@@ -83,6 +89,88 @@ private:
 	string m_fileName;
 };
 
+// Implement Assimp::IOSystem so the importer can read files from mounted archives
+class _ArchiveIOStream : public IOStream
+{
+public:
+	_ArchiveIOStream(const std::byte* data, size_t size)
+	{
+		m_data		= data;
+		m_size		= size;
+		m_position	= 0;
+	}
+
+	size_t Read(void* buffer, size_t size, size_t count) override
+	{
+		if (size == 0)
+			return 0;
+
+		count = min(count, (m_size - m_position) / size);
+		memcpy(buffer, m_data + m_position, size * count);
+		m_position += size * count;
+		return count;
+	}
+
+	size_t Write(const void* buffer, size_t size, size_t count) override { return 0; }
+
+	aiReturn Seek(size_t offset, aiOrigin origin) override
+	{
+		size_t position =	origin == aiOrigin_SET ? offset :
+							origin == aiOrigin_CUR ? m_position + offset :
+							m_size - offset;
+
+		if (position > m_size)
+			return aiReturn_FAILURE;
+
+		m_position = position;
+		return aiReturn_SUCCESS;
+	}
+
+	size_t Tell() const override		{ return m_position; }
+	size_t FileSize() const override	{ return m_size; }
+	void Flush() override				{}
+
+private:
+	const std::byte* m_data;
+	size_t m_size;
+	size_t m_position;
+};
+
+class _ArchiveIOSystem : public DefaultIOSystem
+{
+public:
+	_ArchiveIOSystem(std::vector<std::string>* openedFilePaths) { m_openedFilePaths = openedFilePaths; }
+
+	bool Exists(const char* filePath) const override
+	{
+		return Directus::FileSystem::IsMounted(filePath) || DefaultIOSystem::Exists(filePath);
+	}
+
+	IOStream* Open(const char* filePath, const char* mode) override
+	{
+		// Sidecar files (.mtl, .bin etc.) affect the imported data just like the model itself
+		if (strchr(mode, 'w') == nullptr && std::find(m_openedFilePaths->begin(), m_openedFilePaths->end(), filePath) == m_openedFilePaths->end())
+		{
+			m_openedFilePaths->emplace_back(filePath);
+		}
+
+		const std::byte* data	= nullptr;
+		size_t size				= 0;
+		if (strchr(mode, 'w') == nullptr && Directus::FileSystem::GetMountedFile(filePath, &data, &size))
+			return new _ArchiveIOStream(data, size);
+
+		return DefaultIOSystem::Open(filePath, mode);
+	}
+
+	void Close(IOStream* file) override
+	{
+		delete file;
+	}
+
+private:
+	std::vector<std::string>* m_openedFilePaths;
+};
+
 namespace Directus
 {
 	namespace _ModelImporter
@@ -92,7 +180,6 @@ namespace Directus
 			aiProcess_CalcTangentSpace |
 			aiProcess_GenSmoothNormals |
 			aiProcess_JoinIdenticalVertices |
-			aiProcess_ImproveCacheLocality |
 			aiProcess_LimitBoneWeights |
 			aiProcess_SplitLargeMeshes |
 			aiProcess_Triangulate |
@@ -129,6 +216,7 @@ namespace Directus
 		}
 
 		m_modelPath = filePath;
+		m_openedFilePaths.clear();
 
 		// Set up an Assimp importer
 		Importer importer;
@@ -137,6 +225,7 @@ namespace Directus
 		importer.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, aiComponent_CAMERAS | aiComponent_LIGHTS);		// Remove cameras and lights
 		importer.SetPropertyFloat(AI_CONFIG_PP_CT_MAX_SMOOTHING_ANGLE, _ModelImporter::normalSmoothAngle);	// Normal smoothing angle
 		importer.SetProgressHandler(new _ProgressHandler(filePath));										// Progress tracking
+		importer.SetIOHandler(new _ArchiveIOSystem(&m_openedFilePaths));											// Mounted archive support, records opened files
 
 		// Read the 3D model file from disk
 		if (const aiScene* scene = importer.ReadFile(m_modelPath, _ModelImporter::flags))
@@ -145,6 +234,10 @@ namespace Directus
 
 			ReadNodeHierarchy(scene, scene->mRootNode, model);
 			ReadAnimations(scene, model);
+
+			// The materials only recorded their textures, import all of them at once
+			ProgressReport::Get().SetStatus(g_progress_ModelImporter, "Importing textures...");
+			model->ImportTextures();
 			model->Geometry_Update();
 
 			FIRE_EVENT(EVENT_WORLD_START);
@@ -160,6 +253,16 @@ namespace Directus
 		return true;
 	}
 
+	unsigned long long ModelImporter::GetSettingsHash()
+	{
+		unsigned long long hash = Hash::Compute(Settings::Get().m_versionAssimp);
+		hash = Hash::Combine(hash, Hash::ComputeValue(_ModelImporter::flags));
+		hash = Hash::Combine(hash, Hash::ComputeValue(_ModelImporter::normalSmoothAngle));
+		hash = Hash::Combine(hash, Hash::ComputeValue(MeshOptimizer::GetVersion()));
+
+		return hash;
+	}
+
 	void ModelImporter::ReadNodeHierarchy(const aiScene* assimpScene, aiNode* assimpNode, shared_ptr<Model>& model, Actor* parentNode, Actor* newNode)
 	{
 		auto scene = m_context->GetSubsystem<World>();
@@ -50,6 +50,10 @@ namespace Directus
 		~ModelImporter() {}
 
 		bool Load(std::shared_ptr<Model> model, const std::string& filePath);
+		// Hash of anything that affects the imported data, other than the source file
+		unsigned long long GetSettingsHash();
+		// Every file the last Load() read, the model itself included
+		const std::vector<std::string>& GetOpenedFilePaths() { return m_openedFilePaths; }
 
 	private:
 		// PROCESSING
@@ -66,6 +70,7 @@ namespace Directus
 		void ComputeNodeCount(aiNode* node, int* count);
 	
 		std::string m_modelPath;
+		std::vector<std::string> m_openedFilePaths;
 		Context* m_context;
 	};
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/EngineDefs.h"
 #include <string>
 #include <map>
+#include <mutex>
 //=============================
 
 namespace Directus
@@ -69,7 +70,7 @@ namespace Directus
 		const std::string& GetStatus(int progressID)				{ return m_reports[progressID].status; }
 		void SetStatus(int progressID, const std::string& status)	{ m_reports[progressID].status = status; }
 		void SetJobCount(int progressID, int jobCount)				{ m_reports[progressID].jobCount = jobCount;}
-		void IncrementJobsDone(int progressID)						{ m_reports[progressID].jobsDone++; }
+		void IncrementJobsDone(int progressID)						{ std::lock_guard<std::mutex> guard(m_mutex); m_reports[progressID].jobsDone++; }
 		void SetJobsDone(int progressID, int jobsDone)				{ m_reports[progressID].jobsDone = jobsDone; }
 		float GetPercentage(int progressID)							{ return (float)m_reports[progressID].jobsDone / (float)m_reports[progressID].jobCount; }
 		bool GetIsLoading(int progressID)							{ return m_reports[progressID].isLoading; }
@@ -77,5 +78,6 @@ namespace Directus
 
 	private:	
 		std::map<int, Progress> m_reports;
+		std::mutex m_mutex;
 	};
 }
\ No newline at end of file
@@ -24,35 +24,119 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==============
 #include <vector>
 #include <memory>
+#include <map>
+#include <unordered_map>
+#include <shared_mutex>
+#include <algorithm>
 #include "IResource.h"
 #include "../Logging/Log.h"
-#include <mutex>
 //========================
 
 namespace Directus
 {
+	// Resources are indexed by type, name, path and ID. Lookups take a shared lock
+	// so worker threads can query the cache concurrently, insertions take an exclusive one.
 	class ENGINE_CLASS ResourceCache
 	{
 	public:
 		ResourceCache() {}
 		~ResourceCache() { Clear(); }
 
-		// Adds a resource
-		void Add(const std::shared_ptr<IResource>& resource)
+		// Adds a resource, returns the one that ends up cached (an existing resource with the same name wins)
+		std::shared_ptr<IResource> Add(const std::shared_ptr<IResource>& resource)
 		{
 			if (!resource)
+				return resource;
+
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			auto& group		= m_resourceGroups[resource->GetResourceType()];
+			const auto& name	= resource->GetResourceName();
+
+			// Unnamed resources are never considered duplicates
+			if (name != NOT_ASSIGNED)
+			{
+				auto existing = Find(group.byName, name);
+				if (existing && existing->GetResourceName() == name)
+				{
+					existing->Touch();
+					return existing;
+				}
+
+				group.byName[name] = resource;
+			}
+
+			group.resources.push_back(resource);
+			group.byPath[resource->GetResourceFilePath()]	= resource;
+			m_byID[resource->Resource_GetID()]				= resource;
+			resource->Touch();
+
+			return resource;
+		}
+
+		// Updates the indices of a resource whose name, path or ID changed after it was cached
+		void Reindex(const std::shared_ptr<IResource>& resource, const std::string& oldName, const std::string& oldPath, unsigned int oldID)
+		{
+			if (!resource)
+				return;
+
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			auto& group = m_resourceGroups[resource->GetResourceType()];
+
+			auto itName = group.byName.find(oldName);
+			if (itName != group.byName.end() && itName->second == resource)
+			{
+				group.byName.erase(itName);
+			}
+
+			auto itPath = group.byPath.find(oldPath);
+			if (itPath != group.byPath.end() && itPath->second == resource)
+			{
+				group.byPath.erase(itPath);
+			}
+
+			auto itID = m_byID.find(oldID);
+			if (itID != m_byID.end() && itID->second == resource)
+			{
+				m_byID.erase(itID);
+			}
+
+			if (resource->GetResourceName() != NOT_ASSIGNED)
+			{
+				group.byName[resource->GetResourceName()] = resource;
+			}
+			group.byPath[resource->GetResourceFilePath()] = resource;
+			m_byID[resource->Resource_GetID()] = resource;
+		}
+
+		// Indexes a resource by a hash of its content, so resources with identical content can be shared
+		void SetContentKey(const std::shared_ptr<IResource>& resource, unsigned long long key)
+		{
+			if (!resource || key == 0)
 				return;
 
-			std::lock_guard<std::mutex> guard(m_mutex);
-			m_resourceGroups[resource->GetResourceType()].push_back(resource);
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			m_resourceGroups[resource->GetResourceType()].byContent[key] = resource;
+		}
+
+		// Returns the resource whose content matches a hash (see SetContentKey())
+		std::shared_ptr<IResource> GetByContent(Resource_Type type, unsigned long long key)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto group = m_resourceGroups.find(type);
+			if (group == m_resourceGroups.end())
+				return nullptr;
+
+			auto it = group->second.byContent.find(key);
+			return Touch(it != group->second.byContent.end() ? it->second : nullptr);
 		}
 
 		// Returns the file paths of all the resources
 		void GetResourceFilePaths(std::vector<std::string>& filePaths)
 		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
 			for (const auto& resourceGroup : m_resourceGroups)
 			{
-				for (const auto& resource : resourceGroup.second)
+				for (const auto& resource : resourceGroup.second.resources)
 				{
 					filePaths.push_back(resource->GetResourceFilePath());
 				}
@@ -62,25 +146,22 @@ namespace Directus
 		// Makes the resources save their metadata
 		void SaveResourcesToFiles()
 		{
-			for (const auto& resourceGroup : m_resourceGroups)
+			// Saving can trigger cache lookups, so work on a copy
+			for (const auto& resource : GetAll())
 			{
-				for (const auto& resource : resourceGroup.second)
-				{
-					if (!resource->HasFilePath())
-						continue;
-
-					resource->SaveToFile(resource->GetResourceFilePath());
-				}
+				// Only resources which changed are written
+				resource->SaveToFileIfDirty();
 			}
 		}
 
 		// Returns all the resources
 		std::vector<std::shared_ptr<IResource>> GetAll()
 		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
 			std::vector<std::shared_ptr<IResource>> resources;
 			for (const auto& resourceGroup : m_resourceGroups)
 			{
-				resources.insert(resources.end(), resourceGroup.second.begin(), resourceGroup.second.end());
+				resources.insert(resources.end(), resourceGroup.second.resources.begin(), resourceGroup.second.resources.end());
 			}
 
 			return resources;
@@ -90,38 +171,47 @@ namespace Directus
 		template <class T>
 		std::shared_ptr<IResource> GetByName(const std::string& name)
 		{
-			for (const auto& resource : m_resourceGroups[IResource::DeduceResourceType<T>()])
-			{
-				if (name == resource->GetResourceName())
-					return resource;
-			}
-
-			return std::shared_ptr<IResource>();
+			return GetByName(name, IResource::DeduceResourceType<T>());
 		}
 
 		// Returns a resource by name
 		std::shared_ptr<IResource> GetByName(const std::string& name, Resource_Type type)
 		{
-			for (const auto& resource : m_resourceGroups[type])
-			{
-				if (name == resource->GetResourceName())
-					return resource;
-			}
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto group = m_resourceGroups.find(type);
+			if (group == m_resourceGroups.end())
+				return nullptr;
 
-			return std::shared_ptr<IResource>();
+			// Resources can be renamed after they are cached, make sure the index is not stale
+			auto resource = Find(group->second.byName, name);
+			return Touch((resource && resource->GetResourceName() == name) ? resource : nullptr);
 		}
 
 		// Returns a resource by path
 		template <class T>
 		std::shared_ptr<IResource> GetByPath(const std::string& path)
 		{
-			for (const auto& resource : m_resourceGroups[IResource::DeduceResourceType<T>()])
-			{
-				if (path == resource->GetResourceFilePath())
-					return resource;
-			}
+			return GetByPath(path, IResource::DeduceResourceType<T>());
+		}
 
-			return std::shared_ptr<IResource>();
+		// Returns a resource by path
+		std::shared_ptr<IResource> GetByPath(const std::string& path, Resource_Type type)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto group = m_resourceGroups.find(type);
+			if (group == m_resourceGroups.end())
+				return nullptr;
+
+			auto resource = Find(group->second.byPath, path);
+			return Touch((resource && resource->GetResourceFilePath() == path) ? resource : nullptr);
+		}
+
+		// Returns a resource by ID
+		std::shared_ptr<IResource> GetByID(unsigned int id)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto it = m_byID.find(id);
+			return Touch(it != m_byID.end() ? it->second : nullptr);
 		}
 
 		// Checks whether a resource is already cached
@@ -139,51 +229,199 @@ namespace Directus
 				return false;
 			}
 
-			for (const auto& resource : m_resourceGroups[resourceType])
+			return GetByName(resourceName, resourceType) != nullptr;
+		}
+
+		unsigned long long GetMemoryUsage()
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			unsigned long long size = 0;
+			for (const auto& group : m_resourceGroups)
 			{
-				if (resourceName == resource->GetResourceName())
-					return true;
+				size += GetMemoryUsage(group.second);
 			}
 
-			return false;
+			return size;
 		}
 
-		unsigned int GetMemoryUsage()
+		unsigned long long GetMemoryUsage(Resource_Type type)
 		{
-			unsigned int size = 0;
-			for (const auto& group : m_resourceGroups)
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto group = m_resourceGroups.find(type);
+			return group != m_resourceGroups.end() ? GetMemoryUsage(group->second) : 0;
+		}
+
+		// Memory budget of a resource type, 0 means unlimited
+		void SetMemoryBudget(Resource_Type type, unsigned long long budget)
+		{
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			m_memoryBudgets[type] = budget;
+		}
+
+		unsigned long long GetMemoryBudget(Resource_Type type)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto it = m_memoryBudgets.find(type);
+			return it != m_memoryBudgets.end() ? it->second : 0;
+		}
+
+		// Evicts the least recently used resources of any type which exceeds its budget, returns the amount of memory freed.
+		// Resources used since the previous call are left alone, so data which was just reloaded isn't evicted again.
+		unsigned long long EnforceMemoryBudgets(unsigned long long usedSince)
+		{
+			// Don't hold the lock while evicting, work on copies instead
+			std::vector<std::pair<unsigned long long, std::vector<std::shared_ptr<IResource>>>> overBudget;
 			{
-				for (const auto& resource : group.second)
+				std::shared_lock<std::shared_mutex> lock(m_mutex);
+				for (const auto& budget : m_memoryBudgets)
 				{
-					if (!resource)
+					auto group = m_resourceGroups.find(budget.first);
+					if (budget.second == 0 || group == m_resourceGroups.end())
 						continue;
 
-					size += resource->GetMemoryUsage();
+					auto usage = GetMemoryUsage(group->second);
+					if (usage > budget.second)
+					{
+						overBudget.emplace_back(usage - budget.second, group->second.resources);
+					}
 				}
 			}
 
-			return size;
+			unsigned long long freedTotal = 0;
+			for (auto& group : overBudget)
+			{
+				auto& resources = group.second;
+				std::sort(resources.begin(), resources.end(), [](const std::shared_ptr<IResource>& a, const std::shared_ptr<IResource>& b)
+				{
+					return a->GetLastUsed() < b->GetLastUsed();
+				});
+
+				unsigned long long freed = 0;
+				for (const auto& resource : resources)
+				{
+					if (freed >= group.first || resource->GetLastUsed() > usedSince)
+						break;
+
+					// Only idle resources, the ones which are loading or referenced outside the cache (this copy aside) could be using their data
+					if (resource->GetLoadState() == LoadState_Started || resource->IsEvicted() || GetOwnerCount(resource) > 1)
+						continue;
+
+					freed += resource->Evict();
+				}
+				freedTotal += freed;
+			}
+
+			return freedTotal;
 		}
 
-		unsigned int GetMemoryUsage(Resource_Type type)
+		// Returns all resources of a given type
+		std::vector<std::shared_ptr<IResource>> GetByType(Resource_Type type)
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto group = m_resourceGroups.find(type);
+			return group != m_resourceGroups.end() ? group->second.resources : std::vector<std::shared_ptr<IResource>>();
+		}
+
+		// Removes a resource from the cache (it stays alive for as long as it's referenced elsewhere)
+		void Remove(const std::shared_ptr<IResource>& resource)
 		{
-			unsigned int size = 0;
-			for (const auto& resource : m_resourceGroups[type])
+			if (!resource)
+				return;
+
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			auto& group = m_resourceGroups[resource->GetResourceType()];
+			group.resources.erase(std::remove(group.resources.begin(), group.resources.end(), resource), group.resources.end());
+
+			auto itName = group.byName.find(resource->GetResourceName());
+			if (itName != group.byName.end() && itName->second == resource)
 			{
-				size += resource->GetMemoryUsage();
+				group.byName.erase(itName);
 			}
 
-			return size;
+			auto itPath = group.byPath.find(resource->GetResourceFilePath());
+			if (itPath != group.byPath.end() && itPath->second == resource)
+			{
+				group.byPath.erase(itPath);
+			}
+
+			// A resource can have more than one content key
+			for (auto it = group.byContent.begin(); it != group.byContent.end();)
+			{
+				it = it->second == resource ? group.byContent.erase(it) : std::next(it);
+			}
+
+			m_byID.erase(resource->Resource_GetID());
 		}
 
-		// Returns all resources of a given type
-		const std::vector<std::shared_ptr<IResource>>& GetByType(Resource_Type type) { return m_resourceGroups[type]; }
+		// Returns how many owners a resource has besides the cache, the references the caller holds included
+		long GetOwnerCount(const std::shared_ptr<IResource>& resource)
+		{
+			if (!resource)
+				return 0;
+
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto IsResource = [&resource](const auto& entry) { return entry.second == resource; };
+			long cacheReferences = (long)std::count_if(m_byID.begin(), m_byID.end(), IsResource);
+			auto group = m_resourceGroups.find(resource->GetResourceType());
+			if (group != m_resourceGroups.end())
+			{
+				cacheReferences += (long)std::count(group->second.resources.begin(), group->second.resources.end(), resource);
+				cacheReferences += (long)std::count_if(group->second.byName.begin(), group->second.byName.end(), IsResource);
+				cacheReferences += (long)std::count_if(group->second.byPath.begin(), group->second.byPath.end(), IsResource);
+				cacheReferences += (long)std::count_if(group->second.byContent.begin(), group->second.byContent.end(), IsResource);
+			}
+
+			return resource.use_count() - cacheReferences;
+		}
 
 		// Unloads all resources
-		void Clear() { m_resourceGroups.clear(); }
+		void Clear()
+		{
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			m_resourceGroups.clear();
+			m_byID.clear();
+		}
 
 	private:
-		std::map<Resource_Type, std::vector<std::shared_ptr<IResource>>> m_resourceGroups;
-		std::mutex m_mutex;
+		typedef std::unordered_map<std::string, std::shared_ptr<IResource>> ResourceIndex;
+
+		struct ResourceGroup
+		{
+			std::vector<std::shared_ptr<IResource>> resources;
+			ResourceIndex byName;
+			ResourceIndex byPath;
+			std::unordered_map<unsigned long long, std::shared_ptr<IResource>> byContent;
+		};
+
+		static std::shared_ptr<IResource> Find(const ResourceIndex& index, const std::string& key)
+		{
+			auto it = index.find(key);
+			return it != index.end() ? it->second : nullptr;
+		}
+
+		static std::shared_ptr<IResource> Touch(const std::shared_ptr<IResource>& resource)
+		{
+			if (resource)
+			{
+				resource->Touch();
+			}
+			return resource;
+		}
+
+		static unsigned long long GetMemoryUsage(const ResourceGroup& group)
+		{
+			unsigned long long size = 0;
+			for (const auto& resource : group.resources)
+			{
+				size += resource->GetMemoryUsage();
+			}
+
+			return size;
+		}
+
+		std::map<Resource_Type, ResourceGroup> m_resourceGroups;
+		std::unordered_map<unsigned int, std::shared_ptr<IResource>> m_byID;
+		std::map<Resource_Type, unsigned long long> m_memoryBudgets;
+		std::shared_mutex m_mutex;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+//= INCLUDES ============
+#include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <functional>
+#include "IResource.h"
+//=======================
+
+namespace Directus
+{
+	// The shared state of an asynchronous load, see ResourceManager::LoadAsync()
+	struct ResourceRequest
+	{
+		std::string filePath;
+		Resource_Type type				= Resource_Unknown;
+		LoadPriority priority			= LoadPriority_Normal;
+		unsigned long long order		= 0;
+		std::atomic<LoadState> state	= { LoadState_Idle };
+		std::shared_ptr<IResource> resource;
+		std::shared_ptr<IResource> placeholder;
+		std::function<std::shared_ptr<IResource>()> factory;
+		std::vector<std::function<void(const std::shared_ptr<IResource>&)>> callbacks;
+	};
+
+	template <class T>
+	class ResourceHandle
+	{
+	public:
+		ResourceHandle() {}
+		ResourceHandle(const std::shared_ptr<ResourceRequest>& request) { m_request = request; }
+
+		// Returns the resource once it's loaded and the placeholder (if any) until then
+		std::shared_ptr<T> Get() const
+		{
+			if (!m_request)
+				return nullptr;
+
+			return std::static_pointer_cast<T>(IsReady() ? m_request->resource : m_request->placeholder);
+		}
+
+		LoadState GetLoadState() const		{ return m_request ? m_request->state.load() : LoadState_Idle; }
+		bool IsReady() const				{ return GetLoadState() == LoadState_Completed; }
+		bool IsValid() const				{ return m_request != nullptr; }
+		const std::string& GetFilePath()	{ return m_request ? m_request->filePath : NOT_ASSIGNED; }
+
+	private:
+		std::shared_ptr<ResourceRequest> m_request;
+	};
+}
\ No newline at end of file
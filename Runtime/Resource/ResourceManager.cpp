@@ -23,6 +23,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ResourceManager.h"
 #include "../World/Actor.h"
 #include "../Core/EventSystem.h"
+#include "../Core/Stopwatch.h"
+#include "../Threading/Threading.h"
+#include <queue>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 //==============================
 
 //= NAMESPACES ================
@@ -32,10 +41,94 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	// Shared with the worker tasks, so tasks which start after the ResourceManager is gone can bail out safely
+	struct AsyncLoadQueue
+	{
+		// Priority and order are copied, so a request can be re-queued with a higher priority without breaking the heap
+		struct Entry
+		{
+			LoadPriority priority;
+			unsigned long long order;
+			shared_ptr<ResourceRequest> request;
+
+			bool operator<(const Entry& other) const
+			{
+				// Highest priority first, then first come first served
+				return priority != other.priority ? priority < other.priority : order > other.order;
+			}
+		};
+
+		bool Enter()
+		{
+			lock_guard<mutex> guard(queueMutex);
+			if (stopping)
+				return false;
+
+			tasksRunning++;
+			return true;
+		}
+
+		void Leave()
+		{
+			lock_guard<mutex> guard(queueMutex);
+			tasksRunning--;
+		}
+
+		std::mutex queueMutex;
+		priority_queue<Entry> pending;
+		unordered_map<string, shared_ptr<ResourceRequest>> inFlight;	// by type and path, so requests for the same resource are merged
+		deque<shared_ptr<ResourceRequest>> finalize;					// read, waiting for the main thread
+		unsigned long long order	= 0;
+		unsigned int tasksRunning	= 0;
+		bool stopping				= false;
+	};
+
+	namespace _ResourceManager
+	{
+		// Time the main thread spends finalizing asynchronous loads, per frame
+		static const double finalizeBudgetMs = 2.0;
+		// How often memory budgets are enforced
+		static const double budgetIntervalMs = 1000.0;
+		// Default budgets for CPU-side resource data
+		static const unsigned long long budgetTextures	= 512ull * 1024 * 1024;
+		static const unsigned long long budgetModels	= 256ull * 1024 * 1024;
+
+		inline string RequestKey(const shared_ptr<ResourceRequest>& request) { return to_string((int)request->type) + ":" + request->filePath; }
+
+		inline Resource_Type TypeFromFilePath(const string& filePath)
+		{
+			if (FileSystem::IsEngineTextureFile(filePath) || FileSystem::IsSupportedImageFile(filePath))	return Resource_Texture;
+			if (FileSystem::IsEngineMaterialFile(filePath))													return Resource_Material;
+			if (FileSystem::IsEngineModelFile(filePath) || FileSystem::IsSupportedModelFile(filePath))		return Resource_Model;
+
+			return Resource_Unknown;
+		}
+	}
+
 	ResourceManager::ResourceManager(Context* context) : Subsystem(context)
 	{
-		m_resourceCache = nullptr;
-		SUBSCRIBE_TO_EVENT(EVENT_WORLD_UNLOAD, EVENT_HANDLER(Clear));
+		m_resourceCache	= nullptr;
+		m_asyncQueue	= make_shared<AsyncLoadQueue>();
+	}
+
+	ResourceManager::~ResourceManager()
+	{
+		// Stop asynchronous loading and wait for any reads which are in progress
+		{
+			lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+			m_asyncQueue->stopping = true;
+		}
+		while (true)
+		{
+			{
+				lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+				if (m_asyncQueue->tasksRunning == 0)
+					break;
+			}
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+
+		Clear();
 	}
 
 	bool ResourceManager::Initialize()
@@ -48,6 +141,7 @@ namespace Directus
 		m_modelImporter = make_shared<ModelImporter>(m_context);
 		m_fontImporter = make_shared<FontImporter>(m_context);
 		m_fontImporter->Initialize();
+		m_derivedDataCache = make_unique<DerivedDataCache>("DerivedDataCache//");
 		
 		// Add engine standard resource directories
 		AddStandardResourceDirectory(Resource_Texture,	"Standard Assets//Textures//");
@@ -61,6 +155,34 @@ namespace Directus
 		// Add project directory
 		SetProjectDirectory("Project//");
 
+		// Asynchronous loads are finalized on the main thread
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_START, EVENT_HANDLER(LoadAsync_Finalize));
+
+		// Memory budgets
+		SetMemoryBudget(Resource_Texture,	_ResourceManager::budgetTextures);
+		SetMemoryBudget(Resource_Model,		_ResourceManager::budgetModels);
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_START, EVENT_HANDLER(EnforceMemoryBudgets));
+
+		// Hot reload
+		m_hotReload = make_unique<HotReload>(m_context);
+		HotReload_Watch();
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_START, EVENT_HANDLER(m_hotReload->Tick));
+
+		// Texture streaming
+		m_textureStreamer = make_unique<TextureStreamer>(m_context);
+		SUBSCRIBE_TO_EVENT(EVENT_WORLD_SUBMIT, EVENT_HANDLER_VARIANT(m_textureStreamer->SetActors));
+		SUBSCRIBE_TO_EVENT(EVENT_WORLD_UNLOAD, EVENT_HANDLER(m_textureStreamer->ClearActors));
+		SUBSCRIBE_TO_EVENT(EVENT_FRAME_START, EVENT_HANDLER(m_textureStreamer->Tick));
+
+		// Mount any asset archives that ship next to the executable
+		for (const auto& filePath : FileSystem::GetFilesInDirectory(FileSystem::GetWorkingDirectory()))
+		{
+			if (FileSystem::IsEngineArchiveFile(filePath))
+			{
+				FileSystem::Mount(filePath);
+			}
+		}
+
 		return true;
 	}
 
@@ -88,10 +210,354 @@ namespace Directus
 		}
 
 		m_projectDirectory = directory;
+		HotReload_Watch();
+	}
+
+	void ResourceManager::HotReload_Watch()
+	{
+		if (!m_hotReload)
+			return;
+
+		m_hotReload->Watch(
+		{
+			GetStandardResourceDirectory(Resource_Texture),
+			GetStandardResourceDirectory(Resource_Material),
+			GetStandardResourceDirectory(Resource_Shader),
+			GetStandardResourceDirectory(Resource_Script),
+			m_projectDirectory
+		});
 	}
 
 	string ResourceManager::GetProjectDirectoryAbsolute()
 	{
 		return FileSystem::GetWorkingDirectory() + m_projectDirectory;
 	}
-}
+
+	shared_ptr<ResourceRequest> ResourceManager::LoadAsync(const shared_ptr<ResourceRequest>& request)
+	{
+		request->placeholder = GetPlaceholder(request->type);
+
+		// Already loaded, the callbacks still run where they always do (LoadAsync_Finalize())
+		auto name = FileSystem::GetFileNameNoExtensionFromFilePath(request->filePath);
+		if (auto cached = m_resourceCache->GetByName(name, request->type))
+		{
+			request->resource	= cached;
+			request->state		= LoadState_Completed;
+			if (!request->callbacks.empty())
+			{
+				lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+				m_asyncQueue->finalize.emplace_back(request);
+			}
+			return request;
+		}
+
+		shared_ptr<ResourceRequest> result = request;
+		{
+			lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+
+			// Already loading, merge into the existing request
+			auto key		= _ResourceManager::RequestKey(request);
+			auto existing	= m_asyncQueue->inFlight.find(key);
+			if (existing != m_asyncQueue->inFlight.end())
+			{
+				auto& other = existing->second;
+				other->callbacks.insert(other->callbacks.end(), request->callbacks.begin(), request->callbacks.end());
+
+				// Re-queue it with the higher priority, the stale entry is skipped when it comes up
+				if (request->priority > other->priority && other->state == LoadState_Idle)
+				{
+					other->priority = request->priority;
+					m_asyncQueue->pending.push({ other->priority, other->order, other });
+					result = other;
+				}
+				else
+				{
+					return other;
+				}
+			}
+			else
+			{
+				request->order = m_asyncQueue->order++;
+				m_asyncQueue->inFlight[key] = request;
+				m_asyncQueue->pending.push({ request->priority, request->order, request });
+			}
+		}
+
+		// One task per queue entry, each task picks the most important request at the time it runs
+		auto queue = m_asyncQueue;
+		m_context->GetSubsystem<Threading>()->AddTask([this, queue]()
+		{
+			if (!queue->Enter())
+				return;
+
+			LoadAsync_Read();
+			queue->Leave();
+		});
+
+		return result;
+	}
+
+	void ResourceManager::LoadAsync_Read()
+	{
+		shared_ptr<ResourceRequest> request;
+		{
+			lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+			if (m_asyncQueue->pending.empty())
+				return;
+
+			request = m_asyncQueue->pending.top().request;
+			m_asyncQueue->pending.pop();
+		}
+
+		// Skip stale entries (requests that were re-queued with a higher priority)
+		LoadState expected = LoadState_Idle;
+		if (!request->state.compare_exchange_strong(expected, LoadState_Started))
+			return;
+
+		auto resource = request->factory();
+		resource->SetResourceName(FileSystem::GetFileNameNoExtensionFromFilePath(request->filePath));
+		resource->SetResourceFilePath(request->filePath);
+		resource->SetLoadState(LoadState_Started);
+
+		if (resource->LoadAsync_Read(request->filePath))
+		{
+			request->resource = resource;
+		}
+		else
+		{
+			LOGF_WARNING("ResourceManager::LoadAsync: Resource \"%s\" failed to load", request->filePath.c_str());
+		}
+
+		lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+		m_asyncQueue->finalize.emplace_back(request);
+	}
+
+	void ResourceManager::LoadAsync_Finalize()
+	{
+		Stopwatch timer;
+		while (timer.GetElapsedTimeMs() < _ResourceManager::finalizeBudgetMs)
+		{
+			shared_ptr<ResourceRequest> request;
+			{
+				lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+				if (m_asyncQueue->finalize.empty())
+					return;
+
+				request = m_asyncQueue->finalize.front();
+				m_asyncQueue->finalize.pop_front();
+			}
+
+			// Requests for cached resources only need their callbacks invoked, they were never in flight
+			bool cached = request->state == LoadState_Completed;
+			if (!cached)
+			{
+				if (request->resource && request->resource->LoadAsync_Finalize())
+				{
+					// If the same resource was loaded synchronously in the meantime, use that one
+					request->resource = m_resourceCache->Add(request->resource);
+					request->resource->SetLoadState(LoadState_Completed);
+					request->state = LoadState_Completed;
+				}
+				else
+				{
+					if (request->resource)
+					{
+						LOGF_WARNING("ResourceManager::LoadAsync: Resource \"%s\" failed to finalize", request->filePath.c_str());
+					}
+					request->resource	= nullptr;
+					request->state		= LoadState_Failed;
+				}
+			}
+
+			// Callbacks can't be added anymore once the request is no longer in flight
+			vector<function<void(const shared_ptr<IResource>&)>> callbacks;
+			{
+				lock_guard<mutex> guard(m_asyncQueue->queueMutex);
+				if (!cached)
+				{
+					m_asyncQueue->inFlight.erase(_ResourceManager::RequestKey(request));
+				}
+				callbacks.swap(request->callbacks);
+			}
+
+			for (const auto& callback : callbacks)
+			{
+				callback(request->resource);
+			}
+		}
+	}
+
+	void ResourceManager::EnforceMemoryBudgets()
+	{
+		if (m_budgetTimer.GetElapsedTimeMs() < _ResourceManager::budgetIntervalMs)
+			return;
+		m_budgetTimer.Start();
+
+		// Anything used since the last check is considered in use
+		auto freed			= m_resourceCache->EnforceMemoryBudgets(m_budgetLastUsed);
+		m_budgetLastUsed	= IResource::GetLastUsedGlobal();
+
+		if (freed != 0)
+		{
+			LOGF_INFO("ResourceManager::EnforceMemoryBudgets: Evicted %.1f MB", freed / 1024.0 / 1024.0);
+		}
+	}
+
+	void ResourceManager::SetDependencies(const string& filePath, const vector<string>& dependencies)
+	{
+		lock_guard<mutex> guard(m_dependenciesMutex);
+		m_dependencies[filePath] = dependencies;
+	}
+
+	vector<string> ResourceManager::GetDependencies(const string& filePath)
+	{
+		{
+			lock_guard<mutex> guard(m_dependenciesMutex);
+			auto it = m_dependencies.find(filePath);
+			if (it != m_dependencies.end())
+				return it->second;
+		}
+
+		// Only materials and models depend on other resources
+		vector<string> dependencies;
+		if (FileSystem::IsEngineMaterialFile(filePath))
+		{
+			Material::ReadDependencies(filePath, &dependencies);
+		}
+		else if (FileSystem::IsEngineModelFile(filePath))
+		{
+			Model::ReadDependencies(filePath, &dependencies);
+		}
+
+		SetDependencies(filePath, dependencies);
+		return dependencies;
+	}
+
+	void ResourceManager::Prefetch(const vector<string>& filePaths, const function<void(const string&)>& onLoaded, vector<shared_ptr<IResource>>* resources)
+	{
+		// The level of a resource is the length of the longest chain of dependencies below it
+		unordered_map<string, unsigned int> levels;
+		function<unsigned int(const string&)> ComputeLevel = [this, &levels, &ComputeLevel](const string& filePath)
+		{
+			auto it = levels.find(filePath);
+			if (it != levels.end())
+				return it->second;
+
+			levels[filePath] = 0; // guards against cycles
+			unsigned int level = 0;
+			for (const auto& dependency : GetDependencies(filePath))
+			{
+				level = max(level, ComputeLevel(dependency) + 1);
+			}
+			levels[filePath] = level;
+
+			return level;
+		};
+
+		vector<vector<string>> batches;
+		for (const auto& filePath : filePaths)
+		{
+			ComputeLevel(filePath);
+		}
+		for (const auto& level : levels)
+		{
+			if (batches.size() <= level.second)
+			{
+				batches.resize(level.second + 1);
+			}
+			batches[level.second].emplace_back(level.first);
+		}
+
+		// Load a level at a time, starting with the resources which depend on nothing, everything within a level in parallel
+		auto threading = m_context->GetSubsystem<Threading>();
+		unordered_set<string> requested(filePaths.begin(), filePaths.end());
+		mutex resourcesMutex;
+		for (const auto& batch : batches)
+		{
+			TaskGroup group;
+			for (const auto& filePath : batch)
+			{
+				threading->AddTask([this, &filePath, &requested, &onLoaded, &resourcesMutex, resources]()
+				{
+					auto resource = LoadByFilePath(filePath);
+					if (resource && resources)
+					{
+						lock_guard<mutex> guard(resourcesMutex);
+						resources->emplace_back(resource);
+					}
+
+					if (onLoaded && requested.count(filePath))
+					{
+						onLoaded(filePath);
+					}
+				}, &group);
+			}
+
+			// Help out with the work until this level is done
+			threading->Wait(&group);
+		}
+	}
+
+	void ResourceManager::Unload(const string& filePath)
+	{
+		auto resource = GetResourceByFilePath(filePath);
+		if (!resource)
+			return;
+
+		m_resourceCache->Remove(resource);
+
+		// Dependencies stay while a cached resource depends on them, or while anything else (e.g. a live material) owns them
+		for (const auto& dependency : GetDependencies(filePath))
+		{
+			auto dependencyResource = GetResourceByFilePath(dependency);
+			if (dependencyResource && GetDependentCount(dependency) == 0 && GetOwnerCount(dependencyResource) <= 1)
+			{
+				dependencyResource = nullptr;
+				Unload(dependency);
+			}
+		}
+	}
+
+	shared_ptr<IResource> ResourceManager::LoadByFilePath(const string& filePath)
+	{
+		switch (_ResourceManager::TypeFromFilePath(filePath))
+		{
+			case Resource_Texture:	return Load<RHI_Texture>(filePath);
+			case Resource_Material:	return Load<Material>(filePath);
+			case Resource_Model:	return Load<Model>(filePath);
+			default:				return nullptr; // e.g. audio, fonts and shaders are loaded by their owners
+		}
+	}
+
+	shared_ptr<IResource> ResourceManager::GetResourceByFilePath(const string& filePath)
+	{
+		return m_resourceCache->GetByPath(filePath, _ResourceManager::TypeFromFilePath(filePath));
+	}
+
+	unsigned int ResourceManager::GetDependentCount(const string& filePath)
+	{
+		vector<string> dependents;
+		{
+			lock_guard<mutex> guard(m_dependenciesMutex);
+			for (const auto& node : m_dependencies)
+			{
+				if (find(node.second.begin(), node.second.end(), filePath) != node.second.end())
+				{
+					dependents.emplace_back(node.first);
+				}
+			}
+		}
+
+		// Only the ones which are loaded count
+		unsigned int count = 0;
+		for (const auto& dependent : dependents)
+		{
+			if (GetResourceByFilePath(dependent))
+			{
+				count++;
+			}
+		}
+
+		return count;
+	}
+}
\ No newline at end of file
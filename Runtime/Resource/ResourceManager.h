@@ -24,7 +24,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
 #include "ResourceCache.h"
+#include "ResourceHandle.h"
+#include "DerivedDataCache.h"
+#include "HotReload.h"
+#include "TextureStreamer.h"
 #include "Import/ModelImporter.h"
 #include "Import/ImageImporter.h"
 #include "Import/FontImporter.h"
@@ -33,6 +40,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../RHI/RHI_Texture.h"
 #include "../Rendering/Model.h"
 #include "../Rendering/Material.h"
+#include "../Core/Stopwatch.h"
 //================================
 
 namespace Directus
@@ -41,7 +49,7 @@ namespace Directus
 	{
 	public:
 		ResourceManager(Context* context);
-		~ResourceManager() { Clear(); }
+		~ResourceManager();
 
 		//= Subsystem =============
 		bool Initialize() override;
@@ -50,6 +58,11 @@ namespace Directus
 		// Unloads all resources
 		void Clear() { m_resourceCache->Clear(); }
 
+		// Removes a resource from the cache (it stays alive for as long as it's referenced elsewhere)
+		void Remove(const std::shared_ptr<IResource>& resource) { m_resourceCache->Remove(resource); }
+		// Owners of a resource besides the cache, the references the caller holds included
+		long GetOwnerCount(const std::shared_ptr<IResource>& resource) { return m_resourceCache->GetOwnerCount(resource); }
+
 		// Loads a resource and adds it to the resource cache
 		template <class T>
 		std::shared_ptr<T> Load(const std::string& filePath)
@@ -65,10 +78,8 @@ namespace Directus
 			std::string name				= FileSystem::GetFileNameNoExtensionFromFilePath(filePathRelative);
 
 			// Check if the resource is already loaded
-			if (m_resourceCache->IsCached(name, IResource::DeduceResourceType<T>()))
-			{
-				return GetResourceByName<T>(name);
-			}
+			if (auto cached = GetResourceByName<T>(name))
+				return cached;
 
 			// Create new resource
 			auto typed = std::make_shared<T>(m_context);
@@ -76,20 +87,70 @@ namespace Directus
 			typed->SetResourceName(name);
 			typed->SetResourceFilePath(filePathRelative);
 
-			// Cache it now so LoadFromFile() can safely pass around a reference to the resource from the ResourceManager
-			Add<T>(typed);
+			// Cache it now so LoadFromFile() can safely pass around a reference to the resource from the ResourceManager.
+			// If another thread got there first, use its resource instead of loading the same file twice.
+			auto cached = m_resourceCache->Add(typed);
+			if (cached != typed)
+				return std::dynamic_pointer_cast<T>(cached);
+			unsigned int id = typed->Resource_GetID();
 
 			// Load
 			if (!typed->LoadFromFile(filePathRelative))
 			{
 				LOGF_WARNING("ResourceManager::Load: Resource \"%s\" failed to load", filePathRelative.c_str());
+				m_resourceCache->Remove(typed);
 				return nullptr;
 			}
 
-			// Cache it and cast it
+			// LoadFromFile() can rename the resource (e.g. foreign formats become engine formats)
+			if (typed->GetResourceName() != name || typed->GetResourceFilePath() != filePathRelative || typed->Resource_GetID() != id)
+			{
+				m_resourceCache->Reindex(typed, name, filePathRelative, id);
+			}
+
 			return typed;
 		}
 
+		// Loads a resource on the worker threads and returns immediately. The handle resolves to the placeholder
+		// of the resource type (if any) until loading completes. GPU resources are created on the main thread,
+		// at the start of a frame, which is also where the callback is invoked (with nullptr if loading failed).
+		template <class T>
+		ResourceHandle<T> LoadAsync(const std::string& filePath, LoadPriority priority = LoadPriority_Normal, const std::function<void(const std::shared_ptr<T>&)>& callback = nullptr)
+		{
+			auto request		= std::make_shared<ResourceRequest>();
+			request->filePath	= FileSystem::GetRelativeFilePath(filePath);
+			request->type		= IResource::DeduceResourceType<T>();
+			request->priority	= priority;
+			request->factory	= [this]() { return std::static_pointer_cast<IResource>(std::make_shared<T>(m_context)); };
+			if (callback)
+			{
+				request->callbacks.emplace_back([callback](const std::shared_ptr<IResource>& resource) { callback(std::static_pointer_cast<T>(resource)); });
+			}
+
+			return ResourceHandle<T>(LoadAsync(request));
+		}
+
+		//= DEPENDENCIES ==================================================================================================================
+		// Records the file paths a resource depends on (engine formats do this when they are saved or loaded)
+		void SetDependencies(const std::string& filePath, const std::vector<std::string>& dependencies);
+		// Returns the file paths a resource depends on, they are read from its header if they aren't known yet
+		std::vector<std::string> GetDependencies(const std::string& filePath);
+		// Loads resources along with everything they depend on. Dependencies are loaded first and in parallel,
+		// so resources find them cached instead of discovering and loading them one by one. Everything that was
+		// loaded, dependencies included, is appended to resources (if provided).
+		void Prefetch(const std::vector<std::string>& filePaths, const std::function<void(const std::string&)>& onLoaded = nullptr, std::vector<std::shared_ptr<IResource>>* resources = nullptr);
+		// Removes a resource from the cache, along with any dependencies that nothing else depends on or owns
+		void Unload(const std::string& filePath);
+		//=================================================================================================================================
+
+		// Resource returned by handles while loading
+		void SetPlaceholder(Resource_Type type, const std::shared_ptr<IResource>& resource) { m_placeholders[type] = resource; }
+		std::shared_ptr<IResource> GetPlaceholder(Resource_Type type)
+		{
+			auto it = m_placeholders.find(type);
+			return it != m_placeholders.end() ? it->second : nullptr;
+		}
+
 		// Adds a resource into the cache and returns the derived resource as a weak reference
 		template <class T>
 		std::shared_ptr<T> Add(std::shared_ptr<IResource> resource)
@@ -97,23 +158,13 @@ namespace Directus
 			if (!resource)
 				return nullptr;
 
-			// If the resource is already loaded, return the existing one
-			if (m_resourceCache->IsCached(resource))
-			{
-				return GetResourceByName<T>(FileSystem::GetFileNameNoExtensionFromFilePath(resource->GetResourceFilePath()));
-			}
-
-			Add(resource);
-			return std::dynamic_pointer_cast<T>(resource);
+			// If the resource is already loaded, the existing one is returned
+			return std::dynamic_pointer_cast<T>(m_resourceCache->Add(resource));
 		}
 
 		// Adds a resource into the cache (if it's not already cached)
 		void Add(std::shared_ptr<IResource> resource)
 		{
-			if (!resource || m_resourceCache->IsCached(resource))
-				return;
-
-			// Add the resource
 			m_resourceCache->Add(resource);
 		}
 
@@ -143,6 +194,26 @@ namespace Directus
 			return std::dynamic_pointer_cast<T>(m_resourceCache->GetByPath<T>(path));
 		}
 
+		// Returns cached resource by ID
+		template <class T>
+		std::shared_ptr<T> GetResourceByID(unsigned int id)
+		{
+			return std::dynamic_pointer_cast<T>(m_resourceCache->GetByID(id));
+		}
+
+		// Returns cached resource by content (see SetResourceContentKey())
+		template <class T>
+		std::shared_ptr<T> GetResourceByContent(unsigned long long key)
+		{
+			return std::dynamic_pointer_cast<T>(m_resourceCache->GetByContent(IResource::DeduceResourceType<T>(), key));
+		}
+
+		// Associates a hash of some content with a resource, so it can be shared by anything with identical content
+		void SetResourceContentKey(const std::shared_ptr<IResource>& resource, unsigned long long key)
+		{
+			m_resourceCache->SetContentKey(resource, key);
+		}
+
 		// Returns cached resource by Type
 		template <class T>
 		std::vector<std::shared_ptr<T>> GetResourcesByType()
@@ -163,12 +234,7 @@ namespace Directus
 
 		std::vector<std::shared_ptr<IResource>> GetResourcesByType(Resource_Type type)
 		{
-			std::vector<std::shared_ptr<IResource>> vec;
-			for (const auto& resource : m_resourceCache->GetByType(type))
-			{
-				vec.emplace_back(resource);
-			}
-			return vec;
+			return m_resourceCache->GetByType(type);
 		}
 
 		// Returns all resources of a given type
@@ -193,8 +259,11 @@ namespace Directus
 		}
 
 		// Memory
-		unsigned int GetMemoryUsage(Resource_Type type)	{ return m_resourceCache->GetMemoryUsage(type); }
-		unsigned int GetMemoryUsage()					{ return m_resourceCache->GetMemoryUsage(); }
+		unsigned long long GetMemoryUsage(Resource_Type type)	{ return m_resourceCache->GetMemoryUsage(type); }
+		unsigned long long GetMemoryUsage()					{ return m_resourceCache->GetMemoryUsage(); }
+		// When a resource type exceeds its budget (0 means unlimited), the CPU-side data of its least recently used resources is evicted
+		void SetMemoryBudget(Resource_Type type, unsigned long long budget)	{ m_resourceCache->SetMemoryBudget(type, budget); }
+		unsigned long long GetMemoryBudget(Resource_Type type)					{ return m_resourceCache->GetMemoryBudget(type); }
 
 		// Directories
 		void AddStandardResourceDirectory(Resource_Type type, const std::string& directory);
@@ -209,7 +278,22 @@ namespace Directus
 		ImageImporter* GetImageImporter()	{ return m_imageImporter.get(); }
 		FontImporter* GetFontImporter()		{ return m_fontImporter.get(); }
 
+		// Data derived from foreign formats by the importers
+		DerivedDataCache* GetDerivedDataCache() { return m_derivedDataCache.get(); }
+
+		// Streams the mips of streamed textures based on their size on screen
+		TextureStreamer* GetTextureStreamer() { return m_textureStreamer.get(); }
+
 	private:
+		std::shared_ptr<ResourceRequest> LoadAsync(const std::shared_ptr<ResourceRequest>& request);
+		void LoadAsync_Read();
+		void LoadAsync_Finalize();
+		void EnforceMemoryBudgets();
+		void HotReload_Watch();
+		std::shared_ptr<IResource> LoadByFilePath(const std::string& filePath);
+		std::shared_ptr<IResource> GetResourceByFilePath(const std::string& filePath);
+		unsigned int GetDependentCount(const std::string& filePath);
+
 		std::unique_ptr<ResourceCache> m_resourceCache;
 		std::map<Resource_Type, std::string> m_standardResourceDirectories;
 		std::string m_projectDirectory;
@@ -218,5 +302,24 @@ namespace Directus
 		std::shared_ptr<ModelImporter> m_modelImporter;
 		std::shared_ptr<ImageImporter> m_imageImporter;
 		std::shared_ptr<FontImporter> m_fontImporter;
+		std::unique_ptr<DerivedDataCache> m_derivedDataCache;
+
+		// Reloads resources which change on disk
+		std::unique_ptr<HotReload> m_hotReload;
+
+		// Streams texture mips in and out
+		std::unique_ptr<TextureStreamer> m_textureStreamer;
+
+		// Asynchronous loading
+		std::shared_ptr<struct AsyncLoadQueue> m_asyncQueue;
+		std::map<Resource_Type, std::shared_ptr<IResource>> m_placeholders;
+
+		// Dependency graph, by file path
+		std::unordered_map<std::string, std::vector<std::string>> m_dependencies;
+		std::mutex m_dependenciesMutex;
+
+		// Memory budgets
+		Stopwatch m_budgetTimer;
+		unsigned long long m_budgetLastUsed = 0;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,333 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================================
+#include "TextureStreamer.h"
+#include <mutex>
+#include <thread>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "../Core/Context.h"
+#include "../Core/Variant.h"
+#include "../Core/Settings.h"
+#include "../Threading/Threading.h"
+#include "../Resource/ResourceManager.h"
+#include "../RHI/RHI_Texture.h"
+#include "../Rendering/Material.h"
+#include "../World/Actor.h"
+#include "../World/Components/Camera.h"
+#include "../World/Components/Renderable.h"
+#include "../World/Components/Transform.h"
+//===================================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	// Shared with the worker tasks, so loads which finish after TextureStreamer is gone are dropped safely
+	struct TextureStreamerState
+	{
+		bool Enter()
+		{
+			lock_guard<mutex> guard(stateMutex);
+			if (stopping)
+				return false;
+
+			tasksRunning++;
+			return true;
+		}
+
+		void Leave(const shared_ptr<RHI_Texture>& texture)
+		{
+			lock_guard<mutex> guard(stateMutex);
+			tasksRunning--;
+			completed.emplace_back(texture);
+		}
+
+		std::mutex stateMutex;
+		unsigned int tasksRunning	= 0;
+		bool stopping				= false;
+
+		// Textures whose load completed (or failed), applied at the start of a frame
+		vector<shared_ptr<RHI_Texture>> completed;
+	};
+
+	namespace _TextureStreamer
+	{
+		// Default budget for the mips of streamed textures
+		static const unsigned long long budget		= 512ull * 1024 * 1024;
+		// Frames between updates of the mips the textures need
+		static const unsigned int updateInterval	= 4;
+		// Loads in flight at any time
+		static const unsigned int loadsMax			= 4;
+
+		struct Request
+		{
+			shared_ptr<RHI_Texture> texture;
+			unsigned int mip	= 0;
+			float texels		= 0.0f; // The most texels it covers on screen, along the largest dimension
+		};
+
+		// The next mip (going down) a texture can start at, the tail if there is none before it
+		inline unsigned int NextMip(RHI_Texture* texture, unsigned int mip)
+		{
+			unsigned int tail = texture->Streaming_GetTailMip();
+			do { mip++; } while (mip < tail && !texture->Streaming_IsValidTopMip(mip));
+			return min(mip, tail);
+		}
+	}
+
+	TextureStreamer::TextureStreamer(Context* context)
+	{
+		m_context	= context;
+		m_state		= make_shared<TextureStreamerState>();
+		m_budget	= _TextureStreamer::budget;
+	}
+
+	TextureStreamer::~TextureStreamer()
+	{
+		// Wait for any loads which are in progress
+		{
+			lock_guard<mutex> guard(m_state->stateMutex);
+			m_state->stopping = true;
+		}
+		while (true)
+		{
+			{
+				lock_guard<mutex> guard(m_state->stateMutex);
+				if (m_state->tasksRunning == 0)
+					break;
+			}
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+	}
+
+	void TextureStreamer::SetActors(const Variant& actors)
+	{
+		m_actors.clear();
+		for (const auto& actor : actors.Get<vector<shared_ptr<Actor>>>())
+		{
+			m_actors.emplace_back(actor);
+		}
+	}
+
+	void TextureStreamer::ClearActors()
+	{
+		// The textures which are still tracked are streamed out by the next update
+		m_actors.clear();
+	}
+
+	void TextureStreamer::Tick()
+	{
+		Apply();
+
+		if (m_frame++ % _TextureStreamer::updateInterval == 0)
+		{
+			Update();
+		}
+	}
+
+	void TextureStreamer::Apply()
+	{
+		vector<shared_ptr<RHI_Texture>> completed;
+		{
+			lock_guard<mutex> guard(m_state->stateMutex);
+			completed.swap(m_state->completed);
+		}
+
+		for (const auto& texture : completed)
+		{
+			texture->Streaming_Apply();
+
+			auto it = m_textures.find(texture.get());
+			if (it != m_textures.end())
+			{
+				it->second.loading = false;
+			}
+			m_loadsInFlight--;
+		}
+	}
+
+	void TextureStreamer::Update()
+	{
+		shared_ptr<Camera> camera;
+		for (const auto& actorWeak : m_actors)
+		{
+			auto actor = actorWeak.lock();
+			if (actor && (camera = actor->GetComponent<Camera>()))
+				break;
+		}
+
+		// Pixels covered by the diameter of a sphere of radius 1 at a distance of 1
+		Vector3 cameraPosition	= camera ? camera->GetTransform()->GetPosition() : Vector3::Zero;
+		float projectionScale	= camera ? camera->GetProjectionMatrix().m11 * (float)Settings::Get().Resolution_GetHeight() : 0.0f;
+
+		// The most texels each streamed texture covers on screen (without a camera, nothing is visible)
+		unordered_map<RHI_Texture*, _TextureStreamer::Request> requests;
+		for (const auto& actorWeak : m_actors)
+		{
+			if (!camera)
+				break;
+
+			auto actor		= actorWeak.lock();
+			auto renderable	= actor ? actor->GetRenderable_PtrRaw() : nullptr;
+			auto material	= renderable ? renderable->Material_Ptr() : nullptr;
+			if (!material)
+				continue;
+
+			// The bounding sphere, the camera could also be inside it
+			auto box		= renderable->Geometry_BB();
+			float radius	= box.GetExtents().Length();
+			float distance	= (box.GetCenter() - cameraPosition).Length();
+			float pixels	= distance > radius ? radius / distance * projectionScale : FLT_MAX;
+			float tiling	= max(material->GetTiling().x, material->GetTiling().y);
+			float texels	= tiling > 0.0f ? pixels * tiling : pixels;
+
+			for (int type = TextureType_Albedo; type <= TextureType_Mask; type++)
+			{
+				const auto& texture = material->GetTextureSlotByType((TextureType)type).ptr;
+				if (!texture || !texture->GetStreamed() || texture->GetLoadState() != LoadState_Completed || texture->Streaming_GetMipCount() == 0)
+					continue;
+
+				auto& request	= requests[texture.get()];
+				request.texture	= texture;
+				request.texels	= max(request.texels, texels);
+			}
+		}
+
+		// Textures which are no longer visible go back to their mip tail
+		for (auto it = m_textures.begin(); it != m_textures.end();)
+		{
+			auto texture = it->second.texture.lock();
+			if (!texture)
+			{
+				it = m_textures.erase(it);
+				continue;
+			}
+
+			if (requests.find(texture.get()) == requests.end())
+			{
+				requests[texture.get()].texture = texture;
+			}
+			it++;
+		}
+
+		// Streamed textures which are neither visible nor tracked keep what they have resident (their mip tail)
+		unsigned long long untracked = 0;
+		for (const auto& resource : m_context->GetSubsystem<ResourceManager>()->GetResourcesByType(Resource_Texture))
+		{
+			auto texture = static_cast<RHI_Texture*>(resource.get());
+			if (texture->GetStreamed() && texture->GetLoadState() == LoadState_Completed && requests.find(texture) == requests.end())
+			{
+				untracked += texture->Streaming_GetBytes(texture->Streaming_GetResidentMip());
+			}
+		}
+
+		// The mip whose size matches the texels on screen
+		vector<_TextureStreamer::Request> sorted;
+		unsigned long long total = untracked;
+		for (auto& entry : requests)
+		{
+			auto& request	= entry.second;
+			auto texture	= request.texture.get();
+			float size		= (float)max(texture->GetWidth(), texture->GetHeight());
+			unsigned int mip	= request.texels >= size ? 0 : (unsigned int)log2(size / max(request.texels, 1.0f));
+			mip = min(mip, texture->Streaming_GetTailMip());
+			while (mip > 0 && !texture->Streaming_IsValidTopMip(mip))
+			{
+				mip--;
+			}
+
+			request.mip	= mip;
+			total		+= texture->Streaming_GetBytes(mip);
+			sorted.emplace_back(request);
+		}
+
+		// Over budget, the textures which cover the least of the screen drop a mip first
+		sort(sorted.begin(), sorted.end(), [](const _TextureStreamer::Request& a, const _TextureStreamer::Request& b) { return a.texels < b.texels; });
+		while (total > m_budget)
+		{
+			bool dropped = false;
+			for (auto& request : sorted)
+			{
+				auto texture = request.texture.get();
+				if (request.mip >= texture->Streaming_GetTailMip())
+					continue;
+
+				unsigned int mip	= _TextureStreamer::NextMip(texture, request.mip);
+				total				-= texture->Streaming_GetBytes(request.mip) - texture->Streaming_GetBytes(mip);
+				request.mip			= mip;
+				dropped				= true;
+
+				if (total <= m_budget)
+					break;
+			}
+
+			if (!dropped)
+				break;
+		}
+
+		// Start loads, the textures which cover the most of the screen first
+		auto threading	= m_context->GetSubsystem<Threading>();
+		auto state		= m_state;
+		m_residentBytes	= untracked;
+		for (auto it = sorted.rbegin(); it != sorted.rend(); it++)
+		{
+			auto texture		= it->texture;
+			unsigned int mip	= it->mip;
+			unsigned int tail	= texture->Streaming_GetTailMip();
+			m_residentBytes		+= texture->Streaming_GetBytes(texture->Streaming_GetResidentMip());
+
+			auto streamed = m_textures.find(texture.get());
+			bool loading = streamed != m_textures.end() && streamed->second.loading;
+			if (loading || mip == texture->Streaming_GetResidentMip())
+			{
+				// Nothing to stream out later
+				if (!loading && mip == tail && streamed != m_textures.end())
+				{
+					m_textures.erase(streamed);
+				}
+				continue;
+			}
+
+			if (m_loadsInFlight >= _TextureStreamer::loadsMax)
+				continue;
+
+			auto& entry		= m_textures[texture.get()];
+			entry.texture	= texture;
+			entry.loading	= true;
+			m_loadsInFlight++;
+
+			threading->AddTask([state, texture, mip]()
+			{
+				if (!state->Enter())
+					return;
+
+				texture->Streaming_Load(mip);
+				state->Leave(texture);
+			});
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+Copyright(c) 2016-2018 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "../Core/EngineDefs.h"
+//================================
+
+namespace Directus
+{
+	class Context;
+	class Actor;
+	class Variant;
+	class RHI_Texture;
+
+	// Streams the detailed mips of streamed textures in and out. Every few frames, each texture used by the submitted
+	// renderables is given the mip which matches the largest size it covers on screen. When the total exceeds the budget,
+	// the textures which cover the least of the screen drop a mip first. Mips are read and uploaded on the worker threads
+	// and swapped in at the start of a frame.
+	class ENGINE_CLASS TextureStreamer
+	{
+	public:
+		TextureStreamer(Context* context);
+		~TextureStreamer();
+
+		// The actors the World submits for rendering
+		void SetActors(const Variant& actors);
+		void ClearActors();
+		// Applies loads which completed and starts new ones, call at the start of a frame
+		void Tick();
+
+		// Memory for the mips of streamed textures (the mip tails count as well)
+		void SetBudget(unsigned long long budget)	{ m_budget = budget; }
+		unsigned long long GetBudget()				{ return m_budget; }
+		unsigned long long GetResidentBytes()		{ return m_residentBytes; }
+
+	private:
+		void Apply();
+		void Update();
+
+		struct Streamed
+		{
+			std::weak_ptr<RHI_Texture> texture;
+			bool loading = false;
+		};
+
+		Context* m_context;
+		std::vector<std::weak_ptr<Actor>> m_actors;
+		// Textures which have more than their mip tail resident (or are loading), so they are streamed out once they are no longer visible
+		std::unordered_map<RHI_Texture*, Streamed> m_textures;
+		std::shared_ptr<struct TextureStreamerState> m_state;
+		unsigned long long m_budget;
+		unsigned long long m_residentBytes	= 0;
+		unsigned int m_loadsInFlight		= 0;
+		unsigned int m_frame				= 0;
+	};
+}
\ No newline at end of file
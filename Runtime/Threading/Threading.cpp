@@ -21,6 +21,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ================
 #include "Threading.h"
+#include <algorithm>
 #include "../Core/Settings.h"
 //===========================
 
@@ -90,7 +91,7 @@ namespace Directus
 			task = m_tasks.front();
 
 			// Remove it from the queue.
-			m_tasks.pop();
+			m_tasks.pop_front();
 
 			// Unlock the mutex
 			lock.unlock();
@@ -99,4 +100,51 @@ namespace Directus
 			task->Execute();
 		}
 	}
+
+	void Threading::WaitUntil(const function<bool()>& condition, TaskGroup* group)
+	{
+		while (!condition())
+		{
+			// Tasks completing from here on wake the wait below
+			unsigned int completed = 0;
+			if (group)
+			{
+				lock_guard<mutex> guard(group->m_mutex);
+				completed = group->m_completed;
+			}
+
+			// Try to grab a pending task of the group
+			unique_lock<mutex> lock(m_tasksMutex);
+			auto it = group ? find_if(m_tasks.begin(), m_tasks.end(), [group](const shared_ptr<Task>& task) { return task->GetGroup() == group; }) : m_tasks.end();
+			if (it == m_tasks.end())
+			{
+				lock.unlock();
+
+				// The workers are running the group's tasks, sleep until one of them completes
+				if (group && !group->IsDone())
+				{
+					unique_lock<mutex> groupLock(group->m_mutex);
+					group->m_conditionVar.wait(groupLock, [group, completed]() { return group->m_completed != completed; });
+				}
+				else
+				{
+					this_thread::yield();
+				}
+				continue;
+			}
+
+			shared_ptr<Task> task = *it;
+			m_tasks.erase(it);
+			lock.unlock();
+
+			// Execute it here instead of idling
+			task->Execute();
+		}
+
+		// The task which met the condition could still be notifying
+		if (group)
+		{
+			lock_guard<mutex> guard(group->m_mutex);
+		}
+	}
 }
\ No newline at end of file
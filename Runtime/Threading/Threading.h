@@ -25,24 +25,70 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
 #include "../Core/SubSystem.h"
 #include "../Logging/Log.h"
 //============================
 
 namespace Directus
 {
+	//= TASK GROUP =========================================================================
+	// Tasks which are waited on together. A thread which waits on a group only executes
+	// tasks of that group, never unrelated (possibly long or lock taking) work.
+	class TaskGroup
+	{
+	public:
+		bool IsDone() const { return m_pending == 0; }
+
+	private:
+		friend class Task;
+		friend class Threading;
+
+		// Notifies under the lock, so a waiter which returns (and destroys the group) can't race with it
+		void OnTaskDone()
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_pending--;
+			m_completed++;
+			m_conditionVar.notify_all();
+		}
+
+		std::atomic<unsigned int> m_pending = 0;
+		unsigned int m_completed = 0;
+		std::mutex m_mutex;
+		std::condition_variable m_conditionVar;
+	};
+	//======================================================================================
+
 	//= TASK ===============================================================================
 	class Task
 	{
 	public:
 		typedef std::function<void()> functionType;
 
-		Task(functionType&& function) { m_function = std::forward<functionType>(function); }
-		void Execute() { m_function(); }
+		Task(functionType&& function, TaskGroup* group)
+		{
+			m_function	= std::forward<functionType>(function);
+			m_group		= group;
+		}
+
+		void Execute()
+		{
+			m_function();
+			if (m_group)
+			{
+				m_group->OnTaskDone();
+			}
+		}
+
+		TaskGroup* GetGroup() { return m_group; }
 
 	private:
 		functionType m_function;
+		TaskGroup* m_group;
 	};
 	//======================================================================================
 
@@ -59,9 +105,17 @@ namespace Directus
 		// This function is invoked by the threads
 		void Invoke();
 
-		// Add a task
+		// Executes queued tasks of the group on the calling thread until the condition is met.
+		// Use this instead of spinning when a task waits for other tasks, so a waiting
+		// worker can't starve the pool. Tasks of other groups are left to the workers, while
+		// they run the group's tasks the calling thread sleeps until one of them completes.
+		void WaitUntil(const std::function<bool()>& condition, TaskGroup* group);
+		// Waits until every task of the group has executed
+		void Wait(TaskGroup* group) { WaitUntil([group]() { return group->IsDone(); }, group); }
+
+		// Add a task, the group (if any) is what it can be waited on with
 		template <typename Function>
-		void AddTask(Function&& function)
+		void AddTask(Function&& function, TaskGroup* group = nullptr)
 		{
 			if (m_threads.empty())
 			{
@@ -74,7 +128,11 @@ namespace Directus
 			std::unique_lock<std::mutex> lock(m_tasksMutex);
 
 			// Save the task
-			m_tasks.push(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
+			if (group)
+			{
+				group->m_pending++;
+			}
+			m_tasks.push_back(std::make_shared<Task>(std::bind(std::forward<Function>(function)), group));
 
 			// Unlock the mutex
 			lock.unlock();
@@ -86,7 +144,7 @@ namespace Directus
 	private:
 		unsigned int m_threadCount;
 		std::vector<std::thread> m_threads;
-		std::queue<std::shared_ptr<Task>> m_tasks;
+		std::deque<std::shared_ptr<Task>> m_tasks;
 		std::mutex m_tasksMutex;
 		std::condition_variable m_conditionVar;
 		bool m_stopping;
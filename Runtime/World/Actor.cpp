@@ -51,6 +51,7 @@ namespace Directus
 		m_name					= "Actor";
 		m_isActive				= true;
 		m_hierarchyVisibility	= true;
+		m_registrationDeferred	= false;
 		m_transform				= nullptr;
 		m_renderable			= nullptr;
 	}
@@ -135,6 +136,18 @@ namespace Directus
 		}
 	}
 
+	void Actor::Register()
+	{
+		if (!m_registrationDeferred)
+			return;
+
+		m_registrationDeferred = false;
+		for (const auto& component : m_components)
+		{
+			component->Register();
+		}
+	}
+
 	void Actor::Stop()
 	{
 		// call component Stop()
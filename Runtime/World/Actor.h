@@ -52,6 +52,15 @@ namespace Directus
 		void Serialize(FileStream* stream);
 		void Deserialize(FileStream* stream, Transform* parent);
 
+		//= REGISTRATION ==============================================================================
+		// Actors built off the main thread (e.g. while a world loads) hold back the registration
+		// of their components with the engine's subsystems (physics, scripting) until Register()
+		void DeferRegistration()		{ m_registrationDeferred = true; }
+		bool IsRegistrationDeferred()	{ return m_registrationDeferred; }
+		// Registers the components whose registration was deferred, must be called from the main thread
+		void Register();
+		//=============================================================================================
+
 		//= PROPERTIES =========================================================================================
 		const std::string& GetName()			{ return m_name; }
 		void SetName(const std::string& name)	{ m_name = name; }
@@ -196,6 +205,7 @@ namespace Directus
 		std::string m_name;
 		bool m_isActive;
 		bool m_hierarchyVisibility;
+		bool m_registrationDeferred;
 		std::vector<std::shared_ptr<IComponent>> m_components;
 		Context* m_context;
 		std::shared_ptr<Actor> m_componentEmpty;
@@ -157,6 +157,11 @@ namespace Directus
 		return m_frustrum.CheckCube(center, extents) != Outside;
 	}
 
+	bool Camera::IsInViewFrustrum(const Vector3& center, float radius)
+	{
+		return m_frustrum.CheckSphere(center, radius) != Outside;
+	}
+
 	//= RAYCASTING =======================================================================
 	shared_ptr<Actor> Camera::Pick(const Vector2& mousePos)
 	{
@@ -95,6 +95,7 @@ namespace Directus
 		//= MISC ========================================================================
 		bool IsInViewFrustrum(Renderable* renderable);
 		bool IsInViewFrustrum(const Math::Vector3& center, const Math::Vector3& extents);
+		bool IsInViewFrustrum(const Math::Vector3& center, float radius);
 		const Math::Vector4& GetClearColor() { return m_clearColor; }
 		void SetClearColor(const Math::Vector4& color) { m_clearColor = color; }
 		//===============================================================================
@@ -73,6 +73,11 @@ namespace Directus
 			m_size		= renderable->Geometry_BB().GetSize();
 		}
 
+		Register();
+	}
+
+	void Collider::OnRegister()
+	{
 		Shape_Update();
 	}
 
@@ -99,7 +104,7 @@ namespace Directus
 		stream->Read(&m_size);
 		stream->Read(&m_center);
 
-		Shape_Update();
+		Register();
 	}
 
 	void Collider::SetBoundingBox(const Vector3& boundingBox)
@@ -76,6 +76,11 @@ namespace Directus
 
 	}
 
+	void Constraint::OnRegister()
+	{
+		Construct();
+	}
+
 	void Constraint::OnStart()
 	{
 
@@ -120,7 +125,7 @@ namespace Directus
 		unsigned int bodyOtherID = stream->ReadUInt();
 		m_bodyOther = GetContext()->GetSubsystem<World>()->Actor_GetByID(bodyOtherID);
 
-		Construct();
+		Register();
 	}
 
 	void Constraint::SetConstraintType(ConstraintType type)
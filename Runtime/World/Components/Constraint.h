@@ -52,6 +52,7 @@ namespace Directus
 
 		//= COMPONENT ================================
 		void OnInitialize() override;
+		void OnRegister() override;
 		void OnStart() override;
 		void OnStop() override;
 		void OnRemove() override;
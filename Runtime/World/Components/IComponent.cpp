@@ -61,6 +61,14 @@ namespace Directus
 		return m_actor->GetName();
 	}
 
+	void IComponent::Register()
+	{
+		if (m_actor && m_actor->IsRegistrationDeferred())
+			return;
+
+		OnRegister();
+	}
+
 	template <typename T>
 	ComponentType IComponent::Type_To_Enum() { return ComponentType_Unknown; }
 	// Explicit template instantiation
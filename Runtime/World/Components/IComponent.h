@@ -68,6 +68,9 @@ namespace Directus
 		// Runs when the component gets added
 		virtual void OnInitialize() {}
 
+		// Runs when the component joins the engine's subsystems (e.g. physics, scripting), see Register()
+		virtual void OnRegister() {}
+
 		// Runs every time the simulation starts
 		virtual void OnStart() {}
 
@@ -100,6 +103,9 @@ namespace Directus
 
 		const std::string& GetActorName();
 
+		// Calls OnRegister(), unless the actor defers registration, in which case it's called once the actor registers
+		void Register();
+
 		template <typename T>
 		static ComponentType Type_To_Enum();
 
@@ -22,6 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================================
 #include "Renderable.h"
 #include "Transform.h"
+#include "Camera.h"
+#include <algorithm>
 #include "../../IO/FileStream.h"
 #include "../../Resource/ResourceManager.h"
 #include "../../Rendering/Utilities/Geometry.h"
@@ -36,6 +38,14 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	namespace _Renderable
+	{
+		// Error, in pixels, which a level of detail may have on screen
+		static const float lodErrorPixels	= 1.0f;
+		// How much further the error of the selected level may go before a more detailed level replaces it, so levels don't flicker
+		static const float lodHysteresis	= 0.25f;
+	}
+
 	inline void Build(GeometryType type, Renderable* renderable)
 	{	
 		auto model = make_shared<Model>(renderable->GetContext());
@@ -93,6 +103,9 @@ namespace Directus
 		m_geometryIndexCount	= 0;
 		m_geometryVertexOffset	= 0;
 		m_geometryVertexCount	= 0;
+		m_lod					= 0;
+		m_lodIndexOffset		= 0;
+		m_lodIndexCount			= 0;
 		m_materialDefault		= false;
 		m_castShadows			= true;
 		m_receiveShadows		= true;
@@ -184,6 +197,7 @@ namespace Directus
 		m_geometryVertexCount	= vertexCount;
 		m_geometryAABB			= AABB;
 		m_model					= model;
+		m_lod					= 0;
 	}
 
 	void Renderable::Geometry_Set(GeometryType type)
@@ -211,6 +225,96 @@ namespace Directus
 	{
 		return m_geometryAABB.Transformed(GetTransform()->GetMatrix());
 	}
+
+	bool Renderable::Geometry_CullClusters(Camera* camera, bool cullBackfaces, vector<pair<unsigned int, unsigned int>>* ranges)
+	{
+		ranges->clear();
+		if (!m_model || !camera || m_lod != 0)
+			return false;
+
+		// A single cluster is no finer than the bounding box of the renderable
+		const auto& clusters	= m_model->Geometry_Clusters();
+		auto indexEnd			= m_geometryIndexOffset + m_geometryIndexCount;
+		auto cluster			= lower_bound(clusters.begin(), clusters.end(), m_geometryIndexOffset, [](const Mesh_Cluster& cluster, unsigned int indexOffset) { return cluster.indexOffset < indexOffset; });
+		if (cluster == clusters.end() || cluster->indexOffset != m_geometryIndexOffset || cluster->indexOffset + cluster->indexCount >= indexEnd)
+			return false;
+
+		// The normal cones only hold when the transform neither mirrors nor skews normals
+		Matrix world	= GetTransform()->GetMatrix();
+		Vector3 origin	= Vector3::Zero * world;
+		Vector3 axisX	= Vector3::Right * world - origin;
+		Vector3 axisY	= Vector3::Up * world - origin;
+		Vector3 axisZ	= Vector3::Forward * world - origin;
+		float scaleMin	= Helper::Min(axisX.Length(), Helper::Min(axisY.Length(), axisZ.Length()));
+		float scaleMax	= Helper::Max(axisX.Length(), Helper::Max(axisY.Length(), axisZ.Length()));
+		bool mirrored	= Vector3::Dot(Vector3::Cross(axisX, axisY), axisZ) < 0.0f;
+		cullBackfaces	= cullBackfaces && !mirrored && scaleMax <= scaleMin * 1.01f && camera->GetProjectionType() == Projection_Perspective;
+		Vector3 eye		= camera->GetTransform()->GetPosition();
+
+		for (; cluster != clusters.end() && cluster->indexOffset < indexEnd; cluster++)
+		{
+			Vector3 center	= cluster->center * world;
+			float radius	= cluster->radius * scaleMax;
+			if (!camera->IsInViewFrustrum(center, radius))
+				continue;
+
+			if (cullBackfaces)
+			{
+				Vector3 axis		= (cluster->coneAxis * world - origin).Normalized();
+				Vector3 eyeToCenter	= center - eye;
+				if (Vector3::Dot(eyeToCenter, axis) >= cluster->coneCutoff * eyeToCenter.Length() + radius)
+					continue;
+			}
+
+			// Neighbouring clusters are drawn together
+			if (!ranges->empty() && ranges->back().first + ranges->back().second == cluster->indexOffset)
+			{
+				ranges->back().second += cluster->indexCount;
+			}
+			else
+			{
+				ranges->emplace_back(cluster->indexOffset, cluster->indexCount);
+			}
+		}
+
+		return true;
+	}
+
+	void Renderable::Geometry_SelectLod(Camera* camera, float screenHeight)
+	{
+		auto lodPrevious	= m_lod;
+		m_lod				= 0;
+		if (!m_model || !camera)
+			return;
+
+		const auto& lods	= m_model->Geometry_Lods();
+		auto lod			= lower_bound(lods.begin(), lods.end(), m_geometryIndexOffset, [](const Mesh_Lod& lod, unsigned int indexOffset) { return lod.sourceIndexOffset < indexOffset; });
+		if (lod == lods.end() || lod->sourceIndexOffset != m_geometryIndexOffset)
+			return;
+
+		// Pixels per unit of the geometry, at the point of its bounding sphere which is closest to the camera
+		Vector3 scale		= GetTransform()->GetScale();
+		BoundingBox box		= Geometry_BB();
+		float distance		= 1.0f;
+		if (camera->GetProjectionType() == Projection_Perspective)
+		{
+			distance = (box.GetCenter() - camera->GetTransform()->GetPosition()).Length() - box.GetExtents().Length();
+			distance = Helper::Max(distance, camera->GetNearPlane());
+		}
+		float pixelsPerUnit	= Helper::Max(scale.x, Helper::Max(scale.y, scale.z)) * camera->GetProjectionMatrix().m11 / distance * screenHeight * 0.5f;
+
+		// The errors only grow from one level to the next
+		for (unsigned int level = 1; lod != lods.end() && lod->sourceIndexOffset == m_geometryIndexOffset; lod++, level++)
+		{
+			float errorLimit = _Renderable::lodErrorPixels * (level <= lodPrevious ? 1.0f + _Renderable::lodHysteresis : 1.0f);
+			if (lod->error * pixelsPerUnit > errorLimit)
+				break;
+
+			m_lod				= level;
+			m_lodIndexOffset	= lod->indexOffset;
+			m_lodIndexCount		= lod->indexCount;
+		}
+	}
 	//==============================================================================
 
 	//= MATERIAL ===================================================================
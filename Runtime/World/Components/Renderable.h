@@ -33,6 +33,7 @@ namespace Directus
 	class Mesh;
 	class Light;
 	class Material;
+	class Camera;
 	namespace Math
 	{
 		class Vector3;
@@ -80,6 +81,15 @@ namespace Directus
 		std::shared_ptr<Model> Geometry_Model()			{ return m_model; }
 		const Math::BoundingBox& Geometry_AABB() const	{ return m_geometryAABB; }
 		Math::BoundingBox Geometry_BB();
+		// Index ranges (offset, count) of the clusters which are in the view frustum and, when cullBackfaces is set, face the camera.
+		// Returns false when the geometry isn't split into clusters or a simplified level of detail is selected, in which case the
+		// selected level of detail should be drawn in full.
+		bool Geometry_CullClusters(Camera* camera, bool cullBackfaces, std::vector<std::pair<unsigned int, unsigned int>>* ranges);
+		// Selects the least detailed level whose error covers no more than a pixel of a screen with the given height
+		void Geometry_SelectLod(Camera* camera, float screenHeight);
+		unsigned int Geometry_Lod()						{ return m_lod; }
+		unsigned int Geometry_LodIndexOffset()			{ return m_lod != 0 ? m_lodIndexOffset : m_geometryIndexOffset; }
+		unsigned int Geometry_LodIndexCount()			{ return m_lod != 0 ? m_lodIndexCount : m_geometryIndexCount; }
 		//===============================================================================================
 
 		//= MATERIAL ===========================================================================
@@ -114,6 +124,12 @@ namespace Directus
 		GeometryType m_geometryType;
 		//==================================
 
+		//= LEVEL OF DETAIL ================
+		unsigned int m_lod;
+		unsigned int m_lodIndexOffset;
+		unsigned int m_lodIndexCount;
+		//==================================
+
 		//= MATERIAL =======================
 		std::shared_ptr<Material> m_material;
 		//==================================
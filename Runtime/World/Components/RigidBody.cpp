@@ -115,6 +115,11 @@ namespace Directus
 
 	//= ICOMPONENT ==========================================================
 	void RigidBody::OnInitialize()
+	{
+		Register();
+	}
+
+	void RigidBody::OnRegister()
 	{
 		Body_AcquireShape();
 		Body_AddToWorld();
@@ -166,8 +171,7 @@ namespace Directus
 		stream->Read(&m_rotationLock);
 		stream->Read(&m_inWorld);
 
-		Body_AcquireShape();
-		Body_AddToWorld();
+		Register();
 	}
 
 	// = PROPERTIES =========================================================
@@ -52,6 +52,7 @@ namespace Directus
 
 		//= ICOMPONENT ===============================
 		void OnInitialize() override;
+		void OnRegister() override;
 		void OnRemove() override;
 		void OnStart() override;
 		void OnTick() override;
@@ -34,7 +34,7 @@ namespace Directus
 {
 	Script::Script(Context* context, Actor* actor, Transform* transform) : IComponent(context, actor, transform)
 	{
-
+		m_scriptPathPending = NOT_ASSIGNED;
 	}
 
 	Script::~Script()
@@ -43,6 +43,15 @@ namespace Directus
 	}
 
 	//= ICOMPONENT ==================================================================
+	void Script::OnRegister()
+	{
+		if (m_scriptPathPending == NOT_ASSIGNED)
+			return;
+
+		SetScript(m_scriptPathPending);
+		m_scriptPathPending = NOT_ASSIGNED;
+	}
+
 	void Script::OnStart()
 	{
 		if (!m_scriptInstance)
@@ -67,7 +76,7 @@ namespace Directus
 
 	void Script::Serialize(FileStream* stream)
 	{
-		stream->Write(m_scriptInstance ? m_scriptInstance->GetScriptPath() : NOT_ASSIGNED);
+		stream->Write(m_scriptInstance ? m_scriptInstance->GetScriptPath() : m_scriptPathPending);
 	}
 
 	void Script::Deserialize(FileStream* stream)
@@ -75,15 +84,18 @@ namespace Directus
 		string scriptPath = NOT_ASSIGNED;
 		stream->Read(&scriptPath);
 
-		if (scriptPath != NOT_ASSIGNED)
-		{
-			SetScript(scriptPath);
-		}
+		// Compiling and running the script is left to the main thread when the actor is built off it
+		m_scriptPathPending = scriptPath;
+		Register();
 	}
 	//====================================================================================
 
 	bool Script::SetScript(const string& filePath)
 	{
+		// Release the previous instance first, its module has the same name as the new one
+		// and discarding it afterwards would discard the new module instead.
+		m_scriptInstance.reset();
+
 		// Instantiate the script
 		m_scriptInstance = make_shared<ScriptInstance>();
 		m_scriptInstance->Instantiate(filePath, GetActor_PtrWeak(), GetContext()->GetSubsystem<Scripting>());
@@ -35,6 +35,7 @@ namespace Directus
 		~Script();
 
 		//= ICOMPONENT ===============================
+		void OnRegister() override;
 		void OnStart() override;
 		void OnTick() override;
 		void Serialize(FileStream* stream) override;
@@ -48,5 +49,7 @@ namespace Directus
 	private:
 		std::shared_ptr<ScriptInstance> m_scriptInstance;
 		std::string m_name;
+		// A deserialized script is instantiated once the component registers
+		std::string m_scriptPathPending;
 	};
 }
\ No newline at end of file
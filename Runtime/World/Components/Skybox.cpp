@@ -28,6 +28,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../RHI/RHI_Texture.h"
 #include "../../Math/MathHelper.h"
 #include "../../Rendering/Material.h"
+#include "../../Resource/Import/IBLGenerator.h"
+#include "../../Threading/Threading.h"
+#include "../../IO/FileStream.h"
+#include "../../Core/Hash.h"
+#include "../../Logging/Log.h"
 //=========================================
 
 //= NAMESPACES ========================
@@ -79,6 +84,8 @@ namespace Directus
 		{
 			CreateFromSphere(m_texturePaths.front());
 		}
+
+		CreateLighting();
 	}
 
 	void Skybox::OnTick()
@@ -91,38 +98,10 @@ namespace Directus
 		if (texturePaths.empty())
 			return;
 
-		// Load all textures (sides)
-		vector<vector<vector<std::byte>>> cubemapData;
-
-		// Load all the cubemap sides
-		auto loaderTex = make_shared<RHI_Texture>(GetContext());
-		{
-			loaderTex->LoadFromFile(texturePaths[0]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-
-			loaderTex->LoadFromFile(texturePaths[1]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-
-			loaderTex->LoadFromFile(texturePaths[2]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-
-			loaderTex->LoadFromFile(texturePaths[3]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-
-			loaderTex->LoadFromFile(texturePaths[4]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-
-			loaderTex->LoadFromFile(texturePaths[5]);
-			cubemapData.emplace_back(loaderTex->Data_Get());
-		}
-
-		// Cubemap
+		// All the sides (and their mips) are baked into a single texture the first time, the sides are decoded in parallel
 		{
-			m_cubemapTexture->ShaderResource_CreateCubemap(loaderTex->GetWidth(), loaderTex->GetHeight(), loaderTex->GetChannels(), loaderTex->GetFormat(), cubemapData);
+			m_cubemapTexture->LoadFromFiles_Cubemap(texturePaths);
 			m_cubemapTexture->SetResourceName("Cubemap");
-			m_cubemapTexture->SetWidth(loaderTex->GetWidth());
-			m_cubemapTexture->SetHeight(loaderTex->GetHeight());
-			m_cubemapTexture->SetGrayscale(false);
 		}
 
 		// Material
@@ -177,4 +156,96 @@ namespace Directus
 		// Make the skybox big enough
 		GetTransform()->SetScale(Vector3(980, 980, 980));
 	}
+
+	void Skybox::CreateLighting()
+	{
+		m_specularTexture = nullptr;
+		m_irradianceSH.clear();
+		if (!m_cubemapTexture || m_texturePaths.empty())
+			return;
+
+		auto resourceMng		= GetContext()->GetSubsystem<ResourceManager>();
+		DerivedDataCache* ddc	= resourceMng->GetDerivedDataCache();
+
+		// Kept next to the environment's own derived data, any source that changes invalidates it
+		unsigned long long settingsHash	= Hash::Combine(resourceMng->GetImageImporter()->GetSettingsHash(m_cubemapTexture.get()), Hash::ComputeValue(IBLGenerator::GetVersion()));
+		unsigned long long key			= settingsHash;
+		for (const auto& texturePath : m_texturePaths)
+		{
+			unsigned long long sourceKey = ddc->ComputeKey(texturePath, settingsHash);
+			key = sourceKey != 0 ? Hash::Combine(key, sourceKey) : 0;
+			if (key == 0)
+				break;
+		}
+		string derivedSpecularFilePath	= ddc->GetEntryDirectory(key) + "Specular" + EXTENSION_TEXTURE;
+		string irradianceFilePath		= ddc->GetEntryDirectory(key) + "Irradiance.dat";
+		// The specular texture lives next to the environment, the cache only mirrors it (so clearing the cache doesn't lose it)
+		string specularFilePath			= FileSystem::GetFilePathWithoutExtension(m_cubemapTexture->GetResourceFilePath()) + "_Specular" + EXTENSION_TEXTURE;
+
+		auto specularTexture = make_shared<RHI_Texture>(GetContext());
+		if (ddc->Contains(key))
+		{
+			// The file next to the environment could be from another one, it's replaced before the texture is loaded from it
+			auto file = make_unique<FileStream>(irradianceFilePath, FileStreamMode_Read);
+			if (file->IsOpen() && DerivedDataCache::Entry_CopyFile(derivedSpecularFilePath, specularFilePath) && specularTexture->LoadFromFile(specularFilePath))
+			{
+				m_irradianceSH.resize(9);
+				for (auto& coefficient : m_irradianceSH)
+				{
+					file->Read(&coefficient);
+				}
+
+				specularTexture->SetResourceFilePath(specularFilePath);
+				m_specularTexture = specularTexture;
+				return;
+			}
+		}
+
+		// Convolve the environment (the worker threads help)
+		IBLGenerator generator(GetContext()->GetSubsystem<Threading>());
+		const auto& mips = m_cubemapTexture->Data_Get();
+		if (!generator.Generate(mips, m_cubemapTexture->GetWidth(), m_cubemapTexture->GetHeight(), m_cubemapTexture->GetFormat(), m_cubemapTexture->GetCubemap(), m_cubemapTexture->GetSRGB()))
+		{
+			LOG_WARNING("Skybox::CreateLighting: Failed to precompute the image based lighting, the environment won't light the scene");
+			return;
+		}
+
+		specularTexture->SetWidth(generator.GetSpecularWidth());
+		specularTexture->SetHeight(generator.GetSpecularHeight());
+		specularTexture->SetChannels(4);
+		specularTexture->SetBPC(2);
+		specularTexture->SetBPP(64);
+		specularTexture->SetFormat(Texture_Format_R16G16B16A16_FLOAT);
+		specularTexture->SetNeedsMipChain(false);
+		specularTexture->Data_Set(generator.GetSpecularMips());
+		specularTexture->SetResourceName("Skybox_Specular");
+		specularTexture->SetResourceFilePath(specularFilePath);
+		if (!specularTexture->LoadAsync_Finalize())
+			return;
+
+		m_specularTexture	= specularTexture;
+		m_irradianceSH		= generator.GetIrradianceSH();
+
+		if (key != 0)
+		{
+			ddc->Entry_Begin(key);
+			bool saved = false;
+			{
+				auto file = make_unique<FileStream>(irradianceFilePath, FileStreamMode_Write);
+				saved = file->IsOpen();
+				for (const auto& coefficient : m_irradianceSH)
+				{
+					file->Write(coefficient);
+				}
+			}
+
+			if (saved && m_specularTexture->SaveToFile(derivedSpecularFilePath))
+			{
+				ddc->Entry_Commit(key);
+			}
+		}
+
+		// Saving the texture at its own path also frees its bits
+		m_specularTexture->SaveToFile(specularFilePath);
+	}
 }
\ No newline at end of file
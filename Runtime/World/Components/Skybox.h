@@ -23,8 +23,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include <memory>
+#include <vector>
 #include "IComponent.h"
 #include "../../RHI/RHI_Definition.h"
+#include "../../Math/Vector3.h"
 //===================================
 
 namespace Directus
@@ -51,13 +53,20 @@ namespace Directus
 		const std::shared_ptr<RHI_Texture>& GetTexture()	{ return m_cubemapTexture; }
 		std::weak_ptr<Material> GetMaterial()				{ return m_matSkybox;}
 
+		// Image based lighting, precomputed from the environment (null/empty if that failed)
+		const std::shared_ptr<RHI_Texture>& GetSpecularTexture()	{ return m_specularTexture; }
+		const std::vector<Math::Vector3>& GetIrradianceSH()			{ return m_irradianceSH; }
+
 	private:
 
 		void CreateFromArray(const std::vector<std::string>& texturePaths);
 		void CreateFromSphere(const std::string& texturePath);
+		void CreateLighting();
 
 		std::vector<std::string> m_texturePaths;
 		std::shared_ptr<RHI_Texture> m_cubemapTexture;
+		std::shared_ptr<RHI_Texture> m_specularTexture;
+		std::vector<Math::Vector3> m_irradianceSH;
 		std::shared_ptr<Material> m_matSkybox;
 		Skybox_Type m_skyboxType;
 	};
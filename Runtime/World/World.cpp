@@ -34,8 +34,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/ResourceManager.h"
 #include "../Resource/ProgressReport.h"
 #include "../IO/FileStream.h"
+#include "../FileSystem/AssetArchive.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
+#include <set>
+#include <unordered_set>
+#include <atomic>
+#include <functional>
 //======================================
 
 //= NAMESPACES ================
@@ -48,11 +53,16 @@ namespace Directus
 	namespace _World
 	{
 		shared_ptr<Actor> emptyActor;
+
+		// How many old actors are released per tick after a world swap
+		static const unsigned int actorReleaseBudget = 32;
 	}
 
 	World::World(Context* context) : Subsystem(context)
 	{
-		m_state = Ticking;
+		m_state				= Ticking;
+		m_stagingReady		= false;
+		m_stagingThreadID	= thread::id();
 		SUBSCRIBE_TO_EVENT(EVENT_WORLD_RESOLVE, [this](Variant) { m_isDirty = true; });
 		SUBSCRIBE_TO_EVENT(EVENT_TICK, EVENT_HANDLER(Tick));
 		SUBSCRIBE_TO_EVENT(EVENT_WORLD_STOP, [this](Variant)	{ m_state = Idle; });
@@ -76,10 +86,22 @@ namespace Directus
 
 	void World::Tick()
 	{	
-		if (m_state == Request_Loading)
+		// A world finished loading in the background, swap it in (frame boundary)
+		if (m_stagingReady)
 		{
-			m_state = Loading;
-			return;
+			SwapInStagingWorld();
+		}
+
+		// Release a few of the actors that belonged to the previous world
+		for (unsigned int i = 0; i < _World::actorReleaseBudget && !m_actorsReleasing.empty(); i++)
+		{
+			m_actorsReleasing.pop_back();
+		}
+
+		// Then the resources only they were using
+		if (m_actorsReleasing.empty() && !m_resourcesReleasing.empty())
+		{
+			ReleaseResources();
 		}
 
 		if (m_state != Ticking)
@@ -128,9 +150,79 @@ namespace Directus
 	void World::Unload()
 	{
 		FIRE_EVENT(EVENT_WORLD_UNLOAD);
+		m_context->GetSubsystem<ResourceManager>()->Clear();
 		m_actorsPrimary.clear();
 		m_actorsPrimary.shrink_to_fit();
 	}
+
+	void World::SwapInStagingWorld()
+	{
+		// Keep the old actors alive, they are released over the next few ticks so the swap doesn't hitch
+		m_actorsReleasing.insert(m_actorsReleasing.end(), m_actorsPrimary.begin(), m_actorsPrimary.end());
+		m_actorsPrimary.clear();
+
+		FIRE_EVENT(EVENT_WORLD_UNLOAD);
+		m_actorsPrimary.swap(m_actorsStaging);
+		m_stagingReady	= false;
+		m_isDirty		= true;
+		m_state			= Ticking;
+
+		// The actors were built on the loading thread, they join physics and scripting here, on the main thread
+		bool inGame = Engine::EngineMode_IsSet(Engine_Game);
+		for (const auto& actor : m_actorsPrimary)
+		{
+			actor->Register();
+			if (inGame)
+			{
+				actor->Start();
+			}
+		}
+
+		// The resources the previous world used, which the new one didn't load, are released along with its actors
+		unordered_set<IResource*> staged;
+		for (const auto& resource : m_resourcesStaging)
+		{
+			staged.insert(resource.get());
+		}
+		for (const auto& resource : m_resourcesPrevious)
+		{
+			if (!staged.count(resource.get()))
+			{
+				m_resourcesReleasing.emplace_back(resource);
+			}
+		}
+		m_resourcesPrevious.clear();
+		m_resourcesStaging.clear();
+
+		FIRE_EVENT(EVENT_WORLD_LOADED);
+	}
+
+	void World::ReleaseResources()
+	{
+		// The new world can also have picked resources up from the cache by name (or cached new ones while loading), so
+		// a resource is only dropped when this list is its last owner besides the cache. Dropping one can release the
+		// last owner of another (e.g. a material's textures), hence the passes.
+		auto resourceMng	= m_context->GetSubsystem<ResourceManager>();
+		bool removed		= true;
+		while (removed)
+		{
+			removed = false;
+			for (auto it = m_resourcesReleasing.begin(); it != m_resourcesReleasing.end();)
+			{
+				if ((*it)->GetLoadState() != LoadState_Started && resourceMng->GetOwnerCount(*it) <= 1)
+				{
+					resourceMng->Remove(*it);
+					it		= m_resourcesReleasing.erase(it);
+					removed	= true;
+					continue;
+				}
+				it++;
+			}
+		}
+
+		// What's left is still in use, it stays cached
+		m_resourcesReleasing.clear();
+	}
 	//=========================================================================================================
 
 	//= I/O ===================================================================================================
@@ -152,7 +244,7 @@ namespace Directus
 		m_context->GetSubsystem<ResourceManager>()->SaveResourcesToFiles();
 
 		// Create a prefab file
-		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write);
+		auto file = make_unique<FileStream>(filePath, FileStreamMode_Write, true);
 		if (!file->IsOpen())
 		{
 			return false;
@@ -199,48 +291,40 @@ namespace Directus
 			return false;
 		}
 
-		// Thread safety: Wait for scene and the renderer to stop the actors (could do double buffering in the future)
-		while (m_state != Loading || Renderer::IsRendering()) { m_state = Request_Loading; this_thread::sleep_for(chrono::milliseconds(16)); }
+		// Only one world can be built at a time, and the previous one must have been swapped in
+		lock_guard<mutex> guard(m_loadingMutex);
+		while (m_stagingReady) { this_thread::sleep_for(chrono::milliseconds(16)); }
 
 		ProgressReport::Get().Reset(g_progress_Scene);
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, true);
 		ProgressReport::Get().SetStatus(g_progress_Scene, "Loading scene...");
 
-		Unload();
-
 		// Read all the resource file paths
 		auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
 		if (!file->IsOpen())
+		{
+			ProgressReport::Get().SetIsLoading(g_progress_Scene, false);
 			return false;
+		}
 
 		Stopwatch timer;
 
+		// The world is built into the staging actors, the live world keeps ticking and rendering meanwhile.
+		// Actor helper functions called from this thread (e.g. during deserialization) operate on the staging actors.
+		m_actorsStaging.clear();
+		m_stagingThreadID = this_thread::get_id();
+
+		// The live world keeps using the cache, resources both worlds share are simply reused
+		m_resourcesPrevious = m_context->GetSubsystem<ResourceManager>()->GetResourceAll();
+		m_resourcesStaging.clear();
+
 		vector<string> resourcePaths;
 		file->Read(&resourcePaths);
 
 		ProgressReport::Get().SetJobCount(g_progress_Scene, (int)resourcePaths.size());
 
 		// Load all the resources
-		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
-		for (const auto& resourcePath : resourcePaths)
-		{
-			if (FileSystem::IsEngineModelFile(resourcePath))
-			{
-				resourceMng->Load<Model>(resourcePath);
-			}
-
-			if (FileSystem::IsEngineMaterialFile(resourcePath))
-			{
-				resourceMng->Load<Material>(resourcePath);
-			}
-
-			if (FileSystem::IsEngineTextureFile(resourcePath))
-			{
-				resourceMng->Load<RHI_Texture>(resourcePath);
-			}
-
-			ProgressReport::Get().IncrementJobsDone(g_progress_Scene);
-		}
+		LoadResources(resourcePaths);
 
 		//= Load actors ============================	
 		// 1st - Root actor count
@@ -260,26 +344,88 @@ namespace Directus
 		// deserialize their descendants.
 		for (int i = 0; i < rootactorCount; i++)
 		{
-			m_actorsPrimary[i]->Deserialize(file.get(), nullptr);
+			m_actorsStaging[i]->Deserialize(file.get(), nullptr);
 		}
 		//==============================================
 
-		m_isDirty	= true;
-		m_state		= Ticking;
+		// Hand the staging world over, it will be swapped in on the next tick
+		m_stagingThreadID	= thread::id();
+		m_stagingReady		= true;
+
 		ProgressReport::Get().SetIsLoading(g_progress_Scene, false);	
 		LOG_INFO("Scene: Loading took " + to_string((int)timer.GetElapsedTimeMs()) + " ms");	
 
-		FIRE_EVENT(EVENT_WORLD_LOADED);
 		return true;
 	}
+
+	bool World::PackToFile(const string& filePath, const string& archivePath)
+	{
+		// A world file starts with the paths of the resources it references
+		vector<string> resourcePaths;
+		{
+			auto file = make_unique<FileStream>(filePath, FileStreamMode_Read);
+			if (!file->IsOpen())
+				return false;
+
+			file->Read(&resourcePaths);
+		}
+
+		// Dependencies (e.g. the textures of a material) go in as well
+		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
+		vector<string> filePaths = { filePath };
+		set<string> visited;
+		function<void(const string&)> Gather = [&resourceMng, &filePaths, &visited, &Gather](const string& resourcePath)
+		{
+			if (!visited.insert(resourcePath).second)
+				return;
+
+			filePaths.emplace_back(resourcePath);
+			for (const auto& dependency : resourceMng->GetDependencies(resourcePath))
+			{
+				Gather(dependency);
+			}
+		};
+		for (const auto& resourcePath : resourcePaths)
+		{
+			Gather(resourcePath);
+		}
+
+		return AssetArchive::Create(archivePath, filePaths);
+	}
+	//===================================================================================================
+
+	void World::LoadResources(const vector<string>& resourcePaths)
+	{
+		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
+
+		vector<string> uniquePaths;
+		set<string> visited;
+		for (const auto& resourcePath : resourcePaths)
+		{
+			if (!visited.insert(resourcePath).second)
+			{
+				ProgressReport::Get().IncrementJobsDone(g_progress_Scene);
+				continue;
+			}
+
+			uniquePaths.emplace_back(resourcePath);
+		}
+
+		// Dependencies (e.g. the textures of a material) are loaded before the resources which need them
+		resourceMng->Prefetch(uniquePaths, [](const string&) { ProgressReport::Get().IncrementJobsDone(g_progress_Scene); }, &m_resourcesStaging);
+	}
 	//===================================================================================================
 
 	//= Actor HELPER FUNCTIONS  ====================================================================
 	shared_ptr<Actor>& World::Actor_Create()
 	{
 		auto actor = make_shared<Actor>(m_context);
+		if (this_thread::get_id() == m_stagingThreadID.load())
+		{
+			actor->DeferRegistration();
+		}
 		actor->Initialize(actor->AddComponent<Transform>().get());
-		return m_actorsPrimary.emplace_back(actor);
+		return Actors_Target().emplace_back(actor);
 	}
 
 	shared_ptr<Actor>& World::Actor_Add(const shared_ptr<Actor>& actor)
@@ -287,7 +433,7 @@ namespace Directus
 		if (!actor)
 			return m_actorEmpty;
 
-		return m_actorsPrimary.emplace_back(actor);
+		return Actors_Target().emplace_back(actor);
 	}
 
 	bool World::Actor_Exists(const weak_ptr<Actor>& actor)
@@ -316,12 +462,13 @@ namespace Directus
 		Transform* parent = actorPtr->GetTransform_PtrRaw()->GetParent();
 
 		// Remove this actor
-		for (auto it = m_actorsPrimary.begin(); it < m_actorsPrimary.end();)
+		auto& actors = Actors_Target();
+		for (auto it = actors.begin(); it < actors.end();)
 		{
 			shared_ptr<Actor> temp = *it;
 			if (temp->GetID() == actorPtr->GetID())
 			{
-				it = m_actorsPrimary.erase(it);
+				it = actors.erase(it);
 				break;
 			}
 			++it;
@@ -339,7 +486,7 @@ namespace Directus
 	vector<shared_ptr<Actor>> World::Actors_GetRoots()
 	{
 		vector<shared_ptr<Actor>> rootActors;
-		for (const auto& actor : m_actorsPrimary)
+		for (const auto& actor : Actors_Target())
 		{
 			if (actor->GetTransform_PtrRaw()->IsRoot())
 			{
@@ -352,7 +499,7 @@ namespace Directus
 
 	const shared_ptr<Actor>& World::Actor_GetByName(const string& name)
 	{
-		for (const auto& actor : m_actorsPrimary)
+		for (const auto& actor : Actors_Target())
 		{
 			if (actor->GetName() == name)
 				return actor;
@@ -363,7 +510,7 @@ namespace Directus
 
 	const shared_ptr<Actor>& World::Actor_GetByID(unsigned int ID)
 	{
-		for (const auto& actor : m_actorsPrimary)
+		for (const auto& actor : Actors_Target())
 		{
 			if (actor->GetID() == ID)
 				return actor;
@@ -371,6 +518,11 @@ namespace Directus
 
 		return _World::emptyActor;
 	}
+
+	vector<shared_ptr<Actor>>& World::Actors_Target()
+	{
+		return (this_thread::get_id() == m_stagingThreadID.load()) ? m_actorsStaging : m_actorsPrimary;
+	}
 	//===================================================================================================
 
 	//= COMMON ACTOR CREATION ========================================================================
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include <vector>
+#include <atomic>
 #include "../Math/Vector3.h"
 #include "../Threading/Threading.h"
 //=================================
@@ -31,13 +32,12 @@ namespace Directus
 {
 	class Actor;
 	class Light;
+	class IResource;
 
 	enum Scene_State
 	{
 		Ticking,
-		Idle,
-		Request_Loading,
-		Loading
+		Idle
 	};
 
 	class ENGINE_CLASS World : public Subsystem
@@ -53,21 +53,23 @@ namespace Directus
 		void Tick();
 		void Unload();
 
-		//= IO ========================================
+		//= IO ===============================================================================================
 		bool SaveToFile(const std::string& filePath);
 		bool LoadFromFile(const std::string& filePath);
-		//=============================================
+		// Packs a saved world, the resources it references and their dependencies into an archive (see FileSystem::Mount())
+		bool PackToFile(const std::string& filePath, const std::string& archivePath);
+		//====================================================================================================
 
 		//= Actor HELPER FUNCTIONS ====================================================
 		std::shared_ptr<Actor>& Actor_Create();
 		std::shared_ptr<Actor>& Actor_Add(const std::shared_ptr<Actor>& actor);
 		bool Actor_Exists(const std::weak_ptr<Actor>& actor);
 		void Actor_Remove(const std::weak_ptr<Actor>& actor);
-		const std::vector<std::shared_ptr<Actor>>& Actors_GetAll() { return m_actorsPrimary; }
+		const std::vector<std::shared_ptr<Actor>>& Actors_GetAll() { return Actors_Target(); }
 		std::vector<std::shared_ptr<Actor>> Actors_GetRoots();
 		const std::shared_ptr<Actor>& Actor_GetByName(const std::string& name);
 		const std::shared_ptr<Actor>& Actor_GetByID(unsigned int ID);
-		int Actor_GetCount() { return (int)m_actorsPrimary.size(); }
+		int Actor_GetCount() { return (int)Actors_Target().size(); }
 		//=============================================================================
 
 	private:
@@ -77,10 +79,34 @@ namespace Directus
 		std::shared_ptr<Actor>& CreateDirectionalLight();
 		//===============================================
 
+		// Loads the resources a world depends on (in parallel)
+		void LoadResources(const std::vector<std::string>& resourcePaths);
+
+		//= STAGING =========================================================
+		// Replaces the live actors with the ones built by LoadFromFile()
+		void SwapInStagingWorld();
+		// Drops the resources of the previous world which only the cache still owns, once its actors are gone
+		void ReleaseResources();
+		// The staging actors when called from the loading thread, the live ones otherwise
+		std::vector<std::shared_ptr<Actor>>& Actors_Target();
+		//===================================================================
+
 		// Double-buffered actors
 		std::vector<std::shared_ptr<Actor>> m_actorsPrimary;
 		std::vector<std::shared_ptr<Actor>> m_actorsSecondry;
 
+		// Background loading
+		std::vector<std::shared_ptr<Actor>> m_actorsStaging;
+		std::vector<std::shared_ptr<Actor>> m_actorsReleasing;
+		std::atomic<std::thread::id> m_stagingThreadID;
+		std::atomic<bool> m_stagingReady;
+		std::mutex m_loadingMutex;
+		// The resources cached when loading started, and the ones the staging world loaded.
+		// Once swapped in, the former which the latter doesn't share are released (see ReleaseResources()).
+		std::vector<std::shared_ptr<IResource>> m_resourcesPrevious;
+		std::vector<std::shared_ptr<IResource>> m_resourcesStaging;
+		std::vector<std::shared_ptr<IResource>> m_resourcesReleasing;
+
 		std::shared_ptr<Actor> m_actorEmpty;
 		std::weak_ptr<Actor> m_skybox;
 		bool m_wasInEditorMode;